@@ -0,0 +1,111 @@
+/*-------------------------------------------------------
+  array_simd.hpp
+    JHT, October 19, 2026 : created
+
+  Dispatch from the bulk operations of vec, gemat,
+  usymat, geten3, and geten4 to the simd_* kernels.
+  The alignment (in BYTES) of the buffers, as found by
+  calc_alignment, picks the aligned template variant,
+  and buffers aligned to less than 16 BYTES use the
+  unaligned one. Containers of non numeric types stop
+  with an error.
+
+  USAGE
+  --------------------------
+  const int ALIGN = array_align(x.get_alignment(),y.get_alignment());
+  array_axpy<double>(N,a,x_ptr,y_ptr,ALIGN);  //y += a*x
+  array_scal<double>(N,a,x_ptr,ALIGN);	      //x *= a
+  array_dot<double>(N,x_ptr,y_ptr,ALIGN);     //x.y
+
+--------------------------------------------------------*/
+#ifndef ARRAY_SIMD_HPP
+#define ARRAY_SIMD_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <type_traits>
+#include "simd.hpp"
+
+//common alignment of two buffers
+inline int array_align(const int a, const int b)
+{
+  return (a < b) ? a : b;
+}
+
+//for containers of non numeric types (gemat<double*>), which have no
+//  bulk operations
+inline void array_not_numeric(const char* name)
+{
+  printf("ERROR %s, container type is not numeric \n",name);
+  exit(1);
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+array_axpy(const long N, const T A, const T* X, T* Y, const int ALIGN)
+{
+  if      (ALIGN >= 128) {simd_axpy<T,128>(N,A,X,Y);}
+  else if (ALIGN >= 64)  {simd_axpy<T,64>(N,A,X,Y);}
+  else if (ALIGN >= 32)  {simd_axpy<T,32>(N,A,X,Y);}
+  else if (ALIGN >= 16)  {simd_axpy<T,16>(N,A,X,Y);}
+  else                   {simd_axpy<T>(N,A,X,Y);}
+}
+template <typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value>::type
+array_axpy(const long, const T, const T*, T*, const int)
+{
+  array_not_numeric("axpy");
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+array_scal(const long N, const T A, T* X, const int ALIGN)
+{
+  if      (ALIGN >= 128) {simd_scal_mul<T,128>(N,A,X);}
+  else if (ALIGN >= 64)  {simd_scal_mul<T,64>(N,A,X);}
+  else if (ALIGN >= 32)  {simd_scal_mul<T,32>(N,A,X);}
+  else if (ALIGN >= 16)  {simd_scal_mul<T,16>(N,A,X);}
+  else                   {simd_scal_mul<T>(N,A,X);}
+}
+template <typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value>::type
+array_scal(const long, const T, T*, const int)
+{
+  array_not_numeric("scale");
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value,T>::type
+array_dot(const long N, const T* X, const T* Y, const int ALIGN)
+{
+  if      (ALIGN >= 128) {return simd_dot<T,128>(N,X,Y);}
+  else if (ALIGN >= 64)  {return simd_dot<T,64>(N,X,Y);}
+  else if (ALIGN >= 32)  {return simd_dot<T,32>(N,X,Y);}
+  else if (ALIGN >= 16)  {return simd_dot<T,16>(N,X,Y);}
+  else                   {return simd_dot<T>(N,X,Y);}
+}
+template <typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value,T>::type
+array_dot(const long, const T*, const T*, const int)
+{
+  array_not_numeric("dot");
+  return T();
+}
+
+//square root of a dot product, for norm
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value,double>::type
+array_sqrt(const T x)
+{
+  return sqrt((double) x);
+}
+template <typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value,double>::type
+array_sqrt(const T)
+{
+  array_not_numeric("norm");
+  return 0;
+}
+
+#endif
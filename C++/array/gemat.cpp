@@ -4,6 +4,13 @@
   general matrices. See .hpp file for usage details 
 -------------------------------------------------------*/
 #include "gemat.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
+#include "mem_io.hpp"
+#include "linal_ABpC.hpp"
+#include <math.h>
+
+#define GEMAT_TBLOCK 32 //block size of transpose_into
 
 /*-------------------------------------------------------
   Constructors
@@ -98,7 +105,7 @@ void gemat<T>::aligned_allocate(const int ALIGN, const long n, const long m)
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ALIGN+ll*sizeof(T),MEM_KIND_GEMAT);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate gemat of < 1 element \n");
   } else if (ll < 0) {
@@ -160,7 +167,7 @@ void gemat<T>::allocate(const long n, const long m)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ll*sizeof(T),MEM_KIND_GEMAT);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate gemat of < 1 element \n");
   } else if (ll < 0) {
@@ -295,7 +302,7 @@ void gemat<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    libj::mem_free(m_ptr); 
     m_len = 0;
     m_nrow = 0;
     m_ncol = 0;
@@ -569,3 +576,235 @@ void gemat<double*>::print() const
     }
   }
 }
+
+/*-------------------------------------------------------
+   axpy
+	- this += a*x, where x has the same shape. Uses
+	  the simd kernels, aligned to the common alignment
+	  of the two buffers
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::axpy(const T a, const gemat<T>& x)
+{
+  assert((m_allocated||m_assigned) && m_len == x.size());
+  if (x.rows() != m_nrow || x.cols() != m_ncol)
+  {
+    printf("ERROR gemat::axpy, shapes differ \n");
+    exit(1);
+  }
+  array_axpy<T>(m_len,a,&x[0],m_buf,array_align(m_alignment,x.get_alignment()));
+}
+template void gemat<double>::axpy(const double a, const gemat<double>& x);
+template void gemat<float>::axpy(const float a, const gemat<float>& x);
+template void gemat<long>::axpy(const long a, const gemat<long>& x);
+template void gemat<int>::axpy(const int a, const gemat<int>& x);
+
+/*-------------------------------------------------------
+   scale
+	- this *= a
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_scal<T>(m_len,a,m_buf,m_alignment);
+}
+template void gemat<double>::scale(const double a);
+template void gemat<float>::scale(const float a);
+template void gemat<long>::scale(const long a);
+template void gemat<int>::scale(const int a);
+
+/*-------------------------------------------------------
+   dot
+	- sum of the products of the elements of this
+	  and y, which has the same shape
+-------------------------------------------------------*/
+template <typename T>
+T gemat<T>::dot(const gemat<T>& y) const
+{
+  assert((m_allocated||m_assigned) && m_len == y.size());
+  if (y.rows() != m_nrow || y.cols() != m_ncol)
+  {
+    printf("ERROR gemat::dot, shapes differ \n");
+    exit(1);
+  }
+  return array_dot<T>(m_len,m_buf,&y[0],array_align(m_alignment,y.get_alignment()));
+}
+template double gemat<double>::dot(const gemat<double>& y) const;
+template float gemat<float>::dot(const gemat<float>& y) const;
+template long gemat<long>::dot(const gemat<long>& y) const;
+template int gemat<int>::dot(const gemat<int>& y) const;
+
+/*-------------------------------------------------------
+   norm
+	- the 2 (Frobenius) norm
+-------------------------------------------------------*/
+template <typename T>
+double gemat<T>::norm() const
+{
+  return array_sqrt(dot(*this));
+}
+template double gemat<double>::norm() const;
+template double gemat<float>::norm() const;
+template double gemat<long>::norm() const;
+template double gemat<int>::norm() const;
+
+/*-------------------------------------------------------
+   transpose_into
+	- B = this^T, in blocks of GEMAT_TBLOCK x GEMAT_TBLOCK
+	  so both matrices are read and written a few
+	  cache lines at a time
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::transpose_into(gemat<T>& B) const
+{
+  assert(m_allocated||m_assigned);
+  if (B.rows() != m_ncol || B.cols() != m_nrow)
+  {
+    printf("ERROR gemat::transpose_into, B is %ld x %ld, not %ld x %ld \n",
+           B.rows(),B.cols(),m_ncol,m_nrow);
+    exit(1);
+  }
+  for (long jj=0;jj<m_ncol;jj+=GEMAT_TBLOCK)
+  {
+    const long jend = (jj+GEMAT_TBLOCK < m_ncol) ? jj+GEMAT_TBLOCK : m_ncol;
+    for (long ii=0;ii<m_nrow;ii+=GEMAT_TBLOCK)
+    {
+      const long iend = (ii+GEMAT_TBLOCK < m_nrow) ? ii+GEMAT_TBLOCK : m_nrow;
+      for (long j=jj;j<jend;j++)
+      {
+        for (long i=ii;i<iend;i++)
+        {
+          B(j,i) = (*this)(i,j);
+        }
+      }
+    }
+  }
+}
+template void gemat<double>::transpose_into(gemat<double>& B) const;
+template void gemat<float>::transpose_into(gemat<float>& B) const;
+template void gemat<long>::transpose_into(gemat<long>& B) const;
+template void gemat<int>::transpose_into(gemat<int>& B) const;
+
+//linal_ABpC for numeric types
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+gemat_ABpC(const int M, const int N, const int K, const T alpha, const T* A,
+           const T* B, const T beta, T* C)
+{
+  linal_ABpC<T>(M,N,K,alpha,const_cast<T*>(A),const_cast<T*>(B),beta,C);
+}
+template <typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value>::type
+gemat_ABpC(const int, const int, const int, const T, const T*, const T*,
+           const T, T*)
+{
+  array_not_numeric("gemat::matmul");
+}
+
+/*-------------------------------------------------------
+   matmul
+	- this = alpha*A.B + beta*this, via linal_ABpC
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::matmul(const T alpha, const gemat<T>& A, const gemat<T>& B, const T beta)
+{
+  assert(m_allocated||m_assigned);
+  if (A.rows() != m_nrow || B.cols() != m_ncol || A.cols() != B.rows())
+  {
+    printf("ERROR gemat::matmul, (%ld x %ld).(%ld x %ld) is not %ld x %ld \n",
+           A.rows(),A.cols(),B.rows(),B.cols(),m_nrow,m_ncol);
+    exit(1);
+  }
+  gemat_ABpC<T>((int) m_nrow,(int) m_ncol,(int) A.cols(),alpha,&A[0],&B[0],beta,m_buf);
+}
+template void gemat<double>::matmul(const double alpha, const gemat<double>& A,
+                                    const gemat<double>& B, const double beta);
+template void gemat<float>::matmul(const float alpha, const gemat<float>& A,
+                                   const gemat<float>& B, const float beta);
+template void gemat<long>::matmul(const long alpha, const gemat<long>& A,
+                                  const gemat<long>& B, const long beta);
+template void gemat<int>::matmul(const int alpha, const gemat<int>& A,
+                                 const gemat<int>& B, const int beta);
+
+/*-------------------------------------------------------
+   save
+	- writes the gemat as a record at the position of
+	  fptr
+-------------------------------------------------------*/
+template <typename T>
+int gemat<T>::save(FILE* fptr) const
+{
+  if (libj::mem_io_type<T>() == MEM_IO_NONE) {return MEM_IO_ERR_TYPE;}
+  const size_t lengths[2] = {(size_t) m_nrow, (size_t) m_ncol};
+  const size_t strides[2] = {(size_t) 1, (size_t) m_nrow};
+  libj::mem_io_head h = libj::mem_io_make(MEM_KIND_GEMAT,libj::mem_io_type<T>(),sizeof(T),
+                                          2,lengths,strides,m_len,m_alignment);
+  return libj::mem_io_write(fptr,h,m_buf);
+}
+template int gemat<double>::save(FILE* fptr) const;
+template int gemat<float>::save(FILE* fptr) const;
+template int gemat<long>::save(FILE* fptr) const;
+template int gemat<int>::save(FILE* fptr) const;
+template int gemat<double*>::save(FILE* fptr) const;
+
+/*-------------------------------------------------------
+   load
+	- reads the next record of fptr into the gemat,
+	  which is allocated if it is unset, and must
+	  otherwise be the same shape
+-------------------------------------------------------*/
+template <typename T>
+int gemat<T>::load(FILE* fptr)
+{
+  libj::mem_io_head h;
+  int err = libj::mem_io_read_head(fptr,h);
+  if (err != 0) {return err;}
+  if ((err = libj::mem_io_check_type<T>(h,MEM_KIND_GEMAT,2)) != 0) {return err;}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  if (!(m_allocated || m_assigned))
+  {
+    allocate(n,m);
+  } else if (n != m_nrow || m != m_ncol) {
+    return MEM_IO_ERR_SHAPE;
+  }
+  return libj::mem_io_read_data(fptr,h,m_buf);
+}
+template int gemat<double>::load(FILE* fptr);
+template int gemat<float>::load(FILE* fptr);
+template int gemat<long>::load(FILE* fptr);
+template int gemat<int>::load(FILE* fptr);
+template int gemat<double*>::load(FILE* fptr);
+
+/*-------------------------------------------------------
+   view
+	- assigns the gemat to the data of the record at
+	  rec, which holds bytes, without a copy. The data
+	  is not checked (see mem_io_verify), and lives as
+	  long as the mapping
+-------------------------------------------------------*/
+template <typename T>
+int gemat<T>::view(const void* rec, const size_t bytes)
+{
+  libj::mem_io_head h;
+  const void* data = libj::mem_io_parse(rec,bytes,h);
+  if (data == NULL) {return MEM_IO_ERR_HEAD;}
+  int err = libj::mem_io_check_type<T>(h,MEM_KIND_GEMAT,2);
+  if (err != 0) {return err;}
+  if (bytes < MEM_IO_HEAD_BYTES + h.data_bytes) {return MEM_IO_ERR_READ;}
+  if (m_allocated) {return MEM_IO_ERR_SET;}
+  if (m_assigned) {unassign();}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  assign(n,m,(T*) data);
+  calc_alignment();
+  return 0;
+}
+template int gemat<double>::view(const void* rec, const size_t bytes);
+template int gemat<float>::view(const void* rec, const size_t bytes);
+template int gemat<long>::view(const void* rec, const size_t bytes);
+template int gemat<int>::view(const void* rec, const size_t bytes);
+template int gemat<double*>::view(const void* rec, const size_t bytes);
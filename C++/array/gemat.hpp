@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   gemat.hpp
 	JHT, October 28, 2021 : created 
+	JHT, October 19, 2026 : bulk operations
+	JHT, October 19, 2026 : binary records
   
   (GE)neral (MAT)rix : COL-MAJOR, general matrix, 
   which can be assigned to or allocated with memory, 
@@ -43,6 +45,22 @@
   M.is_allocated();	//returns true if matrix is allocated
   M.is_assigned();	//returns true if matrix is assigned
 
+  BULK OPERATIONS (simd kernels, aligned when the buffers are)
+  --------------------------
+  M.axpy(a,X);		//M += a*X, X of the same shape
+  M.scale(a);		//M *= a
+  M.dot(Y);		//sum of elementwise products
+  M.norm();		//2 (Frobenius) norm
+  M.transpose_into(B);	//B = M^T, B must be cols x rows
+  M.matmul(a,A,B,b);	//M = a*A.B + b*M, via linal_ABpC
+
+  BINARY RECORDS (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  --------------------------
+  M.save(fptr);		//write a record at the position of fptr
+  M.load(fptr);		//read the next record, allocating M if it
+			//  is unset, else it must be that shape
+  M.view(rec,bytes);	//assign M to the data of a mapped record
+
 --------------------------------------------------------*/
 #ifndef GEMAT_HPP
 #define GEMAT_HPP
@@ -96,7 +114,7 @@ class gemat
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
-  inline int get_alignment()
+  inline int get_alignment() const
     {return m_alignment;}
 
   //Class functions
@@ -115,6 +133,20 @@ class gemat
   void print() const;	//prints matrix
   void calc_alignment();
 
+  //bulk operations, through the simd kernels
+  void axpy(const T a, const gemat<T>& x);	//this += a*x
+  void scale(const T a);			//this *= a
+  T dot(const gemat<T>& y) const;		//sum of elementwise products
+  double norm() const;			//2 (Frobenius) norm
+  void transpose_into(gemat<T>& B) const;	//B = this^T
+  void matmul(const T alpha, const gemat<T>& A,
+              const gemat<T>& B, const T beta);	//this = alpha*A.B + beta*this
+
+  //binary records (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  int save(FILE* fptr) const;			//write a record
+  int load(FILE* fptr);				//read the next record
+  int view(const void* rec, const size_t bytes);	//assign to a mapped record
+
 };
 template class gemat<double>;
 template class gemat<float>;
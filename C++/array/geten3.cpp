@@ -4,6 +4,9 @@
   general, 3 dimension tensors 
 -------------------------------------------------------*/
 #include "geten3.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
+#include "mem_io.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -95,7 +98,7 @@ void geten3<T>::aligned_allocate(const int ALIGN, const long n, const long m, co
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ALIGN+ll*sizeof(T),MEM_KIND_GETEN3);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten3 of < 1 element \n");
   } else if (ll < 0) {
@@ -157,7 +160,7 @@ void geten3<T>::allocate(const long n, const long m, const long l)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ll*sizeof(T),MEM_KIND_GETEN3);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten3 of < 1 element \n");
   } else if (ll < 0) {
@@ -292,7 +295,7 @@ void geten3<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    libj::mem_free(m_ptr); 
     m_len = 0;
     m_nd1 = 0;
     m_nd2 = 0;
@@ -505,3 +508,156 @@ void geten3<int>::print() const
     }
   }
 }
+
+/*-------------------------------------------------------
+   axpy
+	- this += a*x, where x has the same shape. Uses
+	  the simd kernels, aligned to the common alignment
+	  of the two buffers
+-------------------------------------------------------*/
+template <typename T>
+void geten3<T>::axpy(const T a, const geten3<T>& x)
+{
+  assert((m_allocated||m_assigned) && m_len == x.size());
+  if (x.size_d1() != m_nd1 || x.size_d2() != m_nd2 || x.size_d3() != m_nd3)
+  {
+    printf("ERROR geten3::axpy, shapes differ \n");
+    exit(1);
+  }
+  array_axpy<T>(m_len,a,&x[0],m_buf,array_align(m_alignment,x.get_alignment()));
+}
+template void geten3<double>::axpy(const double a, const geten3<double>& x);
+template void geten3<float>::axpy(const float a, const geten3<float>& x);
+template void geten3<long>::axpy(const long a, const geten3<long>& x);
+template void geten3<int>::axpy(const int a, const geten3<int>& x);
+
+/*-------------------------------------------------------
+   scale
+	- this *= a
+-------------------------------------------------------*/
+template <typename T>
+void geten3<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_scal<T>(m_len,a,m_buf,m_alignment);
+}
+template void geten3<double>::scale(const double a);
+template void geten3<float>::scale(const float a);
+template void geten3<long>::scale(const long a);
+template void geten3<int>::scale(const int a);
+
+/*-------------------------------------------------------
+   dot
+	- sum of the products of the elements of this
+	  and y, which has the same shape
+-------------------------------------------------------*/
+template <typename T>
+T geten3<T>::dot(const geten3<T>& y) const
+{
+  assert((m_allocated||m_assigned) && m_len == y.size());
+  if (y.size_d1() != m_nd1 || y.size_d2() != m_nd2 || y.size_d3() != m_nd3)
+  {
+    printf("ERROR geten3::dot, shapes differ \n");
+    exit(1);
+  }
+  return array_dot<T>(m_len,m_buf,&y[0],array_align(m_alignment,y.get_alignment()));
+}
+template double geten3<double>::dot(const geten3<double>& y) const;
+template float geten3<float>::dot(const geten3<float>& y) const;
+template long geten3<long>::dot(const geten3<long>& y) const;
+template int geten3<int>::dot(const geten3<int>& y) const;
+
+/*-------------------------------------------------------
+   norm
+	- the 2 (Frobenius) norm
+-------------------------------------------------------*/
+template <typename T>
+double geten3<T>::norm() const
+{
+  return array_sqrt(dot(*this));
+}
+template double geten3<double>::norm() const;
+template double geten3<float>::norm() const;
+template double geten3<long>::norm() const;
+template double geten3<int>::norm() const;
+
+/*-------------------------------------------------------
+   save
+	- writes the geten3 as a record at the position of
+	  fptr
+-------------------------------------------------------*/
+template <typename T>
+int geten3<T>::save(FILE* fptr) const
+{
+  if (libj::mem_io_type<T>() == MEM_IO_NONE) {return MEM_IO_ERR_TYPE;}
+  const size_t lengths[3] = {(size_t) m_nd1, (size_t) m_nd2, (size_t) m_nd3};
+  const size_t strides[3] = {(size_t) 1, (size_t) m_nd1, (size_t) (m_nd1*m_nd2)};
+  libj::mem_io_head h = libj::mem_io_make(MEM_KIND_GETEN3,libj::mem_io_type<T>(),sizeof(T),
+                                          3,lengths,strides,m_len,m_alignment);
+  return libj::mem_io_write(fptr,h,m_buf);
+}
+template int geten3<double>::save(FILE* fptr) const;
+template int geten3<float>::save(FILE* fptr) const;
+template int geten3<long>::save(FILE* fptr) const;
+template int geten3<int>::save(FILE* fptr) const;
+
+/*-------------------------------------------------------
+   load
+	- reads the next record of fptr into the geten3,
+	  which is allocated if it is unset, and must
+	  otherwise be the same shape
+-------------------------------------------------------*/
+template <typename T>
+int geten3<T>::load(FILE* fptr)
+{
+  libj::mem_io_head h;
+  int err = libj::mem_io_read_head(fptr,h);
+  if (err != 0) {return err;}
+  if ((err = libj::mem_io_check_type<T>(h,MEM_KIND_GETEN3,3)) != 0) {return err;}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  const long l = (long) h.lengths[2];
+  if (!(m_allocated || m_assigned))
+  {
+    allocate(n,m,l);
+  } else if (n != m_nd1 || m != m_nd2 || l != m_nd3) {
+    return MEM_IO_ERR_SHAPE;
+  }
+  return libj::mem_io_read_data(fptr,h,m_buf);
+}
+template int geten3<double>::load(FILE* fptr);
+template int geten3<float>::load(FILE* fptr);
+template int geten3<long>::load(FILE* fptr);
+template int geten3<int>::load(FILE* fptr);
+
+/*-------------------------------------------------------
+   view
+	- assigns the geten3 to the data of the record at
+	  rec, which holds bytes, without a copy. The data
+	  is not checked (see mem_io_verify), and lives as
+	  long as the mapping
+-------------------------------------------------------*/
+template <typename T>
+int geten3<T>::view(const void* rec, const size_t bytes)
+{
+  libj::mem_io_head h;
+  const void* data = libj::mem_io_parse(rec,bytes,h);
+  if (data == NULL) {return MEM_IO_ERR_HEAD;}
+  int err = libj::mem_io_check_type<T>(h,MEM_KIND_GETEN3,3);
+  if (err != 0) {return err;}
+  if (bytes < MEM_IO_HEAD_BYTES + h.data_bytes) {return MEM_IO_ERR_READ;}
+  if (m_allocated) {return MEM_IO_ERR_SET;}
+  if (m_assigned) {unassign();}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  const long l = (long) h.lengths[2];
+  assign(n,m,l,(T*) data);
+  calc_alignment();
+  return 0;
+}
+template int geten3<double>::view(const void* rec, const size_t bytes);
+template int geten3<float>::view(const void* rec, const size_t bytes);
+template int geten3<long>::view(const void* rec, const size_t bytes);
+template int geten3<int>::view(const void* rec, const size_t bytes);
@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   geten3.hpp
 	JHT, December 13, 2021 : created 
+	JHT, October 19, 2026 : bulk operations
+	JHT, October 19, 2026 : binary records
   
   (GE)neral (TEN)sor dimension (3) : a general tensor
   with three dimensions. 
@@ -45,8 +47,22 @@
   M.zero();		//zeros the whole tensor
   M.is_allocated();	//returns true if tensor is allocated
   M.is_assigned();	//returns true if tensor is assigned
+
+  BULK OPERATIONS (simd kernels, aligned when the buffers are)
+  --------------------------
+  M.axpy(a,X);		//M += a*X, X of the same shape
+  M.scale(a);		//M *= a
+  M.dot(Y);		//sum of elementwise products
+  M.norm();		//2 (Frobenius) norm
   M = a;		//make the matrix equal to a scalar
 
+  BINARY RECORDS (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  --------------------------
+  M.save(fptr);		//write a record at the position of fptr
+  M.load(fptr);		//read the next record, allocating M if it
+			//  is unset, else it must be that shape
+  M.view(rec,bytes);	//assign M to the data of a mapped record
+
 --------------------------------------------------------*/
 #ifndef GETEN3_HPP
 #define GETEN3_HPP
@@ -107,7 +123,7 @@ class geten3
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
-  inline int get_alignment()
+  inline int get_alignment() const
     {return m_alignment;}
 
   //Class functions
@@ -128,6 +144,17 @@ class geten3
   void print() const;		//prints tensor
   void calc_alignment();	//calculates the alignment of the tensor
 
+  //bulk operations, through the simd kernels
+  void axpy(const T a, const geten3<T>& x);	//this += a*x
+  void scale(const T a);			//this *= a
+  T dot(const geten3<T>& y) const;		//sum of elementwise products
+  double norm() const;			//2 (Frobenius) norm
+
+  //binary records (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  int save(FILE* fptr) const;			//write a record
+  int load(FILE* fptr);				//read the next record
+  int view(const void* rec, const size_t bytes);	//assign to a mapped record
+
 };
 template class geten3<double>;
 template class geten3<float>;
@@ -4,6 +4,9 @@
   general, 3 dimension tensors 
 -------------------------------------------------------*/
 #include "geten4.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
+#include "mem_io.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -96,7 +99,7 @@ void geten4<T>::aligned_allocate(const int ALIGN, const long n, const long m, co
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ALIGN+ll*sizeof(T),MEM_KIND_GETEN4);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten4 of < 1 element \n");
   } else if (ll < 0) {
@@ -159,7 +162,7 @@ void geten4<T>::allocate(const long n, const long m, const long l, const long k)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ll*sizeof(T),MEM_KIND_GETEN4);
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten4 of < 1 element \n");
   } else if (ll < 0) {
@@ -297,7 +300,7 @@ void geten4<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    libj::mem_free(m_ptr); 
     m_len = 0;
     m_nd1 = 0;
     m_nd2 = 0;
@@ -527,3 +530,158 @@ void geten4<int>::print() const
     }
   }
 }
+
+/*-------------------------------------------------------
+   axpy
+	- this += a*x, where x has the same shape. Uses
+	  the simd kernels, aligned to the common alignment
+	  of the two buffers
+-------------------------------------------------------*/
+template <typename T>
+void geten4<T>::axpy(const T a, const geten4<T>& x)
+{
+  assert((m_allocated||m_assigned) && m_len == x.size());
+  if (x.size_d1() != m_nd1 || x.size_d2() != m_nd2 || x.size_d3() != m_nd3 || x.size_d4() != m_nd4)
+  {
+    printf("ERROR geten4::axpy, shapes differ \n");
+    exit(1);
+  }
+  array_axpy<T>(m_len,a,&x[0],m_buf,array_align(m_alignment,x.get_alignment()));
+}
+template void geten4<double>::axpy(const double a, const geten4<double>& x);
+template void geten4<float>::axpy(const float a, const geten4<float>& x);
+template void geten4<long>::axpy(const long a, const geten4<long>& x);
+template void geten4<int>::axpy(const int a, const geten4<int>& x);
+
+/*-------------------------------------------------------
+   scale
+	- this *= a
+-------------------------------------------------------*/
+template <typename T>
+void geten4<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_scal<T>(m_len,a,m_buf,m_alignment);
+}
+template void geten4<double>::scale(const double a);
+template void geten4<float>::scale(const float a);
+template void geten4<long>::scale(const long a);
+template void geten4<int>::scale(const int a);
+
+/*-------------------------------------------------------
+   dot
+	- sum of the products of the elements of this
+	  and y, which has the same shape
+-------------------------------------------------------*/
+template <typename T>
+T geten4<T>::dot(const geten4<T>& y) const
+{
+  assert((m_allocated||m_assigned) && m_len == y.size());
+  if (y.size_d1() != m_nd1 || y.size_d2() != m_nd2 || y.size_d3() != m_nd3 || y.size_d4() != m_nd4)
+  {
+    printf("ERROR geten4::dot, shapes differ \n");
+    exit(1);
+  }
+  return array_dot<T>(m_len,m_buf,&y[0],array_align(m_alignment,y.get_alignment()));
+}
+template double geten4<double>::dot(const geten4<double>& y) const;
+template float geten4<float>::dot(const geten4<float>& y) const;
+template long geten4<long>::dot(const geten4<long>& y) const;
+template int geten4<int>::dot(const geten4<int>& y) const;
+
+/*-------------------------------------------------------
+   norm
+	- the 2 (Frobenius) norm
+-------------------------------------------------------*/
+template <typename T>
+double geten4<T>::norm() const
+{
+  return array_sqrt(dot(*this));
+}
+template double geten4<double>::norm() const;
+template double geten4<float>::norm() const;
+template double geten4<long>::norm() const;
+template double geten4<int>::norm() const;
+
+/*-------------------------------------------------------
+   save
+	- writes the geten4 as a record at the position of
+	  fptr
+-------------------------------------------------------*/
+template <typename T>
+int geten4<T>::save(FILE* fptr) const
+{
+  if (libj::mem_io_type<T>() == MEM_IO_NONE) {return MEM_IO_ERR_TYPE;}
+  const size_t lengths[4] = {(size_t) m_nd1, (size_t) m_nd2, (size_t) m_nd3, (size_t) m_nd4};
+  const size_t strides[4] = {(size_t) 1, (size_t) m_nd1, (size_t) (m_nd1*m_nd2), (size_t) (m_nd1*m_nd2*m_nd3)};
+  libj::mem_io_head h = libj::mem_io_make(MEM_KIND_GETEN4,libj::mem_io_type<T>(),sizeof(T),
+                                          4,lengths,strides,m_len,m_alignment);
+  return libj::mem_io_write(fptr,h,m_buf);
+}
+template int geten4<double>::save(FILE* fptr) const;
+template int geten4<float>::save(FILE* fptr) const;
+template int geten4<long>::save(FILE* fptr) const;
+template int geten4<int>::save(FILE* fptr) const;
+
+/*-------------------------------------------------------
+   load
+	- reads the next record of fptr into the geten4,
+	  which is allocated if it is unset, and must
+	  otherwise be the same shape
+-------------------------------------------------------*/
+template <typename T>
+int geten4<T>::load(FILE* fptr)
+{
+  libj::mem_io_head h;
+  int err = libj::mem_io_read_head(fptr,h);
+  if (err != 0) {return err;}
+  if ((err = libj::mem_io_check_type<T>(h,MEM_KIND_GETEN4,4)) != 0) {return err;}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  const long l = (long) h.lengths[2];
+  const long k = (long) h.lengths[3];
+  if (!(m_allocated || m_assigned))
+  {
+    allocate(n,m,l,k);
+  } else if (n != m_nd1 || m != m_nd2 || l != m_nd3 || k != m_nd4) {
+    return MEM_IO_ERR_SHAPE;
+  }
+  return libj::mem_io_read_data(fptr,h,m_buf);
+}
+template int geten4<double>::load(FILE* fptr);
+template int geten4<float>::load(FILE* fptr);
+template int geten4<long>::load(FILE* fptr);
+template int geten4<int>::load(FILE* fptr);
+
+/*-------------------------------------------------------
+   view
+	- assigns the geten4 to the data of the record at
+	  rec, which holds bytes, without a copy. The data
+	  is not checked (see mem_io_verify), and lives as
+	  long as the mapping
+-------------------------------------------------------*/
+template <typename T>
+int geten4<T>::view(const void* rec, const size_t bytes)
+{
+  libj::mem_io_head h;
+  const void* data = libj::mem_io_parse(rec,bytes,h);
+  if (data == NULL) {return MEM_IO_ERR_HEAD;}
+  int err = libj::mem_io_check_type<T>(h,MEM_KIND_GETEN4,4);
+  if (err != 0) {return err;}
+  if (bytes < MEM_IO_HEAD_BYTES + h.data_bytes) {return MEM_IO_ERR_READ;}
+  if (m_allocated) {return MEM_IO_ERR_SET;}
+  if (m_assigned) {unassign();}
+
+  const long n = (long) h.lengths[0];
+  const long m = (long) h.lengths[1];
+  const long l = (long) h.lengths[2];
+  const long k = (long) h.lengths[3];
+  assign(n,m,l,k,(T*) data);
+  calc_alignment();
+  return 0;
+}
+template int geten4<double>::view(const void* rec, const size_t bytes);
+template int geten4<float>::view(const void* rec, const size_t bytes);
+template int geten4<long>::view(const void* rec, const size_t bytes);
+template int geten4<int>::view(const void* rec, const size_t bytes);
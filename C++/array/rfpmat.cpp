@@ -0,0 +1,358 @@
+/*-------------------------------------------------------
+  rfpmat.cpp
+  .cpp file for rfpmat class, symmetric matrices in
+  the rectangular full packed layout
+
+  usage described in rfpmat.hpp
+-------------------------------------------------------*/
+#include "rfpmat.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
+
+/*-------------------------------------------------------
+  Constructors
+-------------------------------------------------------*/
+template <typename T>
+rfpmat<T>::rfpmat()
+{
+  m_buf = NULL;
+  m_len = 0;
+  m_n = 0;
+  m_n1 = 0;
+  m_ld = 0;
+  m_alignment = 0;
+  m_assigned = false;
+  m_allocated = false;
+}
+template rfpmat<double>::rfpmat();
+template rfpmat<float>::rfpmat();
+template rfpmat<long>::rfpmat();
+template rfpmat<int>::rfpmat();
+
+template <typename T>
+rfpmat<T>::rfpmat(const long n)
+{
+  m_allocated = false;
+  m_assigned = false;
+  allocate(n);
+}
+template rfpmat<double>::rfpmat(const long n);
+template rfpmat<float>::rfpmat(const long n);
+template rfpmat<long>::rfpmat(const long n);
+template rfpmat<int>::rfpmat(const long n);
+
+template <typename T>
+rfpmat<T>::rfpmat(const long n, T* ptr)
+{
+  m_allocated = false;
+  m_assigned = false;
+  assign(n,ptr);
+}
+template rfpmat<double>::rfpmat(const long n, double* ptr);
+template rfpmat<float>::rfpmat(const long n, float* ptr);
+template rfpmat<long>::rfpmat(const long n, long* ptr);
+template rfpmat<int>::rfpmat(const long n, int* ptr);
+
+/*-------------------------------------------------------
+  Destructors
+-------------------------------------------------------*/
+template <typename T>
+rfpmat<T>::~rfpmat()
+{
+  free();
+}
+template rfpmat<double>::~rfpmat();
+template rfpmat<float>::~rfpmat();
+template rfpmat<long>::~rfpmat();
+template rfpmat<int>::~rfpmat();
+
+/*-------------------------------------------------------
+  m_set
+	- sets the dimensions for an n x n matrix
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::m_set(const long n)
+{
+  m_n = n;
+  m_n1 = n/2;
+  m_ld = (n%2 == 0) ? n+1 : n;
+  m_len = n*(n+1)/2;
+}
+template void rfpmat<double>::m_set(const long n);
+template void rfpmat<float>::m_set(const long n);
+template void rfpmat<long>::m_set(const long n);
+template void rfpmat<int>::m_set(const long n);
+
+/*-------------------------------------------------------
+ * calc_alignment()
+ * calculates the alignment of m_buf
+-------------------------------------------------------*/
+template<typename T>
+void rfpmat<T>::calc_alignment()
+{
+  m_alignment = 1;
+  //2,4,8,16,32,64,128
+  for (long m=2;m<=128;m*=2)
+  {
+    if ((long)m_buf%m != 0) {return;}
+    m_alignment *= 2;
+  }
+  return;
+}
+template void rfpmat<double>::calc_alignment();
+template void rfpmat<float>::calc_alignment();
+template void rfpmat<long>::calc_alignment();
+template void rfpmat<int>::calc_alignment();
+
+/*-------------------------------------------------------
+  allocate
+	- the memory is counted with the usymat, which
+	  holds the same elements
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::allocate(const long n)
+{
+  if (m_allocated || m_assigned)
+  {
+    printf("Attempted to allocate an already set rfpmat \n");
+    exit(1);
+  } else if (n < 0) {
+    printf("Attempted to allocate rfpmat of < 0 rows \n");
+    exit(1);
+  }
+
+  m_set(n);
+  m_buf = (T*) libj::mem_alloc(m_len*sizeof(T),MEM_KIND_USYMAT);
+  if (m_buf == NULL && m_len > 0)
+  {
+    printf("malloc failed of rfpmat of %ld,%ld elements \n",n,n);
+    exit(1);
+  }
+  m_allocated = true;
+  m_assigned = false;
+  calc_alignment();
+}
+template void rfpmat<double>::allocate(const long n);
+template void rfpmat<float>::allocate(const long n);
+template void rfpmat<long>::allocate(const long n);
+template void rfpmat<int>::allocate(const long n);
+
+/*-------------------------------------------------------
+  assign
+	- ptr must hold n(n+1)/2 elements
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::assign(const long n, T* ptr)
+{
+  if (m_allocated || m_assigned)
+  {
+    printf("Attempted to assign an already set rfpmat \n");
+    exit(1);
+  } else if (n < 0) {
+    printf("Attempted to assign rfpmat of < 0 rows \n");
+    exit(1);
+  }
+
+  m_set(n);
+  m_buf = ptr;
+  m_allocated = false;
+  m_assigned = true;
+  calc_alignment();
+}
+template void rfpmat<double>::assign(const long n, double* ptr);
+template void rfpmat<float>::assign(const long n, float* ptr);
+template void rfpmat<long>::assign(const long n, long* ptr);
+template void rfpmat<int>::assign(const long n, int* ptr);
+
+/*-------------------------------------------------------
+  free
+	- deallocates or unassigns the matrix
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::free()
+{
+  if (m_allocated) {libj::mem_free(m_buf);}
+  m_buf = NULL;
+  m_len = 0;
+  m_n = 0;
+  m_n1 = 0;
+  m_ld = 0;
+  m_alignment = 0;
+  m_allocated = false;
+  m_assigned = false;
+}
+template void rfpmat<double>::free();
+template void rfpmat<float>::free();
+template void rfpmat<long>::free();
+template void rfpmat<int>::free();
+
+/*-------------------------------------------------------
+  info()
+	- prints information about the matrix
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::info() const
+{
+  if (m_assigned || m_allocated)
+  {
+    printf("rfpmat has %ld elements \n",m_len);
+    printf("rfpmat has %ld cols \n",m_n);
+    printf("rfpmat is stored as %ld x %ld \n",m_ld,m_n-m_n1);
+    printf("rfpmat buffer begins at %p \n",(void*) m_buf);
+    printf("rfpmat is aligned to %d bytes \n",m_alignment);
+  } else {
+    printf("rfpmat is unset \n");
+  }
+}
+template void rfpmat<double>::info() const;
+template void rfpmat<float>::info() const;
+template void rfpmat<long>::info() const;
+template void rfpmat<int>::info() const;
+
+/*-------------------------------------------------------
+  zero()
+	- zeros the matrix
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::zero()
+{
+  for (long i=0;i<m_len;i++) {m_buf[i] = (T) 0;}
+}
+template void rfpmat<double>::zero();
+template void rfpmat<float>::zero();
+template void rfpmat<long>::zero();
+template void rfpmat<int>::zero();
+
+/*-------------------------------------------------------
+  from_usymat
+	- copies a usymat into this matrix, allocating it
+	  if it is unset. The columns of A22 and A12 are
+	  whole usymat columns, the columns of A11 are
+	  read with a stride of ld
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::from_usymat(const usymat<T>& U)
+{
+  if (!(m_allocated || m_assigned)) {allocate(U.cols());}
+  if (U.cols() != m_n)
+  {
+    printf("ERROR rfpmat::from_usymat, usymat is %ld x %ld, rfpmat is %ld x %ld \n",
+           U.cols(),U.cols(),m_n,m_n);
+    exit(1);
+  }
+
+  for (long c=m_n1;c<m_n;c++)
+  {
+    const T* src = &U(0,c);
+    T* dst = m_buf + (c-m_n1)*m_ld;
+    for (long r=0;r<=c;r++) {dst[r] = src[r];}
+  }
+  for (long c=0;c<m_n1;c++)
+  {
+    const T* src = &U(0,c);
+    T* dst = m_buf + m_n1 + 1 + c;
+    for (long r=0;r<=c;r++) {dst[r*m_ld] = src[r];}
+  }
+}
+template void rfpmat<double>::from_usymat(const usymat<double>& U);
+template void rfpmat<float>::from_usymat(const usymat<float>& U);
+template void rfpmat<long>::from_usymat(const usymat<long>& U);
+template void rfpmat<int>::from_usymat(const usymat<int>& U);
+
+/*-------------------------------------------------------
+  to_usymat
+	- copies this matrix into a usymat, which must be
+	  n x n
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::to_usymat(usymat<T>& U) const
+{
+  if (U.cols() != m_n)
+  {
+    printf("ERROR rfpmat::to_usymat, usymat is %ld x %ld, rfpmat is %ld x %ld \n",
+           U.cols(),U.cols(),m_n,m_n);
+    exit(1);
+  }
+
+  for (long c=m_n1;c<m_n;c++)
+  {
+    const T* src = m_buf + (c-m_n1)*m_ld;
+    T* dst = &U(0,c);
+    for (long r=0;r<=c;r++) {dst[r] = src[r];}
+  }
+  for (long c=0;c<m_n1;c++)
+  {
+    const T* src = m_buf + m_n1 + 1 + c;
+    T* dst = &U(0,c);
+    for (long r=0;r<=c;r++) {dst[r] = src[r*m_ld];}
+  }
+}
+template void rfpmat<double>::to_usymat(usymat<double>& U) const;
+template void rfpmat<float>::to_usymat(usymat<float>& U) const;
+template void rfpmat<long>::to_usymat(usymat<long>& U) const;
+template void rfpmat<int>::to_usymat(usymat<int>& U) const;
+
+/*-------------------------------------------------------
+  symv
+	- y = alpha*M.x + beta*y
+	- every stored column is a contiguous run, used
+	  once as an axpy (its upper triangle) and once
+	  as a dot (its lower triangle)
+-------------------------------------------------------*/
+template <typename T>
+void rfpmat<T>::symv(const T alpha, const T* x, const T beta, T* y) const
+{
+  if (beta == (T) 0)
+  {
+    for (long i=0;i<m_n;i++) {y[i] = (T) 0;}
+  } else if (beta != (T) 1) {
+    simd_scal_mul<T>(m_n,beta,y);
+  }
+  if (m_n == 0) {return;}
+
+  const long n1 = m_n1;
+  const long n2 = m_n - m_n1;
+  const T* x1 = x;
+  const T* x2 = x + n1;
+  T* y1 = y;
+  T* y2 = y + n1;
+
+  for (long k=0;k<n2;k++)
+  {
+    const T* col = m_buf + k*m_ld;
+
+    //A12, column k
+    if (n1 > 0)
+    {
+      simd_axpy<T>(n1,alpha*x2[k],col,y1);
+      y2[k] += alpha*simd_dot<T>(n1,col,x1);
+    }
+
+    //A22, column k
+    const T* a22 = col + n1;
+    if (k > 0)
+    {
+      simd_axpy<T>(k,alpha*x2[k],a22,y2);
+      y2[k] += alpha*simd_dot<T>(k,a22,x2);
+    }
+    y2[k] += alpha*a22[k]*x2[k];
+  }
+
+  //A11, column r holds A(r,r..n1-1)
+  for (long r=0;r<n1;r++)
+  {
+    const T* a11 = m_buf + r*m_ld + n1 + 1 + r;
+    const long len = n1 - r - 1;
+    T sum = a11[0]*x1[r];
+    if (len > 0)
+    {
+      simd_axpy<T>(len,alpha*x1[r],a11+1,y1+r+1);
+      sum += simd_dot<T>(len,a11+1,x1+r+1);
+    }
+    y1[r] += alpha*sum;
+  }
+}
+template void rfpmat<double>::symv(const double alpha, const double* x, const double beta, double* y) const;
+template void rfpmat<float>::symv(const float alpha, const float* x, const float beta, float* y) const;
+template void rfpmat<long>::symv(const long alpha, const long* x, const long beta, long* y) const;
+template void rfpmat<int>::symv(const int alpha, const int* x, const int beta, int* y) const;
@@ -0,0 +1,159 @@
+/*-------------------------------------------------------
+  rfpmat.hpp
+    JHT, October 19, 2026 : created
+
+  (R)ectangular (F)ull (P)acked symmetric (MAT)rix :
+  the same n(n+1)/2 elements as a usymat, stored as a
+  COL-MAJOR rectangle (LAPACK RFP, TRANSR='N', UPLO='U')
+  so that every block is a dense, column major matrix.
+
+  With n1 = n/2 and n2 = n - n1, the matrix is split as
+
+      | A11  A12 |	A11 : n1 x n1, symmetric
+      |      A22 |	A12 : n1 x n2, general
+			A22 : n2 x n2, symmetric
+
+  and stored in a ld x n2 array, ld = n+1 for even n,
+  and n for odd n, as
+
+      | A12       |	rows 0 .. n1-1
+      | upper A22 |	rows n1 .. n1+j of column j
+      | lower A11 |	rows n1+1+j .. of column j
+
+  For n = 5 (n1 = 2), with ij for element (i,j)
+
+      02 03 04
+      12 13 14
+      22 23 24
+      00 33 34
+      01 11 44
+
+  Every column of every block is contiguous, so the
+  kernels that act on it (symv here, and the linal
+  routines on the blocks) run on dense columns, rather
+  than the growing columns of the usymat layout.
+
+  NOTE : There is NO BOUNDS CHECKING in this class
+
+  NOTE : Indexing begins at zero. M(i,j) and M(j,i)
+         are the same element
+
+  INITIALIZATION OPTIONS
+  --------------------------
+  rfpmat<double> M;		//generate class, nothing else
+  rfpmat<double> M(n);		//generate and allocate
+  rfpmat<double> M(n,pntr);	//generate and assign, n(n+1)/2 elements
+  M.allocate(n);
+  M.assign(n,pntr);
+  M.free();			//deallocate or unassign
+
+  CONVERSION
+  --------------------------
+  M.from_usymat(U);		//M = U, U must be n x n
+  M.to_usymat(U);		//U = M
+
+  BLOCKS (pointer to the first element, leading dimension ld())
+  --------------------------
+  M.A12();			//n1 x n2 general
+  M.A22();			//n2 x n2, upper triangle
+  M.A11();			//n1 x n1, lower triangle (A11^T)
+
+  FUNCTIONS
+  --------------------------
+  M(i,j);			//element i,j, either triangle
+  M[i];				//i'th element of the buffer
+  M.size(); M.rows(); M.cols(); M.ld(); M.n1(); M.n2();
+  M.zero();
+  M.symv(a,x,b,y);		//y = a*M.x + b*y, x and y of n elements
+  M.info();
+
+--------------------------------------------------------*/
+#ifndef RFPMAT_HPP
+#define RFPMAT_HPP
+
+#include <cstdlib>
+#include <stdio.h>
+#include <assert.h>
+#include "usymat.hpp"
+
+template <typename T>
+class rfpmat
+{
+  private:
+  T*           m_buf;		//pointer to start of buffer
+  long         m_len;		//number of elements
+  long           m_n;		//rows and cols
+  long          m_n1;		//rows of A11
+  long          m_ld;		//leading dimension
+  int    m_alignment;		//alignment in bytes
+  bool   m_allocated;		//is allocated
+  bool    m_assigned;		//is assigned
+
+  void m_set(const long n);
+
+  public:
+  //initialization/destructors
+  rfpmat();
+  rfpmat(const long n);
+  rfpmat(const long n, T* ptr);
+ ~rfpmat();
+
+  //element access, i <= j is the upper triangle
+  inline T& operator() (const long i, const long j)
+  {
+    const long r = (i <= j) ? i : j;
+    const long c = (i <= j) ? j : i;
+    return (c >= m_n1) ? *(m_buf + (c-m_n1)*m_ld + r)
+                       : *(m_buf + r*m_ld + m_n1 + 1 + c);
+  }
+  inline const T& operator() (const long i, const long j) const
+  {
+    const long r = (i <= j) ? i : j;
+    const long c = (i <= j) ? j : i;
+    return (c >= m_n1) ? *(m_buf + (c-m_n1)*m_ld + r)
+                       : *(m_buf + r*m_ld + m_n1 + 1 + c);
+  }
+  inline T& operator[] (const long i)
+    {return(*(m_buf + i));}
+  inline const T& operator[] (const long i) const
+    {return(*(m_buf+i));}
+
+  //Dimension information : inlined
+  inline long size() const {return m_len;}
+  inline long rows() const {return m_n;}
+  inline long cols() const {return m_n;}
+  inline long ld() const {return m_ld;}
+  inline long n1() const {return m_n1;}
+  inline long n2() const {return m_n - m_n1;}
+
+  //blocks
+  inline T* A12() {return m_buf;}
+  inline const T* A12() const {return m_buf;}
+  inline T* A22() {return m_buf + m_n1;}
+  inline const T* A22() const {return m_buf + m_n1;}
+  inline T* A11() {return m_buf + m_n1 + 1;}
+  inline const T* A11() const {return m_buf + m_n1 + 1;}
+
+  inline bool is_allocated() const {return m_allocated;}
+  inline bool is_assigned() const {return m_assigned;}
+  inline int get_alignment() const {return m_alignment;}
+
+  //Class functions
+  void allocate(const long n);
+  void assign(const long n, T* ptr);
+  void free();
+  void info() const;
+  void zero();
+  void calc_alignment();
+
+  void from_usymat(const usymat<T>& U);
+  void to_usymat(usymat<T>& U) const;
+  void symv(const T alpha, const T* x, const T beta, T* y) const;
+};
+
+template class rfpmat<double>;
+template class rfpmat<float>;
+template class rfpmat<long>;
+template class rfpmat<int>;
+
+#endif
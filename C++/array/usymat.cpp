@@ -6,6 +6,9 @@
   usaged described in usymat.hpp
 -------------------------------------------------------*/
 #include "usymat.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
+#include "mem_io.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -61,7 +64,7 @@ usymat<T>::~usymat()
     m_buf = NULL;
     m_ptr = NULL; 
   } else if (m_allocated) {
-    std::free(m_ptr);
+    libj::mem_free(m_ptr);
     m_buf = NULL; 
   }
 }
@@ -102,7 +105,7 @@ void usymat<T>::aligned_allocate(const int ALIGN, const long n, const long m)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm && n == m) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm && n == m) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ALIGN+ll*sizeof(T),MEM_KIND_USYMAT);
   } else if (n != m) {
     printf("Attempted to allocate usymat where nrow != m_ncol \n");
     exit(1);
@@ -161,7 +164,7 @@ void usymat<T>::allocate(const long n, const long m)
   const long mm=std::numeric_limits<long>::max(); //gives largest long 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm && n == m) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ll*sizeof(T),MEM_KIND_USYMAT);
   } else if (n != m) {
     printf("Attempted to allocate usymat where nrow != m_ncol \n");
     exit(1);
@@ -300,7 +303,7 @@ void usymat<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    libj::mem_free(m_ptr); 
     m_len = 0;
     m_ncol = 0;
     m_allocated = false;
@@ -531,3 +534,156 @@ void usymat<int>::print() const
     }
   }
 }
+
+/*-------------------------------------------------------
+   axpy
+	- this += a*x, where x has the same shape. Uses
+	  the simd kernels, aligned to the common alignment
+	  of the two buffers
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::axpy(const T a, const usymat<T>& x)
+{
+  assert((m_allocated||m_assigned) && m_len == x.size());
+  if (x.cols() != m_ncol)
+  {
+    printf("ERROR usymat::axpy, shapes differ \n");
+    exit(1);
+  }
+  array_axpy<T>(m_len,a,&x[0],m_buf,array_align(m_alignment,x.get_alignment()));
+}
+template void usymat<double>::axpy(const double a, const usymat<double>& x);
+template void usymat<float>::axpy(const float a, const usymat<float>& x);
+template void usymat<long>::axpy(const long a, const usymat<long>& x);
+template void usymat<int>::axpy(const int a, const usymat<int>& x);
+
+/*-------------------------------------------------------
+   scale
+	- this *= a
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_scal<T>(m_len,a,m_buf,m_alignment);
+}
+template void usymat<double>::scale(const double a);
+template void usymat<float>::scale(const float a);
+template void usymat<long>::scale(const long a);
+template void usymat<int>::scale(const int a);
+
+/*-------------------------------------------------------
+   dot
+	- sum of the products of the elements of this
+	  and y, over the full symmetric matrix, so the
+	  off diagonal elements count twice
+-------------------------------------------------------*/
+template <typename T>
+T usymat<T>::dot(const usymat<T>& y) const
+{
+  assert((m_allocated||m_assigned) && m_len == y.size());
+  if (y.cols() != m_ncol)
+  {
+    printf("ERROR usymat::dot, shapes differ \n");
+    exit(1);
+  }
+  const T full = array_dot<T>(m_len,m_buf,&y[0],array_align(m_alignment,y.get_alignment()));
+  T diag = (T) 0;
+  for (long j=0;j<m_ncol;j++) {diag += (*this)(j,j)*y(j,j);}
+  return (T) 2*full - diag;
+}
+template double usymat<double>::dot(const usymat<double>& y) const;
+template float usymat<float>::dot(const usymat<float>& y) const;
+template long usymat<long>::dot(const usymat<long>& y) const;
+template int usymat<int>::dot(const usymat<int>& y) const;
+
+/*-------------------------------------------------------
+   norm
+	- the 2 (Frobenius) norm
+-------------------------------------------------------*/
+template <typename T>
+double usymat<T>::norm() const
+{
+  return array_sqrt(dot(*this));
+}
+template double usymat<double>::norm() const;
+template double usymat<float>::norm() const;
+template double usymat<long>::norm() const;
+template double usymat<int>::norm() const;
+
+/*-------------------------------------------------------
+   save
+	- writes the usymat as a record at the position of
+	  fptr
+-------------------------------------------------------*/
+template <typename T>
+int usymat<T>::save(FILE* fptr) const
+{
+  if (libj::mem_io_type<T>() == MEM_IO_NONE) {return MEM_IO_ERR_TYPE;}
+  const size_t lengths[2] = {(size_t) m_ncol, (size_t) m_ncol};
+  const size_t strides[2] = {(size_t) 0, (size_t) 0};
+  libj::mem_io_head h = libj::mem_io_make(MEM_KIND_USYMAT,libj::mem_io_type<T>(),sizeof(T),
+                                          2,lengths,strides,m_len,m_alignment);
+  return libj::mem_io_write(fptr,h,m_buf);
+}
+template int usymat<double>::save(FILE* fptr) const;
+template int usymat<float>::save(FILE* fptr) const;
+template int usymat<long>::save(FILE* fptr) const;
+template int usymat<int>::save(FILE* fptr) const;
+
+/*-------------------------------------------------------
+   load
+	- reads the next record of fptr into the usymat,
+	  which is allocated if it is unset, and must
+	  otherwise be the same shape
+-------------------------------------------------------*/
+template <typename T>
+int usymat<T>::load(FILE* fptr)
+{
+  libj::mem_io_head h;
+  int err = libj::mem_io_read_head(fptr,h);
+  if (err != 0) {return err;}
+  if ((err = libj::mem_io_check_type<T>(h,MEM_KIND_USYMAT,2)) != 0) {return err;}
+
+  const long n = (long) h.lengths[0];
+  if (!(m_allocated || m_assigned))
+  {
+    allocate(n,n);
+  } else if (n != m_ncol) {
+    return MEM_IO_ERR_SHAPE;
+  }
+  return libj::mem_io_read_data(fptr,h,m_buf);
+}
+template int usymat<double>::load(FILE* fptr);
+template int usymat<float>::load(FILE* fptr);
+template int usymat<long>::load(FILE* fptr);
+template int usymat<int>::load(FILE* fptr);
+
+/*-------------------------------------------------------
+   view
+	- assigns the usymat to the data of the record at
+	  rec, which holds bytes, without a copy. The data
+	  is not checked (see mem_io_verify), and lives as
+	  long as the mapping
+-------------------------------------------------------*/
+template <typename T>
+int usymat<T>::view(const void* rec, const size_t bytes)
+{
+  libj::mem_io_head h;
+  const void* data = libj::mem_io_parse(rec,bytes,h);
+  if (data == NULL) {return MEM_IO_ERR_HEAD;}
+  int err = libj::mem_io_check_type<T>(h,MEM_KIND_USYMAT,2);
+  if (err != 0) {return err;}
+  if (bytes < MEM_IO_HEAD_BYTES + h.data_bytes) {return MEM_IO_ERR_READ;}
+  if (m_allocated) {return MEM_IO_ERR_SET;}
+  if (m_assigned) {unassign();}
+
+  const long n = (long) h.lengths[0];
+  assign(n,n,(T*) data);
+  calc_alignment();
+  return 0;
+}
+template int usymat<double>::view(const void* rec, const size_t bytes);
+template int usymat<float>::view(const void* rec, const size_t bytes);
+template int usymat<long>::view(const void* rec, const size_t bytes);
+template int usymat<int>::view(const void* rec, const size_t bytes);
@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   usymat.hpp
     JHT, October 28, 2021 : created 
+    JHT, October 19, 2026 : bulk operations
+    JHT, October 19, 2026 : binary records
 
   (U)pper (SY)mmetric (MAT)rix : 
 
@@ -47,6 +49,24 @@
   M.is_allocated();	//returns true if matrix is m_allocated
   M.is_assigned();	//returns true if matrix is m_assigned
 
+  BULK OPERATIONS (simd kernels, aligned when the buffers are)
+  --------------------------
+  M.axpy(a,X);		//M += a*X, X of the same shape
+  M.scale(a);		//M *= a
+  M.dot(Y);		//sum of elementwise products, full matrix
+  M.norm();		//2 (Frobenius) norm
+
+  BINARY RECORDS (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  --------------------------
+  M.save(fptr);		//write a record at the position of fptr
+  M.load(fptr);		//read the next record, allocating M if it
+			//  is unset, else it must be that shape
+  M.view(rec,bytes);	//assign M to the data of a mapped record
+
+  NOTE : for kernels that sweep the whole matrix (symv),
+         rfpmat.hpp holds the same elements in dense
+         columns, see rfpmat::from_usymat
+
 --------------------------------------------------------*/
 #ifndef USYMAT_HPP
 #define USYMAT_HPP
@@ -98,7 +118,7 @@ class usymat
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
-  inline int get_alignment()
+  inline int get_alignment() const
     {return m_alignment;}
 
   //Class functions
@@ -117,6 +137,17 @@ class usymat
   void print() const;		//prints matrix
   void calc_alignment();	//determine alignment 
 
+  //bulk operations, through the simd kernels
+  void axpy(const T a, const usymat<T>& x);	//this += a*x
+  void scale(const T a);			//this *= a
+  T dot(const usymat<T>& y) const;		//sum of elementwise products
+  double norm() const;			//2 (Frobenius) norm
+
+  //binary records (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  int save(FILE* fptr) const;			//write a record
+  int load(FILE* fptr);				//read the next record
+  int view(const void* rec, const size_t bytes);	//assign to a mapped record
+
 };
 
 template class usymat<double>;
@@ -1,11 +1,14 @@
 /*-------------------------------------------------------
   vec.cpp
     JHT, October 27, 2021 : created
+    JHT, October 19, 2026 : allocations through mem.hpp
 
   .cpp file for vector templates
 
 -------------------------------------------------------*/
 #include "vec.hpp"
+#include "mem.hpp"
+#include "array_simd.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -94,7 +97,7 @@ void vec<T>::allocate(const long n)
 //  if (!(m_allocated || m_assigned) && n >= 1 && n <= mm) 
   if (!(m_allocated || m_assigned) && n >= 0 && n <= mm) 
   {
-    m_ptr = (T*) malloc(n*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(n*sizeof(T),MEM_KIND_VEC);
   } else if (n < 0) {
     printf("Attempted to allocate vec of < 0 element \n");
     exit(1);
@@ -137,7 +140,7 @@ void vec<T>::aligned_allocate(const int ALIGN, const long N)
 //  if (!(m_allocated || m_assigned) && N >= 1 && N <= mm) 
   if (!(m_allocated || m_assigned) && N >= 0 && N <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+N*sizeof(T));
+    m_ptr = (T*) libj::mem_alloc(ALIGN+N*sizeof(T),MEM_KIND_VEC);
 //  } else if (N < 1) {
 //    printf("Attempted to aligned allocate vec of < 1 element \n");
   } else if (N < 0) {
@@ -300,7 +303,7 @@ void vec<T>::deallocate()
   if (m_allocated)  
   { 
     m_len = 0;
-    std::free(m_ptr); 
+    libj::mem_free(m_ptr); 
     m_buf = NULL;
     m_allocated = false;
   } else {
@@ -508,3 +511,75 @@ void vec<int>::print(const long lo, const long hi) const
     i++;
   }
 }
+
+/*-------------------------------------------------------
+   axpy
+	- this += a*x, where x has the same shape. Uses
+	  the simd kernels, aligned to the common alignment
+	  of the two buffers
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::axpy(const T a, const vec<T>& x)
+{
+  assert((m_allocated||m_assigned) && m_len == x.size());
+  if (x.size() != m_len)
+  {
+    printf("ERROR vec::axpy, shapes differ \n");
+    exit(1);
+  }
+  array_axpy<T>(m_len,a,&x[0],m_buf,array_align(m_alignment,x.get_alignment()));
+}
+template void vec<double>::axpy(const double a, const vec<double>& x);
+template void vec<float>::axpy(const float a, const vec<float>& x);
+template void vec<long>::axpy(const long a, const vec<long>& x);
+template void vec<int>::axpy(const int a, const vec<int>& x);
+
+/*-------------------------------------------------------
+   scale
+	- this *= a
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_scal<T>(m_len,a,m_buf,m_alignment);
+}
+template void vec<double>::scale(const double a);
+template void vec<float>::scale(const float a);
+template void vec<long>::scale(const long a);
+template void vec<int>::scale(const int a);
+
+/*-------------------------------------------------------
+   dot
+	- sum of the products of the elements of this
+	  and y, which has the same shape
+-------------------------------------------------------*/
+template <typename T>
+T vec<T>::dot(const vec<T>& y) const
+{
+  assert((m_allocated||m_assigned) && m_len == y.size());
+  if (y.size() != m_len)
+  {
+    printf("ERROR vec::dot, shapes differ \n");
+    exit(1);
+  }
+  return array_dot<T>(m_len,m_buf,&y[0],array_align(m_alignment,y.get_alignment()));
+}
+template double vec<double>::dot(const vec<double>& y) const;
+template float vec<float>::dot(const vec<float>& y) const;
+template long vec<long>::dot(const vec<long>& y) const;
+template int vec<int>::dot(const vec<int>& y) const;
+
+/*-------------------------------------------------------
+   norm
+	- the 2 (Frobenius) norm
+-------------------------------------------------------*/
+template <typename T>
+double vec<T>::norm() const
+{
+  return array_sqrt(dot(*this));
+}
+template double vec<double>::norm() const;
+template double vec<float>::norm() const;
+template double vec<long>::norm() const;
+template double vec<int>::norm() const;
@@ -39,6 +39,13 @@
   v.is_assigned();	//returns true if vector is assigned
   v.alignment();    //returns alignment in BYTES
 
+  BULK OPERATIONS (simd kernels, aligned when the buffers are)
+  --------------------------
+  v.axpy(a,X);		//v += a*X, X of the same shape
+  v.scale(a);		//v *= a
+  v.dot(Y);		//sum of elementwise products
+  v.norm();		//2 (Frobenius) norm
+
 --------------------------------------------------------*/
 #ifndef VEC_HPP
 #define VEC_HPP
@@ -109,6 +116,12 @@ class vec
              const long hi) const;         	//  lo and hi
   void calc_alignment(); 			//determine the alignment
 
+  //bulk operations, through the simd kernels
+  void axpy(const T a, const vec<T>& x);	//this += a*x
+  void scale(const T a);			//this *= a
+  T dot(const vec<T>& y) const;		//sum of elementwise products
+  double norm() const;			//2 (Frobenius) norm
+
 };
 
 template class vec<double>;
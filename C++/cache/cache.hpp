@@ -1,6 +1,8 @@
 /*-----------------------------------------------------------------------------
  * cache.hpp
  *  JHT, May 7, 2022 : created
+ *  JHT, October 19, 2026 : runtime sizes in cache_info.hpp
+ *  JHT, October 19, 2026 : per kernel blocking in tune.hpp
  *
  *  .hpp file for the cache struct, which provides and interface to 
  *  stacked byte arrays of size par with L1 and L2 cache, and additional
@@ -21,9 +23,19 @@
  *
  *  //Determine the number of elements of a given type in cache
  *  num_double = cache.L1_elements<double>();
+ *
+ *  These counts are the compile time defaults of libjdef.h. Blocking
+ *  that should fit the machine it runs on uses libj::cache_blocking()
+ *  of cache_info.hpp instead, and per thread pack buffers sized from it
+ *  come from libj::pack_buffer<T>() of cache_pool.hpp
 -----------------------------------------------------------------------------*/
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
 #include <stdlib.h>
 #include "libjdef.h"
+#include "cache_info.hpp"
+#include "tune.hpp"
 
 namespace libj
 {
@@ -86,3 +98,5 @@ struct Cache
 }; //cache struct 
 
 }//end namespace
+
+#endif
@@ -0,0 +1,294 @@
+/*-----------------------------------------------------------------------------
+ * cache_info.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : overrides below a sane minimum are ignored
+ *
+ *  Runtime detection of the cache hierarchy, and the blocking parameters
+ *  jblis takes from it.
+ *
+ *  The L1 data, L2, and L3 caches of cpu 0 are read from
+ *    1) /sys/devices/system/cpu/cpu0/cache (linux)
+ *    2) CPUID leaf 4 (Intel) or 0x8000001D (AMD), on x86
+ *    3) the compile time LIBJ_L1_BYTES, LIBJ_L2_BYTES and LIBJ_LINE_BYTES
+ *       of libjdef.h, which remain the default when nothing else works
+ *  and may be overridden with the environment variables
+ *    LIBJ_L1_BYTES, LIBJ_L2_BYTES, LIBJ_L3_BYTES, LIBJ_LINE_BYTES
+ *  An override that does not parse, or is below CACHE_MIN_L1, CACHE_MIN_L2,
+ *  CACHE_MIN_LINE (LIBJ_L3_BYTES may be 0, for no L3), is ignored with a
+ *  warning, and the detected value is kept, as the pack buffers and
+ *  blocks are sized from these.
+ *
+ *  For each level the size, line size, and number of logical cpus that
+ *  share it are kept. Detection runs once, the first time cache_blocking()
+ *  is called, and is then only a static reference.
+ *
+ *  The Cache struct of cache.hpp keeps its constexpr element counts, for
+ *  scratch arrays that must be sized at compile time.
+ *
+ *  USAGE
+ *  ------------------
+ *  const libj::cache_params& cp = libj::cache_blocking();
+ *  size_t panel = cp.panel_elements<double>();	//per thread L2 panel
+ *  size_t pack  = cp.pack_elements<double>();	//8 cache lines
+ *  cp.L2.bytes; cp.L2.shared; cp.line_bytes;
+ *  libj::cache_print(stdout);
+-----------------------------------------------------------------------------*/
+#ifndef CACHE_INFO_HPP
+#define CACHE_INFO_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "libjdef.h"
+#if defined (__x86_64__) || defined (__i386__)
+  #include <cpuid.h>
+#endif
+
+#define CACHE_MAX_INDEX 16 //sysfs cache indices looked at
+#define CACHE_MIN_L1 4096 //smallest L1 and L2 overrides, bytes
+#define CACHE_MIN_L2 16384
+#define CACHE_MIN_LINE 16 //smallest line override, bytes
+
+namespace libj
+{
+
+//one level of cache
+struct cache_level
+{
+  size_t bytes;		//total size, 0 if not present
+  size_t line;		//line size
+  int    shared;	//logical cpus sharing it
+
+  //bytes each sharing cpu may count on
+  size_t per_cpu() const {return (shared > 1) ? bytes/shared : bytes;}
+};
+
+//the hierarchy, and the blocking parameters taken from it
+struct cache_params
+{
+  cache_level L1;
+  cache_level L2;
+  cache_level L3;
+  size_t      line_bytes;
+  const char* source;	//"sysfs", "cpuid", or "default"
+
+  template<typename T> size_t L1_elements() const {return L1.bytes/sizeof(T);}
+  template<typename T> size_t L2_elements() const {return L2.bytes/sizeof(T);}
+  template<typename T> size_t L3_elements() const {return L3.bytes/sizeof(T);}
+  template<typename T> size_t LINE_elements() const
+  {
+    return (line_bytes >= sizeof(T)) ? line_bytes/sizeof(T) : 1;
+  }
+
+  //blocks for panel/pack loops: a panel fills the L2 share of one thread,
+  //  a pack is eight lines
+  template<typename T> size_t panel_elements() const
+  {
+    const size_t n = L2.per_cpu()/sizeof(T);
+    return (n > 0) ? n : 1;
+  }
+  template<typename T> size_t pack_elements() const {return 8*LINE_elements<T>();}
+};
+
+//---------------------------------------------------------------------------
+// helpers
+//---------------------------------------------------------------------------
+//reads the first line of a file, false if it cannot
+inline bool cache_read_line(const char* path, char* buf, const size_t len)
+{
+  FILE* fptr = fopen(path,"r");
+  if (fptr == NULL) {return false;}
+  const bool ok = (fgets(buf,(int) len,fptr) != NULL);
+  fclose(fptr);
+  if (ok) {buf[strcspn(buf,"\n")] = '\0';}
+  return ok;
+}
+
+//"48K", "2048K", "105M" to bytes, ok if that is all there is
+inline size_t cache_parse_size(const char* str, bool* ok = NULL)
+{
+  char* end;
+  size_t n = (size_t) strtoul(str,&end,10);
+  const bool digits = (end != str);
+  if (*end == 'K' || *end == 'k') {n *= 1024; end++;}
+  else if (*end == 'M' || *end == 'm') {n *= 1024*1024; end++;}
+  else if (*end == 'G' || *end == 'g') {n *= 1024*1024*1024UL; end++;}
+  if (ok != NULL) {*ok = digits && (*end == '\0' || *end == '\n');}
+  return n;
+}
+
+//an environment override of at least min bytes, or else value, the
+//  detected size. 0 is allowed when zero_ok
+inline size_t cache_env_size(const char* name, const size_t min, const bool zero_ok,
+                             const size_t value)
+{
+  const char* env = getenv(name);
+  if (env == NULL) {return value;}
+  bool parsed;
+  const size_t n = cache_parse_size(env,&parsed);
+  if (parsed && (n >= min || (zero_ok && n == 0))) {return n;}
+  printf("WARNING libj::cache_detect\n");
+  printf("%s=%s is not a size of at least %zu bytes, using %zu\n",name,env,min,value);
+  return value;
+}
+
+//"0-1,56-57" to 4
+inline int cache_count_cpus(const char* str)
+{
+  int count = 0;
+  const char* ptr = str;
+  while (*ptr != '\0')
+  {
+    char* end;
+    const long first = strtol(ptr,&end,10);
+    if (end == ptr) {break;}
+    long last = first;
+    if (*end == '-') {ptr = end+1; last = strtol(ptr,&end,10);}
+    count += (int) (last - first + 1);
+    ptr = (*end == ',') ? end+1 : end;
+  }
+  return (count > 0) ? count : 1;
+}
+
+//set a level if it is data or unified
+inline void cache_set_level(cache_params& cp, const int level, const size_t bytes,
+                            const size_t line, const int shared)
+{
+  cache_level lev = {bytes,line,shared};
+  if (level == 1) {cp.L1 = lev;}
+  else if (level == 2) {cp.L2 = lev;}
+  else if (level == 3) {cp.L3 = lev;}
+}
+
+//---------------------------------------------------------------------------
+// cache_detect_sysfs -- true if the L1 and L2 were found
+//---------------------------------------------------------------------------
+inline bool cache_detect_sysfs(cache_params& cp)
+{
+  #if defined (__linux__)
+  char path[128];
+  char buf[256];
+  for (int idx=0;idx<CACHE_MAX_INDEX;idx++)
+  {
+    const char* base = "/sys/devices/system/cpu/cpu0/cache/index";
+    snprintf(path,sizeof(path),"%s%d/type",base,idx);
+    if (!cache_read_line(path,buf,sizeof(buf))) {break;}
+    if (strcmp(buf,"Instruction") == 0) {continue;}
+
+    snprintf(path,sizeof(path),"%s%d/level",base,idx);
+    if (!cache_read_line(path,buf,sizeof(buf))) {continue;}
+    const int level = atoi(buf);
+
+    snprintf(path,sizeof(path),"%s%d/size",base,idx);
+    if (!cache_read_line(path,buf,sizeof(buf))) {continue;}
+    const size_t bytes = cache_parse_size(buf);
+
+    size_t line = LIBJ_LINE_BYTES;
+    snprintf(path,sizeof(path),"%s%d/coherency_line_size",base,idx);
+    if (cache_read_line(path,buf,sizeof(buf)) && atoi(buf) > 0) {line = atoi(buf);}
+
+    int shared = 1;
+    snprintf(path,sizeof(path),"%s%d/shared_cpu_list",base,idx);
+    if (cache_read_line(path,buf,sizeof(buf))) {shared = cache_count_cpus(buf);}
+
+    if (bytes > 0) {cache_set_level(cp,level,bytes,line,shared);}
+  }
+  return cp.L1.bytes > 0 && cp.L2.bytes > 0;
+  #else
+  return false;
+  #endif
+}
+
+//---------------------------------------------------------------------------
+// cache_detect_cpuid -- true if the L1 and L2 were found
+//---------------------------------------------------------------------------
+inline bool cache_detect_cpuid(cache_params& cp)
+{
+  #if defined (__x86_64__) || defined (__i386__)
+  unsigned int eax,ebx,ecx,edx;
+
+  //deterministic cache parameters, same layout on Intel and AMD
+  const unsigned int max_basic = __get_cpuid_max(0,NULL);
+  const unsigned int max_ext = __get_cpuid_max(0x80000000,NULL);
+  unsigned int leaves[2] = {0,0};
+  int nleaf = 0;
+  if (max_basic >= 4) {leaves[nleaf++] = 4;}
+  if (max_ext >= 0x8000001D) {leaves[nleaf++] = 0x8000001D;}
+
+  for (int l=0;l<nleaf;l++)
+  {
+    for (unsigned int sub=0;sub<CACHE_MAX_INDEX;sub++)
+    {
+      __cpuid_count(leaves[l],sub,eax,ebx,ecx,edx);
+      const unsigned int type = eax & 0x1F;	//0 none, 1 data, 2 instruction, 3 unified
+      if (type == 0) {break;}
+      if (type == 2) {continue;}
+      const int level = (eax >> 5) & 0x7;
+      const int shared = (int) ((eax >> 14) & 0xFFF) + 1;
+      const size_t line = (ebx & 0xFFF) + 1;
+      const size_t parts = ((ebx >> 12) & 0x3FF) + 1;
+      const size_t ways = ((ebx >> 22) & 0x3FF) + 1;
+      const size_t sets = (size_t) ecx + 1;
+      cache_set_level(cp,level,ways*parts*line*sets,line,shared);
+    }
+    if (cp.L1.bytes > 0 && cp.L2.bytes > 0) {return true;}
+  }
+  #endif
+  return false;
+}
+
+//---------------------------------------------------------------------------
+// cache_detect -- the hierarchy of this machine
+//---------------------------------------------------------------------------
+inline cache_params cache_detect()
+{
+  cache_params cp;
+  const cache_level none = {0,LIBJ_LINE_BYTES,1};
+  cp.L1 = none;
+  cp.L2 = none;
+  cp.L3 = none;
+  cp.source = "sysfs";
+
+  if (!cache_detect_sysfs(cp))
+  {
+    cp.L1 = none; cp.L2 = none; cp.L3 = none;
+    cp.source = "cpuid";
+    if (!cache_detect_cpuid(cp))
+    {
+      cp.L1 = none; cp.L2 = none; cp.L3 = none;
+      cp.L1.bytes = LIBJ_L1_BYTES;
+      cp.L2.bytes = LIBJ_L2_BYTES;
+      cp.source = "default";
+    }
+  }
+  cp.line_bytes = (cp.L1.line > 0) ? cp.L1.line : LIBJ_LINE_BYTES;
+
+  //environment overrides
+  cp.L1.bytes = cache_env_size("LIBJ_L1_BYTES",CACHE_MIN_L1,false,cp.L1.bytes);
+  cp.L2.bytes = cache_env_size("LIBJ_L2_BYTES",CACHE_MIN_L2,false,cp.L2.bytes);
+  cp.L3.bytes = cache_env_size("LIBJ_L3_BYTES",CACHE_MIN_L2,true,cp.L3.bytes);
+  cp.line_bytes = cache_env_size("LIBJ_LINE_BYTES",CACHE_MIN_LINE,false,cp.line_bytes);
+  return cp;
+}
+
+//---------------------------------------------------------------------------
+// cache_blocking -- the parameters, detected on first call
+//---------------------------------------------------------------------------
+inline const cache_params& cache_blocking()
+{
+  static const cache_params cp = cache_detect();
+  return cp;
+}
+
+inline void cache_print(FILE* fptr)
+{
+  const cache_params& cp = cache_blocking();
+  fprintf(fptr,"libj cache (%s), line %zu bytes\n",cp.source,cp.line_bytes);
+  fprintf(fptr,"  L1 %zu bytes, shared by %d\n",cp.L1.bytes,cp.L1.shared);
+  fprintf(fptr,"  L2 %zu bytes, shared by %d\n",cp.L2.bytes,cp.L2.shared);
+  fprintf(fptr,"  L3 %zu bytes, shared by %d\n",cp.L3.bytes,cp.L3.shared);
+}
+
+}//end namespace
+
+#endif
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------------
+ * cache_pool.hpp
+ *  JHT, October 19, 2026 : created
+ *
+ *  .hpp file for the per thread pack buffers. Each thread has its own
+ *  cache_pool, allocated the first time the thread asks for a buffer and
+ *  freed when the thread ends, so packing routines may run under OpenMP
+ *  without sharing, or allocating, scratch space.
+ *
+ *  A pool holds one buffer per level, sized to the share of that level
+ *  each cpu has in the detected cache (see cache_info.hpp)
+ *    CACHE_POOL_LINE	: one cache line
+ *    CACHE_POOL_L1	: the L1 share
+ *    CACHE_POOL_L2	: the L2 share
+ *  Each buffer starts on its own cache line. The pool comes from
+ *  mem_alloc with transparent huge pages, in a region that starts on a
+ *  2 MiB boundary, so it never shares a line, or a page, with another
+ *  thread.
+ *
+ *  Unlike libj::Cache, nothing is sized at compile time, and nothing
+ *  lives on the stack.
+ *
+ *  USAGE
+ *  ------------------
+ *  #pragma omp parallel
+ *  {
+ *    double* pack = libj::pack_buffer<double>(CACHE_POOL_L2);
+ *    size_t n = libj::pack_elements<double>(CACHE_POOL_L2);
+ *    ... pack up to n elements ...
+ *  }
+-----------------------------------------------------------------------------*/
+#ifndef CACHE_POOL_HPP
+#define CACHE_POOL_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "libjdef.h"
+#include "cache_info.hpp"
+#include "mem.hpp"
+
+//levels of pack buffer
+#define CACHE_POOL_LINE 0
+#define CACHE_POOL_L1 1
+#define CACHE_POOL_L2 2
+#define CACHE_POOL_NLEVEL 3
+
+namespace libj
+{
+
+class cache_pool
+{
+  private:
+  char*  m_base;
+  char*  m_buffer[CACHE_POOL_NLEVEL];
+  size_t m_bytes[CACHE_POOL_NLEVEL];
+
+  void m_allocate()
+  {
+    const cache_params& cp = cache_blocking();
+    const size_t line = cp.line_bytes;
+    m_bytes[CACHE_POOL_LINE] = line;
+    m_bytes[CACHE_POOL_L1] = cp.L1.per_cpu();
+    m_bytes[CACHE_POOL_L2] = cp.L2.per_cpu();
+
+    //each buffer rounded up to, and followed by, a whole line
+    size_t off[CACHE_POOL_NLEVEL];
+    size_t total = 0;
+    for (int lev=0;lev<CACHE_POOL_NLEVEL;lev++)
+    {
+      off[lev] = total;
+      total += ((m_bytes[lev] + line - 1)/line + 1)*line;
+    }
+
+    mem_policy pol = mem_get_policy();
+    if (pol.pages == MEM_PAGES_DEFAULT) {pol.pages = MEM_PAGES_THP;}
+    pol.min_bytes = 0;
+    m_base = (char*) mem_alloc(total,MEM_KIND_CACHE,pol);
+    if (m_base == NULL)
+    {
+      printf("ERROR libj::cache_pool\n");
+      printf("could not allocate %zu bytes of pack buffers\n",total);
+      exit(1);
+    }
+    for (int lev=0;lev<CACHE_POOL_NLEVEL;lev++) {m_buffer[lev] = m_base + off[lev];}
+  }
+
+  public:
+  cache_pool() : m_base(NULL) {}
+  ~cache_pool() {mem_free(m_base);}
+  cache_pool(const cache_pool&) = delete;
+  cache_pool& operator=(const cache_pool&) = delete;
+
+  //the buffer of a level, allocated on first use
+  char* buffer(const int level)
+  {
+    if (m_base == NULL) {m_allocate();}
+    return m_buffer[level];
+  }
+
+  size_t bytes(const int level)
+  {
+    if (m_base == NULL) {m_allocate();}
+    return m_bytes[level];
+  }
+};
+
+//the pool of this thread
+inline cache_pool& cache_local()
+{
+  static thread_local cache_pool pool;
+  return pool;
+}
+
+template<typename T>
+inline T* pack_buffer(const int level)
+{
+  return (T*) cache_local().buffer(level);
+}
+
+template<typename T>
+inline size_t pack_elements(const int level)
+{
+  return cache_local().bytes(level)/sizeof(T);
+}
+
+}//end namespace
+
+#endif
@@ -0,0 +1,251 @@
+/*-----------------------------------------------------------------------------
+ * tune.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : contraction blocking
+ *
+ *  Blocking parameters of each jblis kernel and type, and the tuning
+ *  profile they are read from.
+ *
+ *  Each kernel has, for each type
+ *    panel	: elements per panel (one OpenMP chunk)
+ *    pack	: elements per pack, within a panel
+ *    block	: rows per row block (the microkernel size)
+ *  except contract (the tile contractions of block_sparse.hpp), where
+ *    panel	: KC, the depth of a packed A block and B sliver
+ *    pack	: MC, the rows of a packed A block
+ *    block	: MR, the rows of the microkernel
+ *  The defaults come from the detected cache (see cache_info.hpp), and
+ *  for contract a panel and pack of 0 mean they are sized to the pack
+ *  buffers of cache_pool.hpp. The first call to tune_get loads the
+ *  profile in $LIBJ_TUNE_PROFILE, or else $HOME/.libj_tune, if there is
+ *  one. Profiles are written by the jblis_tune program (jblis/tune), and
+ *  look like
+ *
+ *    # libj tuning profile
+ *    # kernel type panel pack block
+ *    zero double 131072 65536 16
+ *    expr float 262144 128 16
+ *    contract double 256 96 8
+ *
+ *  Kernels and types not in the profile keep their defaults. The block
+ *  of zero and of contract is fixed at the size of their unrolled
+ *  microkernels, and the KC and MC of contract are cut to what the pack
+ *  buffers hold.
+ *
+ *  USAGE
+ *  ------------------
+ *  const libj::tune_params& tp = libj::tune_get<double>(TUNE_ZERO);
+ *  tp.panel; tp.pack; tp.block;
+ *  libj::tune_load("profile");	//replace the parameters in the profile
+ *  libj::tune_save("profile");	//write all parameters
+ *  libj::tune_set<double>(TUNE_EXPR,tp); //set before any parallel region
+-----------------------------------------------------------------------------*/
+#ifndef TUNE_HPP
+#define TUNE_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "libjdef.h"
+#include "cache_info.hpp"
+
+//kernels
+#define TUNE_ZERO 0
+#define TUNE_EXPR 1
+#define TUNE_CONTRACT 2
+#define TUNE_NKERNEL 3
+
+//types
+#define TUNE_DOUBLE 0
+#define TUNE_FLOAT 1
+#define TUNE_LONG 2
+#define TUNE_INT 3
+#define TUNE_NTYPE 4
+
+#define TUNE_ZERO_BLOCK 16 //rows of the zero microkernel
+#define TUNE_CONTRACT_BLOCK 8 //rows of the contract microkernel, CONTRACT_MR
+
+namespace libj
+{
+
+struct tune_params
+{
+  size_t panel;
+  size_t pack;
+  size_t block;
+};
+
+template<typename T> inline int tune_type();
+template<> inline int tune_type<double>() {return TUNE_DOUBLE;}
+template<> inline int tune_type<float>() {return TUNE_FLOAT;}
+template<> inline int tune_type<long>() {return TUNE_LONG;}
+template<> inline int tune_type<int>() {return TUNE_INT;}
+
+inline const char* tune_kernel_name(const int kernel)
+{
+  static const char* name[TUNE_NKERNEL] = {"zero","expr","contract"};
+  return name[kernel];
+}
+
+inline const char* tune_type_name(const int type)
+{
+  static const char* name[TUNE_NTYPE] = {"double","float","long","int"};
+  return name[type];
+}
+
+inline size_t tune_type_size(const int type)
+{
+  static const size_t size[TUNE_NTYPE] = {sizeof(double),sizeof(float),
+                                          sizeof(long),sizeof(int)};
+  return size[type];
+}
+
+//---------------------------------------------------------------------------
+// tune_default -- parameters from the detected cache
+//---------------------------------------------------------------------------
+inline tune_params tune_default(const int kernel, const int type)
+{
+  const cache_params& cp = cache_blocking();
+  const size_t size = tune_type_size(type);
+  tune_params tp;
+  tp.panel = cp.L2.per_cpu()/size;
+  if (tp.panel == 0) {tp.panel = 1;}
+  if (kernel == TUNE_ZERO)
+  {
+    tp.pack = (tp.panel/2 > 0) ? tp.panel/2 : 1;
+    tp.block = TUNE_ZERO_BLOCK;
+  } else if (kernel == TUNE_CONTRACT) {
+    tp.panel = 0;
+    tp.pack = 0;
+    tp.block = TUNE_CONTRACT_BLOCK;
+  } else {
+    tp.pack = 8*((cp.line_bytes >= size) ? cp.line_bytes/size : 1);
+    tp.block = 16;
+  }
+  return tp;
+}
+
+//---------------------------------------------------------------------------
+// the table
+//---------------------------------------------------------------------------
+struct tune_table
+{
+  tune_params param[TUNE_NKERNEL][TUNE_NTYPE];
+};
+
+inline int tune_load(tune_table& table, const char* path);
+
+inline tune_table tune_init()
+{
+  tune_table table;
+  for (int k=0;k<TUNE_NKERNEL;k++)
+  {
+    for (int t=0;t<TUNE_NTYPE;t++) {table.param[k][t] = tune_default(k,t);}
+  }
+
+  const char* env = getenv("LIBJ_TUNE_PROFILE");
+  if (env != NULL)
+  {
+    tune_load(table,env);
+  } else if ((env = getenv("HOME")) != NULL) {
+    char path[1024];
+    snprintf(path,sizeof(path),"%s/.libj_tune",env);
+    tune_load(table,path);
+  }
+  return table;
+}
+
+inline tune_table& tune_ref()
+{
+  static tune_table table = tune_init();
+  return table;
+}
+
+template<typename T>
+inline const tune_params& tune_get(const int kernel)
+{
+  return tune_ref().param[kernel][tune_type<T>()];
+}
+
+template<typename T>
+inline void tune_set(const int kernel, const tune_params& tp)
+{
+  tune_ref().param[kernel][tune_type<T>()] = tp;
+}
+
+//---------------------------------------------------------------------------
+// tune_load -- read a profile into a table. Returns the number of
+//   parameter lines read, or -1 if there is no such file
+//---------------------------------------------------------------------------
+inline int tune_load(tune_table& table, const char* path)
+{
+  FILE* fptr = fopen(path,"r");
+  if (fptr == NULL) {return -1;}
+  char line[256];
+  int nread = 0;
+  int lnum = 0;
+  while (fgets(line,sizeof(line),fptr) != NULL)
+  {
+    lnum++;
+    if (line[0] == '#' || line[strspn(line," \t\r\n")] == '\0') {continue;}
+    char kname[32],tname[32];
+    unsigned long panel,pack,block;
+    int kernel = -1, type = -1;
+    const int nscan = sscanf(line,"%31s %31s %lu %lu %lu",kname,tname,&panel,&pack,&block);
+    if (nscan >= 1)
+    {
+      for (int k=0;k<TUNE_NKERNEL;k++) {if (strcmp(kname,tune_kernel_name(k)) == 0) {kernel = k;}}
+    }
+    //contract may leave its panel and pack to the pack buffers
+    const bool zero_ok = (kernel == TUNE_CONTRACT);
+    if (nscan != 5 || block == 0 || (!zero_ok && (panel == 0 || pack == 0)))
+    {
+      printf("WARNING libj::tune_load\n");
+      printf("%s line %d is not 'kernel type panel pack block'\n",path,lnum);
+      continue;
+    }
+    for (int t=0;t<TUNE_NTYPE;t++) {if (strcmp(tname,tune_type_name(t)) == 0) {type = t;}}
+    if (kernel == -1 || type == -1) {continue;}
+    tune_params& tp = table.param[kernel][type];
+    tp.panel = panel;
+    tp.pack = pack;
+    if      (kernel == TUNE_ZERO)     {tp.block = TUNE_ZERO_BLOCK;}
+    else if (kernel == TUNE_CONTRACT) {tp.block = TUNE_CONTRACT_BLOCK;}
+    else                              {tp.block = block;}
+    nread++;
+  }
+  fclose(fptr);
+  return nread;
+}
+
+inline int tune_load(const char* path) {return tune_load(tune_ref(),path);}
+
+//---------------------------------------------------------------------------
+// tune_save -- write every parameter, returns 0 on success
+//---------------------------------------------------------------------------
+inline int tune_save(const char* path)
+{
+  FILE* fptr = fopen(path,"w");
+  if (fptr == NULL) {return 1;}
+  const cache_params& cp = cache_blocking();
+  fprintf(fptr,"# libj tuning profile\n");
+  fprintf(fptr,"# cache (%s) L1 %zu L2 %zu L3 %zu line %zu\n",cp.source,
+          cp.L1.bytes,cp.L2.bytes,cp.L3.bytes,cp.line_bytes);
+  fprintf(fptr,"# kernel type panel pack block\n");
+  const tune_table& table = tune_ref();
+  for (int k=0;k<TUNE_NKERNEL;k++)
+  {
+    for (int t=0;t<TUNE_NTYPE;t++)
+    {
+      const tune_params& tp = table.param[k][t];
+      fprintf(fptr,"%s %s %zu %zu %zu\n",tune_kernel_name(k),tune_type_name(t),
+              tp.panel,tp.pack,tp.block);
+    }
+  }
+  fclose(fptr);
+  return 0;
+}
+
+}//end namespace
+
+#endif
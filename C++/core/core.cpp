@@ -1,8 +1,15 @@
 /*-------------------------------------------------------
   Core.cpp 
 	Class for dealing with Core memory
+	JHT, October 19, 2026 : scopes, size class free lists, thread sub-Cores
 --------------------------------------------------------*/
 #include "core.hpp"
+#include <string.h>
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+#define CORE_LINE_BYTES 64 //sub-Cores start on their own cache line
 
 /*-------------------------------------------------------
   Constructors
@@ -11,7 +18,8 @@
   const long	: n, number of elements to allocate 
 -------------------------------------------------------*/
 template<typename T>
-Core<T>::Core() : len{0}, allocated{false}, assigned{false} 
+Core<T>::Core() : len{0}, allocated{false}, assigned{false}, sub{NULL}, nsub{0},
+                   sub_len{0}
 {
 }
 template Core<double>::Core();
@@ -25,6 +33,9 @@ Core<T>::Core(const long n)
 {
   allocated = false;
   assigned = false;
+  sub = NULL;
+  nsub = 0;
+  sub_len = 0;
   allocate(n);
 }
 template Core<double>::Core(const long n);
@@ -38,6 +49,9 @@ Core<T>::Core(const long n, T* ptr)
 {
   allocated = false;
   assigned = false;
+  sub = NULL;
+  nsub = 0;
+  sub_len = 0;
   assign(n,ptr);
 }
 template Core<double>::Core(const long n, double* ptr);
@@ -78,7 +92,7 @@ void Core<T>::allocate(const long n)
   const long mm=std::numeric_limits<long>::max();
   if (!(allocated||assigned) && n >= 1 && n <= mm) 
   {
-    buf = (T*) malloc(n*sizeof(T));
+    buf = (T*) libj::mem_alloc(n*sizeof(T),MEM_KIND_CORE);
     next = buf;
     len = n;
     navbl = n;
@@ -121,8 +135,10 @@ void Core<T>::deallocate()
 {
   if (allocated)
   {
+    if (nsub > 0) {unsplit();}
+    for (int k=0;k<CORE_NCLASS;k++) {flist[k].clear();}
     next = NULL;
-    free(buf);
+    libj::mem_free(buf);
     allocated = false;
   } else {
     printf("Attempted to deallocated an unallocated Core\n");
@@ -185,6 +201,8 @@ void Core<T>::unassign()
 {
   if (assigned)
   {
+    if (nsub > 0) {unsplit();}
+    for (int k=0;k<CORE_NCLASS;k++) {flist[k].clear();}
     buf = NULL;
     next = NULL;
     len = 0;
@@ -218,6 +236,8 @@ void Core<T>::info() const
   } else {
     printf("Core is not allocated or assigned \n");
   }
+  const libj::mem_stat tot = libj::mem_stats_total();
+  printf("libj holds %ld bytes, peak %ld bytes \n",tot.live,tot.peak);
   printf("\n");
 }
 template void Core<double>::info() const;
@@ -393,3 +413,212 @@ template int Core<int>::return_free(const long n);
 template int Core<double*>::return_free(const long n);
 
 
+
+/*-------------------------------------------------------
+  rewind(T* mark)
+    - returns all elements checked out after mark, 
+      which came from mark() 
+
+  T* mark		: where to rewind to
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::rewind(T* mark)
+{
+  if (!(allocated||assigned))
+  {
+    printf("Attempted to rewind unallocated or unassigned Core \n");
+    exit(1);
+  }
+  if (mark < buf || mark > next)
+  {
+    printf("Core::rewind mark is not within the checked out elements \n");
+    exit(1);
+  }
+  navbl += (long) (next - mark);
+  next = mark;
+
+  //released elements past the mark are gone
+  for (int k=0;k<CORE_NCLASS;k++)
+  {
+    std::vector<T*>& list = flist[k];
+    size_t keep = 0;
+    for (size_t i=0;i<list.size();i++)
+    {
+      if (list[i] < mark) {list[keep++] = list[i];}
+    }
+    list.resize(keep);
+  }
+}
+template void Core<double>::rewind(double* mark);
+template void Core<float>::rewind(float* mark);
+template void Core<long>::rewind(long* mark);
+template void Core<int>::rewind(int* mark);
+template void Core<double*>::rewind(double** mark);
+
+/*-------------------------------------------------------
+  size_class(const long n)
+    - smallest k with 2^k >= n
+-------------------------------------------------------*/
+static inline int size_class(const long n)
+{
+  int k = 0;
+  while (k < CORE_NCLASS-1 && (1L << k) < n) {k++;}
+  return k;
+}
+
+/*-------------------------------------------------------
+  sized_checkout(const long n)
+    - checks out 2^k >= n elements, reusing a released 
+      section of the same size class if there is one
+
+  const long		: n, number of elements 
+-------------------------------------------------------*/
+template<typename T>
+T* Core<T>::sized_checkout(const long n)
+{
+  const int k = size_class(n);
+  if (!flist[k].empty())
+  {
+    T* ptr = flist[k].back();
+    flist[k].pop_back();
+    return ptr;
+  }
+  return checkout(1L << k);
+}
+template double* Core<double>::sized_checkout(const long n);
+template float* Core<float>::sized_checkout(const long n);
+template long* Core<long>::sized_checkout(const long n);
+template int* Core<int>::sized_checkout(const long n);
+template double** Core<double*>::sized_checkout(const long n);
+
+/*-------------------------------------------------------
+  release(T* ptr, const long n)
+    - returns a section from sized_checkout(n), in any 
+      order
+
+  T* ptr		: the section
+  const long		: n, number of elements it was checked out with
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::release(T* ptr, const long n)
+{
+  if (ptr == NULL) {return;}
+  if (ptr < buf || ptr >= next)
+  {
+    printf("Core::release of elements not checked out of this Core \n");
+    exit(1);
+  }
+  flist[size_class(n)].push_back(ptr);
+}
+template void Core<double>::release(double* ptr, const long n);
+template void Core<float>::release(float* ptr, const long n);
+template void Core<long>::release(long* ptr, const long n);
+template void Core<int>::release(int* ptr, const long n);
+template void Core<double*>::release(double** ptr, const long n);
+
+/*-------------------------------------------------------
+  split(const int nthreads)
+    - carves the free elements into nthreads sub-Cores,
+      each starting on its own cache line. Each thread of
+      an OpenMP team of nthreads zeros (and so faults in)
+      its own sub-Core, which places its pages on the NUMA
+      node of that thread under first touch
+
+  const int		: nthreads, number of sub-Cores
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::split(const int nthreads)
+{
+  if (!(allocated||assigned))
+  {
+    printf("Attempted to split unallocated or unassigned Core \n");
+    exit(1);
+  }
+  if (nsub > 0 || nthreads < 1)
+  {
+    printf("Attempted to split an already split Core, or into < 1 sub-Core \n");
+    exit(1);
+  }
+
+  //skip to a cache line, and give each sub-Core whole lines
+  const long line = (CORE_LINE_BYTES >= (long) sizeof(T)) ? CORE_LINE_BYTES/sizeof(T) : 1;
+  const long skip = ((CORE_LINE_BYTES - (long) ((uintptr_t) next % CORE_LINE_BYTES))
+                     % CORE_LINE_BYTES) / (long) sizeof(T);
+  const long per = ((navbl - skip)/nthreads/line)*line;
+  if (per < 1)
+  {
+    printf("Core::split has too few free elements for %d sub-Cores \n",nthreads);
+    exit(1);
+  }
+  sub_start = next;
+  T* base = checkout(skip + per*nthreads) + skip;
+
+  sub = new Core<T>[nthreads];
+  nsub = nthreads;
+  sub_len = per;
+  for (int t=0;t<nthreads;t++) {sub[t].assign(per,base+t*per);}
+
+  //first touch
+  #pragma omp parallel num_threads(nthreads)
+  {
+    #if defined (_OPENMP)
+    const int t0 = omp_get_thread_num();
+    const int dt = omp_get_num_threads();
+    #else
+    const int t0 = 0;
+    const int dt = 1;
+    #endif
+    for (int t=t0;t<nthreads;t+=dt) {memset((void*) sub[t].buf,0,per*sizeof(T));}
+  }
+}
+template void Core<double>::split(const int nthreads);
+template void Core<float>::split(const int nthreads);
+template void Core<long>::split(const int nthreads);
+template void Core<int>::split(const int nthreads);
+template void Core<double*>::split(const int nthreads);
+
+/*-------------------------------------------------------
+  unsplit()
+    - returns the sub-Cores, and anything checked out of
+      this Core after split, to the Core
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::unsplit()
+{
+  if (nsub == 0) {return;}
+  delete[] sub;
+  sub = NULL;
+  nsub = 0;
+  sub_len = 0;
+  rewind(sub_start);
+}
+template void Core<double>::unsplit();
+template void Core<float>::unsplit();
+template void Core<long>::unsplit();
+template void Core<int>::unsplit();
+template void Core<double*>::unsplit();
+
+/*-------------------------------------------------------
+  local()
+    - the sub-Core of the calling OpenMP thread
+-------------------------------------------------------*/
+template<typename T>
+Core<T>& Core<T>::local()
+{
+  #if defined (_OPENMP)
+  const int t = omp_get_thread_num();
+  #else
+  const int t = 0;
+  #endif
+  if (t >= nsub)
+  {
+    printf("Core::local thread %d has no sub-Core, %d were made \n",t,nsub);
+    exit(1);
+  }
+  return sub[t];
+}
+template Core<double>& Core<double>::local();
+template Core<float>& Core<float>::local();
+template Core<long>& Core<long>::local();
+template Core<int>& Core<int>::local();
+template Core<double*>& Core<double*>::local();
@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   Core.hpp 
 	JHT, December 19, 2021 : created 
+	JHT, October 19, 2026 : scopes, size class free lists, thread sub-Cores
+	JHT, October 19, 2026 : allocations through mem.hpp
 
   (CORE) memory
 
@@ -35,6 +37,40 @@
   -------------------------
   buf.take_free(n);	//removes some free data from the Core
   buf.return_free(n);	//returns some free data to the Core
+
+  SCOPES
+  -------------------------
+  {
+    Core<double>::Scope scope(buf);	//remember where buf is
+    double* A = buf.checkout(n);
+    ...
+  }					//everything since the scope is returned
+  T* mark = buf.mark();			//the same, by hand
+  buf.rewind(mark);
+
+  SIZE CLASSES
+  -------------------------
+  buf.sized_checkout(n);	//checks out the next power of two >= n 
+				//elements, reusing released ones first
+  buf.release(ptr,n);		//returns a sized_checkout, in any order
+
+  THREAD SUB-CORES
+  -------------------------
+  buf.split(nthreads);	//carves the free elements into nthreads sub-Cores,
+			//each first touched (faulted in) by its own OpenMP 
+			//thread so its pages are local to that thread
+  #pragma omp parallel
+  {
+    Core<double>& mine = buf.local();	//sub-Core of this thread
+    Core<double>::Scope scope(mine);
+    double* tmp = mine.checkout(n);
+  }
+  buf.unsplit();	//returns the sub-Cores to buf
+
+  A Core is not thread safe. Threads share one through their own 
+  sub-Cores, which do not touch each other or the parent Core.
+  Rewinding drops the released elements of a size class that were past
+  the mark.
   
 --------------------------------------------------------*/
 #ifndef CORE_HPP
@@ -44,6 +80,10 @@
 #include <cstdint> //for long
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
+#include <vector>
+#include "mem.hpp"
+
+#define CORE_NCLASS 48 //number of size classes
 
 template <typename T>
 class Core
@@ -56,8 +96,26 @@ private:
   long            ntake;			//number of taken elements
   bool        allocated;			//bool for if class is allocated
   bool         assigned;
+  std::vector<T*> flist[CORE_NCLASS];		//released elements of each size class
+  Core<T>*          sub;			//thread sub-Cores
+  int              nsub;			//number of thread sub-Cores
+  long          sub_len;			//elements of each sub-Core
+  T*          sub_start;			//next when split
 
 public:
+  //Scope : rewinds a Core to where it was at construction
+  class Scope
+  {
+  private:
+    Core<T>& core;
+    T*       start;
+  public:
+    Scope(Core<T>& c) : core(c), start(c.mark()) {}
+    ~Scope() {core.rewind(start);}
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
   //initialization/destructors
   Core();					//constructor
   Core(long n); 				//constructor and allocator
@@ -96,6 +154,21 @@ public:
   int take_free(const long n);
   int return_free(const long n);
   T* aligned_checkout(const long ALIGN, const long n); //checks out memory aligned by ALIGN bytes 
+
+  //scopes
+  inline T* mark() const {return next;}
+  void rewind(T* mark);				//returns everything past mark
+
+  //size classes
+  T* sized_checkout(const long n);		//checks out a size class >= n
+  void release(T* ptr, const long n);		//returns a sized_checkout
+
+  //thread sub-Cores
+  void split(const int nthreads);
+  void unsplit();
+  inline int nsplit() const {return nsub;}
+  inline Core<T>& local(const int thread) {return sub[thread];}
+  Core<T>& local();				//sub-Core of this OpenMP thread
   
 };
 
@@ -0,0 +1,548 @@
+/*----------------------------------------------------------------------------------
+  block_sparse.hpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : tile contractions packed and blocked
+	JHT, October 19, 2026 : KC and MC from the tuning profile
+
+  .hpp file for the jblis routines on block_sparse_tensors. Since the
+  allowed tiles of a block sparse tensor are stored contiguously, the level-1
+  routines between tensors of the same blocking act directly on the buffer,
+  and symmetry-forbidden tiles are never touched.
+
+  The routines are
+
+    zero
+    set
+    scal
+    scopy, copy
+    axpy
+    contract
+
+  contract
+  -------------------
+  Contractions are given with index strings, one character per dimension,
+  where indices that appear in both A and B but not in C are summed over
+
+    libj::contract(alpha,A,"abij",B,"ijcd",beta,C,"abcd");
+
+  performs C(abcd) = beta*C(abcd) + alpha*sum_ij A(abij)*B(ijcd).
+
+  For each allowed tile of C and each allowed tile of A that matches it, the
+  irreps of the tile of B are fixed, so only tile triples allowed by symmetry
+  are ever multiplied. Each of these is a dense tile contraction, done with
+  the jblis blocking: the tiles are matricized by tensor_matrix, packed
+  through their block_scatter_matrix into the per thread pack buffers of
+  cache_pool.hpp, and multiplied by an MR x NR microkernel (see
+  contract_tile).
+
+----------------------------------------------------------------------------------*/
+#ifndef JBLIS_BLOCK_SPARSE_HPP
+#define JBLIS_BLOCK_SPARSE_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "libjdef.h"
+#include "tensor.hpp"
+#include "tensor_matrix.hpp"
+#include "block_scatter_matrix.hpp"
+#include "block_sparse_tensor.hpp"
+#include "cache_pool.hpp"
+#include "tune.hpp"
+
+#if defined (LIBJ_OMP)
+  #include <omp.h>
+#endif
+
+#define CONTRACT_MR 8 //rows of the contraction microkernel
+#define CONTRACT_NR 4 //cols of the contraction microkernel
+
+static_assert(CONTRACT_MR == TUNE_CONTRACT_BLOCK,"TUNE_CONTRACT_BLOCK is not CONTRACT_MR");
+
+namespace libj
+{
+
+/*---------------------------------------------------------
+ * block_sparse_check
+ *
+ *  exits if X and Y do not share the same blocking
+---------------------------------------------------------*/
+template <typename T>
+inline void block_sparse_check(const char* func,
+                               const libj::block_sparse_tensor<T>& X,
+                               const libj::block_sparse_tensor<T>& Y)
+{
+  if (!libj::same_blocking(X,Y))
+  {
+    printf("ERROR libj::%s\n",func);
+    printf("block sparse tensors do not have the same blocking\n");
+    exit(1);
+  }
+}
+
+/*---------------------------------------------------------
+ * zero
+ *
+ *  Set the allowed tiles of a tensor to zero
+ *
+ * A 	-> tensor to zero
+---------------------------------------------------------*/
+template <typename T>
+void zero(libj::block_sparse_tensor<T>& A)
+{
+  T* a = A.data();
+  const long N = (long) A.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {a[i] = (T) 0;}
+}
+
+/*---------------------------------------------------------
+ * set
+ *
+ *  Set the allowed tiles of a tensor to a constant value
+ *
+ * scal -> value to set with
+ * A 	-> tensor
+---------------------------------------------------------*/
+template <typename T>
+void set(const T scal, libj::block_sparse_tensor<T>& A)
+{
+  T* a = A.data();
+  const long N = (long) A.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {a[i] = scal;}
+}
+
+/*---------------------------------------------------------
+ * scal
+ *
+ * Scale tensor by constant value
+ *
+ * s    -> value to scale with
+ * A    -> tensor
+---------------------------------------------------------*/
+template <typename T>
+void scal(const T s, libj::block_sparse_tensor<T>& A)
+{
+  T* a = A.data();
+  const long N = (long) A.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {a[i] *= s;}
+}
+
+/*---------------------------------------------------------
+ * Copy functions
+ *
+ * Copy a scaled tensor X to tensor Y, which must have the
+ * same blocking
+ *
+ * a	-> scalar for X
+ * X	-> tensor to copy from
+ * Y	-> tensor to copy to
+---------------------------------------------------------*/
+template <typename T>
+void scopy(const T a, const libj::block_sparse_tensor<T>& X,
+           libj::block_sparse_tensor<T>& Y)
+{
+  block_sparse_check("scopy",X,Y);
+  const T* x = X.data();
+  T* y = Y.data();
+  const long N = (long) X.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {y[i] = a*x[i];}
+}
+
+template <typename T>
+void copy(const libj::block_sparse_tensor<T>& X, libj::block_sparse_tensor<T>& Y)
+{
+  block_sparse_check("copy",X,Y);
+  const T* x = X.data();
+  T* y = Y.data();
+  const long N = (long) X.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {y[i] = x[i];}
+}
+
+/*---------------------------------------------------------
+ * axpy
+ *
+ * Y = a*X + Y for tensors of the same blocking
+ *
+ * a	-> scalar for X
+ * X	-> tensor to add
+ * Y	-> tensor to add to
+---------------------------------------------------------*/
+template <typename T>
+void axpy(const T a, const libj::block_sparse_tensor<T>& X,
+          libj::block_sparse_tensor<T>& Y)
+{
+  block_sparse_check("axpy",X,Y);
+  const T* x = X.data();
+  T* y = Y.data();
+  const long N = (long) X.size();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for simd
+  #endif
+  for (long i=0;i<N;i++) {y[i] += a*x[i];}
+}
+
+/*---------------------------------------------------------
+ * contract_check_dim
+ *
+ *  exits if two contracted or shared dimensions do not
+ *  have the same irrep blocking
+---------------------------------------------------------*/
+template <typename T>
+inline void contract_check_dim(const libj::block_sparse_tensor<T>& X, const size_t xdim,
+                               const libj::block_sparse_tensor<T>& Y, const size_t ydim)
+{
+  bool good = X.num_irreps(xdim) == Y.num_irreps(ydim);
+  for (size_t irrep=0;good && irrep<X.num_irreps(xdim);irrep++)
+  {
+    good = X.irrep_size(xdim,irrep) == Y.irrep_size(ydim,irrep);
+  }
+  if (!good)
+  {
+    printf("ERROR libj::contract\n");
+    printf("dimensions %zu and %zu do not have the same irrep blocking\n",
+           xdim,ydim);
+    exit(1);
+  }
+}
+
+/*---------------------------------------------------------
+ * contract_blocks
+ *
+ *  KC (rows of a packed B sliver, cols of a packed A block)
+ *  and MC (rows of a packed A block) for a contraction
+ *  over NK elements. These are from the tuning profile
+ *  (TUNE_CONTRACT), or by default so that an A and a B
+ *  sliver fit in the L1 pack buffer, and an A block in the
+ *  L2 pack buffer. Either way they are cut to what the
+ *  pack buffers hold, a B sliver in L1 and an A block in L2
+---------------------------------------------------------*/
+template <typename T>
+inline void contract_blocks(const size_t NK, size_t& KC, size_t& MC)
+{
+  const size_t L1 = libj::pack_elements<T>(CACHE_POOL_L1);
+  const size_t L2 = libj::pack_elements<T>(CACHE_POOL_L2);
+  const libj::tune_params& TP = libj::tune_get<T>(TUNE_CONTRACT);
+
+  KC = (TP.panel > 0) ? TP.panel : L1/(CONTRACT_MR+CONTRACT_NR);
+  if (KC*CONTRACT_NR > L1) {KC = L1/CONTRACT_NR;}
+  if (KC*CONTRACT_MR > L2) {KC = L2/CONTRACT_MR;}
+  KC = std::max((size_t) 1,std::min(KC,NK));
+
+  MC = (TP.pack > 0) ? TP.pack : L2/KC;
+  if (MC*KC > L2) {MC = L2/KC;}
+  MC = std::max((size_t) CONTRACT_MR,MC/CONTRACT_MR*CONTRACT_MR);
+}
+
+/*---------------------------------------------------------
+ * contract_microkernel
+ *
+ *  AB = sum_k a(:,k) b(k,:) of a packed MR x kc sliver of
+ *  A and a packed kc x NR sliver of B
+---------------------------------------------------------*/
+template <typename T>
+inline void contract_microkernel(const size_t kc, const T* a, const T* b, T* AB)
+{
+  T acc[CONTRACT_MR*CONTRACT_NR];
+  for (size_t ij=0;ij<CONTRACT_MR*CONTRACT_NR;ij++) {acc[ij] = (T) 0;}
+  for (size_t k=0;k<kc;k++)
+  {
+    const T* ak = a + k*CONTRACT_MR;
+    const T* bk = b + k*CONTRACT_NR;
+    for (size_t j=0;j<CONTRACT_NR;j++)
+    {
+      const T bkj = bk[j];
+      #pragma omp simd
+      for (size_t i=0;i<CONTRACT_MR;i++) {acc[j*CONTRACT_MR+i] += ak[i]*bkj;}
+    }
+  }
+  for (size_t ij=0;ij<CONTRACT_MR*CONTRACT_NR;ij++) {AB[ij] = acc[ij];}
+}
+
+/*---------------------------------------------------------
+ * contract_pack_A
+ *
+ *  packs rows I0..I0+MR-1, cols P0..P0+kc-1 of A into a,
+ *  as MR contiguous rows per col, zero padded past mr rows
+---------------------------------------------------------*/
+template <typename T>
+inline void contract_pack_A(const libj::block_scatter_matrix<T>& A,
+                            const size_t I0, const size_t mr,
+                            const size_t P0, const size_t kc, T* a)
+{
+  const T* base = A.data();
+  const size_t* rscat = A.row_scatter();
+  const size_t* cscat = A.col_scatter();
+  const size_t rs = A.block_stride(0,I0/CONTRACT_MR);
+  for (size_t k=0;k<kc;k++)
+  {
+    T* ak = a + k*CONTRACT_MR;
+    const T* col = base + cscat[P0+k];
+    if (rs != 0)
+    {
+      const T* src = col + rscat[I0];
+      for (size_t i=0;i<mr;i++) {ak[i] = src[i*rs];}
+    } else {
+      for (size_t i=0;i<mr;i++) {ak[i] = col[rscat[I0+i]];}
+    }
+    for (size_t i=mr;i<CONTRACT_MR;i++) {ak[i] = (T) 0;}
+  }
+}
+
+/*---------------------------------------------------------
+ * contract_pack_B
+ *
+ *  packs rows P0..P0+kc-1, cols J0..J0+NR-1 of B into b,
+ *  as NR contiguous cols per row, zero padded past nr cols.
+ *  B is blocked by KC rows
+---------------------------------------------------------*/
+template <typename T>
+inline void contract_pack_B(const libj::block_scatter_matrix<T>& B,
+                            const size_t P0, const size_t kc,
+                            const size_t J0, const size_t nr, T* b)
+{
+  const T* base = B.data();
+  const size_t* rscat = B.row_scatter();
+  const size_t* cscat = B.col_scatter();
+  const size_t rs = B.block_stride(0,B.block_id(0,P0));
+  for (size_t j=0;j<nr;j++)
+  {
+    const T* col = base + cscat[J0+j];
+    if (rs != 0)
+    {
+      const T* src = col + rscat[P0];
+      for (size_t k=0;k<kc;k++) {b[k*CONTRACT_NR+j] = src[k*rs];}
+    } else {
+      for (size_t k=0;k<kc;k++) {b[k*CONTRACT_NR+j] = col[rscat[P0+k]];}
+    }
+  }
+  for (size_t j=nr;j<CONTRACT_NR;j++)
+  {
+    for (size_t k=0;k<kc;k++) {b[k*CONTRACT_NR+j] = (T) 0;}
+  }
+}
+
+/*---------------------------------------------------------
+ * contract_tile
+ *
+ *  dense tile contraction of matricized tiles
+ *    C(I,J) += alpha * A(I,K) * B(K,J)
+ *
+ *  This is the jblis panel/pack scheme: loop over KC
+ *  panels of K, pack an MC x KC block of A into the L2
+ *  pack buffer of this thread, and for each NR wide sliver
+ *  of B, pack it into the L1 pack buffer and call the
+ *  MR x NR microkernel on each MR sliver of the A block.
+ *  C must be blocked by MR rows and NR cols, so its block
+ *  strides give the stride 1 updates.
+---------------------------------------------------------*/
+template <typename T>
+void contract_tile(const T alpha, const libj::tensor_matrix<T>& AM,
+                   const libj::tensor_matrix<T>& BM, libj::block_scatter_matrix<T>& C)
+{
+  const size_t NI = C.size(0);
+  const size_t NJ = C.size(1);
+  const size_t NK = AM.size(1);
+  size_t KC,MC;
+  contract_blocks<T>(NK,KC,MC);
+
+  const libj::block_scatter_matrix<T> A(AM,CONTRACT_MR,KC);
+  const libj::block_scatter_matrix<T> B(BM,KC,CONTRACT_NR);
+  T* a = libj::pack_buffer<T>(CACHE_POOL_L2);
+  T* b = libj::pack_buffer<T>(CACHE_POOL_L1);
+  T AB[CONTRACT_MR*CONTRACT_NR];
+
+  T* c = C.data();
+  const size_t* rscat = C.row_scatter();
+  const size_t* cscat = C.col_scatter();
+
+  for (size_t pc=0;pc<NK;pc+=KC)
+  {
+    const size_t kc = std::min(KC,NK-pc);
+    for (size_t ic=0;ic<NI;ic+=MC)
+    {
+      const size_t mc = std::min(MC,NI-ic);
+
+      //pack the A block, one MR sliver at a time
+      for (size_t ir=0;ir<mc;ir+=CONTRACT_MR)
+      {
+        contract_pack_A(A,ic+ir,std::min((size_t) CONTRACT_MR,mc-ir),pc,kc,a+ir*kc);
+      }
+
+      for (size_t jr=0;jr<NJ;jr+=CONTRACT_NR)
+      {
+        const size_t nr = std::min((size_t) CONTRACT_NR,NJ-jr);
+        contract_pack_B(B,pc,kc,jr,nr,b);
+
+        for (size_t ir=0;ir<mc;ir+=CONTRACT_MR)
+        {
+          const size_t mr = std::min((size_t) CONTRACT_MR,mc-ir);
+          contract_microkernel<T>(kc,a+ir*kc,b,AB);
+
+          //update C, with a stride when the row block has one
+          const size_t I0 = ic+ir;
+          const size_t rs = C.block_stride(0,I0/CONTRACT_MR);
+          for (size_t j=0;j<nr;j++)
+          {
+            T* cj = c + cscat[jr+j];
+            const T* abj = AB + j*CONTRACT_MR;
+            if (rs != 0)
+            {
+              T* cij = cj + rscat[I0];
+              for (size_t i=0;i<mr;i++) {cij[i*rs] += alpha*abj[i];}
+            } else {
+              for (size_t i=0;i<mr;i++) {cj[rscat[I0+i]] += alpha*abj[i];}
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------
+ * contract
+ *
+ *  C = beta*C + alpha*A*B, summing over the indices of A
+ *  and B which do not appear in C. Only symmetry allowed
+ *  tile triples are multiplied.
+ *
+ * alpha	-> scalar for A*B
+ * A, idxA	-> first tensor and its index string
+ * B, idxB	-> second tensor and its index string
+ * beta		-> scalar for C
+ * C, idxC	-> result tensor and its index string
+---------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha,
+              const libj::block_sparse_tensor<T>& A, const std::string& idxA,
+              const libj::block_sparse_tensor<T>& B, const std::string& idxB,
+              const T beta,
+              libj::block_sparse_tensor<T>& C, const std::string& idxC)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() ||
+      idxC.length() != C.dim())
+  {
+    printf("ERROR libj::contract\n");
+    printf("index strings do not match the tensor dimensions\n");
+    exit(1);
+  }
+
+  //sort the indices into the bundles of each matricized tile
+  //  A(Aext,Aint) B(Bint,Bext) C(Cl,Cr)
+  std::string Aext,Aint,Bint,Bext,Cl,Cr;
+  std::vector<size_t> cdim_a,cdim_b; //C dimensions, with their A/B dimension
+  std::vector<size_t> adim_c,bdim_c;
+  std::vector<size_t> adim_k,bdim_k; //contracted A and B dimensions
+  for (size_t cdim=0;cdim<C.dim();cdim++)
+  {
+    const size_t apos = idxA.find(idxC[cdim]);
+    const size_t bpos = idxB.find(idxC[cdim]);
+    if ((apos == std::string::npos) == (bpos == std::string::npos))
+    {
+      printf("ERROR libj::contract\n");
+      printf("index %c of C must appear in exactly one of A or B\n",idxC[cdim]);
+      exit(1);
+    }
+    if (apos != std::string::npos)
+    {
+      contract_check_dim(A,apos,C,cdim);
+      Aext.push_back((char) ('a'+apos));
+      Cl.push_back((char) ('a'+cdim));
+      cdim_a.push_back(cdim);
+      adim_c.push_back(apos);
+    } else {
+      contract_check_dim(B,bpos,C,cdim);
+      Bext.push_back((char) ('a'+bpos));
+      Cr.push_back((char) ('a'+cdim));
+      cdim_b.push_back(cdim);
+      bdim_c.push_back(bpos);
+    }
+  }
+  for (size_t adim=0;adim<A.dim();adim++)
+  {
+    if (idxC.find(idxA[adim]) != std::string::npos) {continue;}
+    const size_t bpos = idxB.find(idxA[adim]);
+    if (bpos == std::string::npos)
+    {
+      printf("ERROR libj::contract\n");
+      printf("index %c of A appears in neither B nor C\n",idxA[adim]);
+      exit(1);
+    }
+    contract_check_dim(A,adim,B,bpos);
+    Aint.push_back((char) ('a'+adim));
+    Bint.push_back((char) ('a'+bpos));
+    adim_k.push_back(adim);
+    bdim_k.push_back(bpos);
+  }
+  if (Bint.length() + Bext.length() != B.dim())
+  {
+    printf("ERROR libj::contract\n");
+    printf("some index of B appears in neither A nor C\n");
+    exit(1);
+  }
+
+  //each tile of C is owned by one thread
+  const long NTC = (long) C.num_tiles();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for schedule(dynamic)
+  #endif
+  for (long tc=0;tc<NTC;tc++)
+  {
+    const std::vector<size_t>& ckey = C.tile_key(tc);
+    libj::tensor<T>& CT = C.tile(tc);
+
+    //scale the C tile
+    T* c = CT.data();
+    const size_t NC = CT.size();
+    if (beta == (T) 0) {for (size_t i=0;i<NC;i++) {c[i] = (T) 0;}}
+    else if (beta != (T) 1) {for (size_t i=0;i<NC;i++) {c[i] *= beta;}}
+    if (alpha == (T) 0) {continue;}
+
+    libj::tensor_matrix<T> CM(CT,Cl,Cr);
+    libj::block_scatter_matrix<T> CS(CM,CONTRACT_MR,CONTRACT_NR);
+
+    std::vector<size_t> bkey(B.dim());
+    for (size_t idx=0;idx<cdim_b.size();idx++) {bkey[bdim_c[idx]] = ckey[cdim_b[idx]];}
+
+    //every allowed A tile with the external irreps of this C tile
+    for (size_t ta=0;ta<A.num_tiles();ta++)
+    {
+      const std::vector<size_t>& akey = A.tile_key(ta);
+      bool match = true;
+      for (size_t idx=0;match && idx<cdim_a.size();idx++)
+      {
+        match = akey[adim_c[idx]] == ckey[cdim_a[idx]];
+      }
+      if (!match) {continue;}
+
+      //the B tile is then fixed
+      for (size_t idx=0;idx<adim_k.size();idx++) {bkey[bdim_k[idx]] = akey[adim_k[idx]];}
+      const long tb = B.tile_id(bkey);
+      if (tb < 0) {continue;}
+
+      libj::tensor_matrix<T> AM(A.tile(ta),Aext,Aint);
+      libj::tensor_matrix<T> BM(B.tile(tb),Bint,Bext);
+      contract_tile(alpha,AM,BM,CS);
+    }
+  }
+}
+
+}//end libj
+#endif
@@ -0,0 +1,413 @@
+/*----------------------------------------------------------------------------------
+  expr.hpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : panel sizes from the detected cache
+	JHT, October 19, 2026 : panel, pack and row block sizes from the tuning profile
+
+  .hpp file for lazy elementwise tensor expressions. Sums, scalings and
+  (elementwise) products of tensors build an expression object instead of
+  computing anything, and the whole expression is then evaluated in a single
+  blocked pass, so each element of each tensor is touched once.
+
+    libj::eval(2.0*A + B*D, C);		//C = 2A + B.D
+    libj::eval_add(libj::axpy(a,X,Y), C);	//C += aX + Y
+
+  The operands may have different layouts (e.g. strided views made with
+  tensor::assign), but must have the same lengths as C. Each operand is
+  viewed as a column vector tensor_matrix, and evaluation follows the zero
+  panel/pack loop, with a block_scatter_matrix per operand reconciling the
+  layouts of each pack. Row blocks in which every operand has a constant
+  stride are evaluated with strided pointers, and if every tensor is
+  sequential the scatter vectors are skipped entirely.
+
+  Supported expressions
+  -------------------
+    s*E, E*s	scale
+    E1 + E2	add
+    E1 - E2	subtract
+    E1 * E2	elementwise multiply
+    axpy(a,X,Y)	a*X + Y
+
+  where E is a libj::tensor or another expression
+
+----------------------------------------------------------------------------------*/
+#ifndef JBLIS_EXPR_HPP
+#define JBLIS_EXPR_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <type_traits>
+#include "libjdef.h"
+#include "cache.hpp"
+#include "tensor.hpp"
+#include "tensor_matrix.hpp"
+#include "block_scatter_matrix.hpp"
+
+#if defined (LIBJ_OMP)
+  #include <omp.h>
+#endif
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// expr_base
+//	tag for expression types, CRTP
+//------------------------------------------------------------------------
+template <class E>
+struct expr_base
+{
+  const E& self() const {return static_cast<const E&>(*this);}
+};
+
+//------------------------------------------------------------------------
+// expr_leaf
+//	a tensor operand, accessed through a block scatter matrix of the
+//	current pack
+//------------------------------------------------------------------------
+template <typename T>
+class expr_leaf : public expr_base<expr_leaf<T>>
+{
+  private:
+  const libj::tensor<T>*            M_TENSOR;  //the operand
+  libj::tensor_matrix<T>            M_MATRIX;  //column vector representation
+  libj::block_scatter_matrix<T>     M_BLOCK;   //current pack
+  const T*                          M_PTR;     //current row block
+  size_t                            M_STRIDE;  //stride of current row block
+
+  public:
+  typedef T value_type;
+
+  expr_leaf(const libj::tensor<T>& A)
+    : M_TENSOR(&A), M_MATRIX(A,"",""), M_PTR(NULL), M_STRIDE(0) {}
+
+  //all tensors must have the lengths of the result
+  bool same_lengths(const libj::tensor<T>& C) const
+  {
+    if (M_TENSOR->dim() != C.dim()) {return false;}
+    for (size_t dim=0;dim<C.dim();dim++)
+    {
+      if (M_TENSOR->size(dim) != C.size(dim)) {return false;}
+    }
+    return true;
+  }
+  bool sequential() const {return M_TENSOR->is_sequential();}
+
+  //flat access, for sequential tensors
+  T flat(const size_t I) const {return M_TENSOR->data()[I];}
+
+  //pack access
+  void bind(const size_t start, const size_t len, const size_t block)
+  {
+    M_BLOCK.assign_to_block(M_MATRIX,start,0,len,1,block,1);
+  }
+  bool strided(const size_t block) const {return M_BLOCK.block_stride(0,block) > 0;}
+  void set_block(const size_t row, const size_t block)
+  {
+    M_PTR = &M_BLOCK(row,0);
+    M_STRIDE = M_BLOCK.block_stride(0,block);
+  }
+  T strided_at(const size_t r) const {return M_PTR[r*M_STRIDE];}
+  T scatter_at(const size_t row) const {return M_BLOCK(row,0);}
+};
+
+//------------------------------------------------------------------------
+// expr_scale
+//------------------------------------------------------------------------
+template <class E>
+class expr_scale : public expr_base<expr_scale<E>>
+{
+  public:
+  typedef typename E::value_type value_type;
+
+  private:
+  value_type M_S;
+  E          M_E;
+
+  public:
+  expr_scale(const value_type s, const E& e) : M_S(s), M_E(e) {}
+
+  bool same_lengths(const libj::tensor<value_type>& C) const {return M_E.same_lengths(C);}
+  bool sequential() const {return M_E.sequential();}
+  value_type flat(const size_t I) const {return M_S*M_E.flat(I);}
+  void bind(const size_t start, const size_t len, const size_t block) {M_E.bind(start,len,block);}
+  bool strided(const size_t block) const {return M_E.strided(block);}
+  void set_block(const size_t row, const size_t block) {M_E.set_block(row,block);}
+  value_type strided_at(const size_t r) const {return M_S*M_E.strided_at(r);}
+  value_type scatter_at(const size_t row) const {return M_S*M_E.scatter_at(row);}
+};
+
+//------------------------------------------------------------------------
+// expr_binary
+//	elementwise binary operations, OP is one of the structs below
+//------------------------------------------------------------------------
+struct expr_op_add {template <typename T> static T apply(const T a, const T b) {return a+b;}};
+struct expr_op_sub {template <typename T> static T apply(const T a, const T b) {return a-b;}};
+struct expr_op_mul {template <typename T> static T apply(const T a, const T b) {return a*b;}};
+
+template <class OP, class E1, class E2>
+class expr_binary : public expr_base<expr_binary<OP,E1,E2>>
+{
+  public:
+  typedef typename E1::value_type value_type;
+  static_assert(std::is_same<value_type,typename E2::value_type>::value,
+                "libj expressions must have operands of the same type");
+
+  private:
+  E1 M_E1;
+  E2 M_E2;
+
+  public:
+  expr_binary(const E1& e1, const E2& e2) : M_E1(e1), M_E2(e2) {}
+
+  bool same_lengths(const libj::tensor<value_type>& C) const
+  {
+    return M_E1.same_lengths(C) && M_E2.same_lengths(C);
+  }
+  bool sequential() const {return M_E1.sequential() && M_E2.sequential();}
+  value_type flat(const size_t I) const {return OP::apply(M_E1.flat(I),M_E2.flat(I));}
+  void bind(const size_t start, const size_t len, const size_t block)
+  {
+    M_E1.bind(start,len,block);
+    M_E2.bind(start,len,block);
+  }
+  bool strided(const size_t block) const {return M_E1.strided(block) && M_E2.strided(block);}
+  void set_block(const size_t row, const size_t block)
+  {
+    M_E1.set_block(row,block);
+    M_E2.set_block(row,block);
+  }
+  value_type strided_at(const size_t r) const
+  {
+    return OP::apply(M_E1.strided_at(r),M_E2.strided_at(r));
+  }
+  value_type scatter_at(const size_t row) const
+  {
+    return OP::apply(M_E1.scatter_at(row),M_E2.scatter_at(row));
+  }
+};
+
+//------------------------------------------------------------------------
+// expr_traits
+//	converts tensors and expressions to expression nodes
+//------------------------------------------------------------------------
+template <class X, class Enable=void>
+struct expr_traits {static constexpr bool is_operand = false;};
+
+template <typename T>
+struct expr_traits<libj::tensor<T>>
+{
+  static constexpr bool is_operand = true;
+  typedef expr_leaf<T> type;
+  static type make(const libj::tensor<T>& A) {return type(A);}
+};
+
+template <class E>
+struct expr_traits<E,typename std::enable_if<std::is_base_of<expr_base<E>,E>::value>::type>
+{
+  static constexpr bool is_operand = true;
+  typedef E type;
+  static const E& make(const E& e) {return e;}
+};
+
+//------------------------------------------------------------------------
+// operators
+//------------------------------------------------------------------------
+template <class X, class Y>
+typename std::enable_if<expr_traits<X>::is_operand && expr_traits<Y>::is_operand,
+         expr_binary<expr_op_add,typename expr_traits<X>::type,typename expr_traits<Y>::type>>::type
+operator+ (const X& x, const Y& y)
+{
+  return expr_binary<expr_op_add,typename expr_traits<X>::type,typename expr_traits<Y>::type>
+         (expr_traits<X>::make(x),expr_traits<Y>::make(y));
+}
+
+template <class X, class Y>
+typename std::enable_if<expr_traits<X>::is_operand && expr_traits<Y>::is_operand,
+         expr_binary<expr_op_sub,typename expr_traits<X>::type,typename expr_traits<Y>::type>>::type
+operator- (const X& x, const Y& y)
+{
+  return expr_binary<expr_op_sub,typename expr_traits<X>::type,typename expr_traits<Y>::type>
+         (expr_traits<X>::make(x),expr_traits<Y>::make(y));
+}
+
+template <class X, class Y>
+typename std::enable_if<expr_traits<X>::is_operand && expr_traits<Y>::is_operand,
+         expr_binary<expr_op_mul,typename expr_traits<X>::type,typename expr_traits<Y>::type>>::type
+operator* (const X& x, const Y& y)
+{
+  return expr_binary<expr_op_mul,typename expr_traits<X>::type,typename expr_traits<Y>::type>
+         (expr_traits<X>::make(x),expr_traits<Y>::make(y));
+}
+
+template <typename S, class X>
+typename std::enable_if<std::is_arithmetic<S>::value && expr_traits<X>::is_operand,
+         expr_scale<typename expr_traits<X>::type>>::type
+operator* (const S s, const X& x)
+{
+  typedef typename expr_traits<X>::type E;
+  return expr_scale<E>((typename E::value_type) s,expr_traits<X>::make(x));
+}
+
+template <typename S, class X>
+typename std::enable_if<std::is_arithmetic<S>::value && expr_traits<X>::is_operand,
+         expr_scale<typename expr_traits<X>::type>>::type
+operator* (const X& x, const S s)
+{
+  return s*x;
+}
+
+/*---------------------------------------------------------
+ * axpy
+ *
+ *  returns the expression a*X + Y
+---------------------------------------------------------*/
+template <typename S, class X, class Y>
+auto axpy(const S a, const X& x, const Y& y) -> decltype(a*x + y)
+{
+  return a*x + y;
+}
+
+/*---------------------------------------------------------
+ * expr_check
+ *
+ *  exits if the expression does not match the result
+---------------------------------------------------------*/
+template <class E>
+inline void expr_check(const char* func, const E& e,
+                       const libj::tensor<typename E::value_type>& C)
+{
+  if (!e.same_lengths(C))
+  {
+    printf("ERROR libj::%s\n",func);
+    printf("expression operands do not have the lengths of the result\n");
+    exit(1);
+  }
+}
+
+/*---------------------------------------------------------
+ * expr_pack_kernel
+ *
+ *  evaluates one pack of an expression into C, with C = e
+ *  if ADD is false and C += e if true. Row blocks where
+ *  every operand is strided use pointers, others the
+ *  scatter vectors
+---------------------------------------------------------*/
+template <bool ADD, class E, class BSM>
+inline void expr_pack_kernel(const size_t LEN, E& e, BSM& CB)
+{
+  typedef typename E::value_type T;
+  const size_t NB = CB.block_num(0);
+  const size_t BS = CB.block_size(0);
+  size_t row = 0;
+  for (size_t block=0;block<NB;block++)
+  {
+    const size_t NR = std::min(BS,LEN-row);
+    const size_t cstride = CB.block_stride(0,block);
+    if (cstride > 0 && e.strided(block))
+    {
+      e.set_block(row,block);
+      T* c = &CB(row,0);
+      if (ADD) {for (size_t r=0;r<NR;r++) {c[r*cstride] += e.strided_at(r);}}
+      else     {for (size_t r=0;r<NR;r++) {c[r*cstride]  = e.strided_at(r);}}
+    } else {
+      if (ADD) {for (size_t r=row;r<row+NR;r++) {CB(r,0) += e.scatter_at(r);}}
+      else     {for (size_t r=row;r<row+NR;r++) {CB(r,0)  = e.scatter_at(r);}}
+    }
+    row += NR;
+  }
+}
+
+/*---------------------------------------------------------
+ * expr_eval
+ *
+ *  the panel/pack loop shared by eval and eval_add
+---------------------------------------------------------*/
+template <bool ADD, class E>
+void expr_eval(const E& expr, libj::tensor<typename E::value_type>& C)
+{
+  typedef typename E::value_type T;
+  const size_t end = C.size();
+  const libj::tune_params& TP = libj::tune_get<T>(TUNE_EXPR);
+  const size_t PANEL_SIZE = TP.panel;
+  const size_t PACK_SIZE  = TP.pack;
+  const size_t BLOCK_SIZE = TP.block;
+
+  //everything is sequential, no scatter vectors needed
+  if (C.is_sequential() && expr.sequential())
+  {
+    T* c = C.data();
+    #if defined (LIBJ_OMP)
+    #pragma omp parallel for schedule(static)
+    #endif
+    for (size_t panel_start = 0; panel_start < end; panel_start += PANEL_SIZE)
+    {
+      const size_t panel_end = std::min(end,panel_start+PANEL_SIZE);
+      if (ADD) {for (size_t I=panel_start;I<panel_end;I++) {c[I] += expr.flat(I);}}
+      else     {for (size_t I=panel_start;I<panel_end;I++) {c[I]  = expr.flat(I);}}
+    }
+    return;
+  }
+
+  libj::tensor_matrix<T> C_MATRIX(C,"","");
+
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel
+  #endif
+  {
+    E e(expr); //each thread binds its own packs
+    libj::block_scatter_matrix<T> C_BLOCKED;
+
+    #if defined (LIBJ_OMP)
+    #pragma omp for schedule(static)
+    #endif
+    for (size_t panel_start = 0; panel_start < end; panel_start += PANEL_SIZE)
+    {
+      const size_t panel_end = std::min(end,panel_start+PANEL_SIZE);
+      for (size_t pack_start = panel_start; pack_start < panel_end;
+           pack_start += PACK_SIZE)
+      {
+        const size_t pack_len = std::min(panel_end-pack_start,PACK_SIZE);
+        C_BLOCKED.assign_to_block(C_MATRIX,pack_start,0,pack_len,1,
+                                  BLOCK_SIZE,1);
+        e.bind(pack_start,pack_len,BLOCK_SIZE);
+        expr_pack_kernel<ADD>(pack_len,e,C_BLOCKED);
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------
+ * eval
+ *
+ *  C = expr
+ *
+ *  Operands may be C itself only if they are read in the
+ *  same layout as C is written
+---------------------------------------------------------*/
+template <class X>
+typename std::enable_if<expr_traits<X>::is_operand>::type
+eval(const X& x, libj::tensor<typename expr_traits<X>::type::value_type>& C)
+{
+  const typename expr_traits<X>::type& e = expr_traits<X>::make(x);
+  expr_check("eval",e,C);
+  expr_eval<false>(e,C);
+}
+
+/*---------------------------------------------------------
+ * eval_add
+ *
+ *  C += expr
+---------------------------------------------------------*/
+template <class X>
+typename std::enable_if<expr_traits<X>::is_operand>::type
+eval_add(const X& x, libj::tensor<typename expr_traits<X>::type::value_type>& C)
+{
+  const typename expr_traits<X>::type& e = expr_traits<X>::make(x);
+  expr_check("eval_add",e,C);
+  expr_eval<true>(e,C);
+}
+
+}//end libj
+#endif
@@ -1 +1,3 @@
 #include "jblis_level1.hpp"
+#include "block_sparse.hpp"
+#include "expr.hpp"
@@ -1,7 +1,7 @@
 #include "zero2.hpp"
 #include "tensor.hpp"
-#include "tensor_matrix2.hpp"
-#include "block_scatter_matrix2.hpp"
+#include "tensor_matrix.hpp"
+#include "block_scatter_matrix.hpp"
 #include <stdio.h>
 
 int main()
@@ -0,0 +1,241 @@
+/*----------------------------------------------------------------------
+  zero_kernel.hpp
+	JHT, October 19, 2026 : created, split out of zero.cpp and zero2.hpp
+	JHT, October 19, 2026 : the panel loop is shared too, and skips the
+	                        scatter of packs with a cached row stride
+
+  .hpp file for the kernels of the zero function. These are templated
+  on the block scatter matrix type, so the same kernels (and the same
+  panel/pack loop, zero_panels) are used by the dynamic (zero) and fixed
+  rank (zero2) drivers.
+
+----------------------------------------------------------------------*/
+#ifndef JBLIS_ZERO_KERNEL_HPP
+#define JBLIS_ZERO_KERNEL_HPP
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "jblis_level1.hpp"
+#include "scatter_cache.hpp"
+
+//Note that the block size is the same as the microkernel size, here
+#define ROW_BLOCK_SIZE 16
+#define COL_BLOCK_SIZE 1
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  zero_microkernel_stride1
+	special code for if the row stride of the current block is zero
+----------------------------------------------------------------------*/
+template <typename T>
+inline void zero_microkernel_stride1(T* A)
+{
+  A[0] = (T) 0;
+  A[1] = (T) 0;
+  A[2] = (T) 0;
+  A[3] = (T) 0;
+  A[4] = (T) 0;
+  A[5] = (T) 0;
+  A[6] = (T) 0;
+  A[7] = (T) 0;
+
+  A[8] = (T) 0;
+  A[9] = (T) 0;
+  A[10] = (T) 0;
+  A[11] = (T) 0;
+  A[12] = (T) 0;
+  A[13] = (T) 0;
+  A[14] = (T) 0;
+  A[15] = (T) 0;
+
+}
+
+/*----------------------------------------------------------------------
+  zero_microkernel_stride1
+	special code for doubles with stride 1
+----------------------------------------------------------------------*/
+#if defined LIBJ_AVX
+template<>
+inline void zero_microkernel_stride1(double* A)
+{
+  const __m256d a_0_3   = _mm256_setzero_pd();
+  const __m256d a_4_7   = _mm256_setzero_pd();
+  const __m256d a_8_11  = _mm256_setzero_pd();
+  const __m256d a_12_15 = _mm256_setzero_pd();
+  _mm256_storeu_pd(A+0,a_0_3);
+  _mm256_storeu_pd(A+4,a_4_7);
+  _mm256_storeu_pd(A+8,a_8_11);
+  _mm256_storeu_pd(A+12,a_12_15);
+}
+#endif
+
+/*----------------------------------------------------------------------
+  zero_microkernel_strideg
+	special code for constant stride blocks
+----------------------------------------------------------------------*/
+template <typename T>
+inline void zero_microkernel_strideg(T* A, const size_t stride)
+{
+  A[0*stride] = (T) 0;
+  A[1*stride] = (T) 0;
+  A[2*stride] = (T) 0;
+  A[3*stride] = (T) 0;
+  A[4*stride] = (T) 0;
+  A[5*stride] = (T) 0;
+  A[6*stride] = (T) 0;
+  A[7*stride] = (T) 0;
+  A[8*stride] = (T) 0;
+  A[9*stride] = (T) 0;
+  A[10*stride] = (T) 0;
+  A[11*stride] = (T) 0;
+  A[12*stride] = (T) 0;
+  A[13*stride] = (T) 0;
+  A[14*stride] = (T) 0;
+  A[15*stride] = (T) 0;
+}
+
+/*----------------------------------------------------------------------
+  zero_inner_kernel
+	takes in block scatter matrix, loops through cols and row
+        blocks, sets the values to zero via microkernel calls
+----------------------------------------------------------------------*/
+template <typename T, class BSM>
+inline void zero_inner_kernel(const size_t START, const size_t LEN, BSM& BLOCK)
+{
+  const size_t block_size = BLOCK.block_size(0);
+
+  //cleanup the first row block
+  size_t row = START;
+  for (; row < std::min(BLOCK.next_block_index(0,START),START+LEN-1); row++)
+  {
+    BLOCK(row,0) = (T) 0;
+  }
+
+  //general row blocks in between
+  const size_t start_row_block = BLOCK.block_id(0,START);
+  const size_t   end_row_block = BLOCK.block_id(0,START+LEN);
+  for (size_t row_block = start_row_block+1; row_block < end_row_block; row_block++)
+  {
+    const size_t  block_stride = BLOCK.block_stride(0,row_block);
+    if (block_stride == 1)     {zero_microkernel_stride1<T>(&BLOCK(row,0));}
+    else if (block_stride > 0) {zero_microkernel_strideg<T>(&BLOCK(row,0),
+                                                            block_stride);}
+    else {
+      for (size_t sub_row = row; sub_row < row + BLOCK.block_size(0); sub_row++) {
+        BLOCK(sub_row,0) = (T) 0;
+      }
+    }
+    row += block_size;
+  }
+
+  //cleanup the last row block
+  for (; row < START+LEN ; row++)
+  {
+    BLOCK(row,0) = (T) 0;
+  }
+
+}
+
+/*----------------------------------------------------------------------
+  zero_strided
+	zeros LEN elements of A spaced by stride, for packs whose rows
+	are evenly spaced, without a scatter vector
+----------------------------------------------------------------------*/
+template <typename T>
+inline void zero_strided(T* A, const size_t stride, const size_t LEN)
+{
+  size_t row = 0;
+  if (stride == 1)
+  {
+    for (; row + ROW_BLOCK_SIZE <= LEN; row += ROW_BLOCK_SIZE)
+    {
+      zero_microkernel_stride1<T>(A+row);
+    }
+  } else {
+    for (; row + ROW_BLOCK_SIZE <= LEN; row += ROW_BLOCK_SIZE)
+    {
+      zero_microkernel_strideg<T>(A+row*stride,stride);
+    }
+  }
+  for (; row < LEN; row++) {A[row*stride] = (T) 0;}
+}
+
+/*----------------------------------------------------------------------
+  zero_panels
+	the panel/pack loop of zero, on the col-vector tensor matrix
+	A_MATRIX of A. BSM is the block scatter matrix each thread builds
+	its packs in, and PACK_MAX the most rows it holds.
+
+	The first time a shape is seen every pack is built, and the row
+	stride of each is recorded in the scatter_cache. After that, packs
+	with a stride are zeroed directly, and only the uneven ones are
+	built.
+----------------------------------------------------------------------*/
+template <typename T, class BSM, class TM>
+void zero_panels(libj::tensor<T>& A, TM& A_MATRIX, const size_t PACK_MAX)
+{
+  //Get parameters
+  const libj::tune_params& TP = libj::tune_get<T>(TUNE_ZERO);
+  const size_t PANEL_SIZE = TP.panel;
+  const size_t PACK_SIZE  = std::min(std::min(TP.pack,PANEL_SIZE),PACK_MAX);
+  const size_t NPACK = (PANEL_SIZE + PACK_SIZE - 1)/PACK_SIZE; //per panel
+
+  //Loops
+  const size_t start = 0;
+  const size_t end   = A_MATRIX.size();
+
+  //pack strides of this shape, or record them
+  std::shared_ptr<const libj::scatter_entry> known =
+    libj::scatter_cache::find(A,PANEL_SIZE,PACK_SIZE);
+  std::vector<size_t> strides;
+  if (!known) {strides.resize(NPACK*((end + PANEL_SIZE - 1)/PANEL_SIZE));}
+  const size_t* known_stride = known ? known->STRIDE.data() : NULL;
+  size_t* new_stride = strides.data();
+
+  #pragma omp parallel shared(A_MATRIX)
+  {
+    BSM A_BLOCKED;
+
+    #pragma omp for schedule(static)
+    for (size_t panel_start = start; panel_start < end; panel_start += PANEL_SIZE)
+    {
+      const size_t panel_len = std::min(end-panel_start,PANEL_SIZE);
+      const size_t panel_end = panel_start + panel_len;
+      size_t pack = (panel_start/PANEL_SIZE)*NPACK;
+
+      //loop over L1 packs of BA
+      for (size_t pack_start = panel_start; pack_start < panel_end;
+           pack_start += PACK_SIZE, pack++)
+      {
+        const size_t pack_len = std::min(panel_end-pack_start,PACK_SIZE);
+
+        //evenly spaced rows, seen before
+        if (known_stride != NULL && known_stride[pack] > 0)
+        {
+          zero_strided<T>(&A_MATRIX(pack_start,0),known_stride[pack],pack_len);
+          continue;
+        }
+
+        //construct blocked scatter matrix for this pack
+        A_BLOCKED.assign_to_block(A_MATRIX,pack_start,0,pack_len,1,
+                                  ROW_BLOCK_SIZE,COL_BLOCK_SIZE);
+        if (known_stride == NULL)
+        {
+          new_stride[pack] = libj::scatter_cache::pack_stride(A_BLOCKED);
+        }
+
+        //call inner kernel on pack
+        zero_inner_kernel<T>(0,pack_len,A_BLOCKED);
+      }
+    }
+  }
+
+  if (!known) {libj::scatter_cache::insert(A,PANEL_SIZE,PACK_SIZE,strides);}
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,294 @@
+/*----------------------------------------------------------------------
+  jblis_tune.cpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : expr packs and blocks, and contractions
+
+  Tuner for the blocking parameters of the jblis kernels (see
+  cache/tune.hpp). For each kernel and type the fastest candidates are
+  written to a tuning profile, which libj reads the first time a kernel
+  runs.
+
+    zero	: panels with the default pack, then packs with the best panel
+    expr	: panels on dense tensors, which take the flat path, then
+		  packs and row blocks on strided views, which are blocked
+    contract	: KC, then MC with the best KC, of a dense matrix product
+		  through libj::contract. MR and NR are compile time
+		  (CONTRACT_MR, CONTRACT_NR) and are not tuned
+
+  Usage
+    jblis_tune.exe [-o profile] [-m MiB] [-r reps]
+
+    -o	profile to write, default $LIBJ_TUNE_PROFILE, or $HOME/.libj_tune
+    -m	MiB of each tensor timed, default 64
+    -r	repetitions of each timing, the best is kept, default 5
+
+  Run it with the OMP_NUM_THREADS and placement the jobs will use.
+  contract is tuned for double and float, and the integer types keep
+  their defaults.
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+#include "jblis.hpp"
+#include "block_sparse_tensor.hpp"
+#include "tune.hpp"
+#include "timer.hpp"
+
+//multiples of the default panel that are tried
+static const double PANEL_SCALE[] = {0.25,0.5,1.0,2.0,4.0};
+static const int NPANEL = 5;
+
+//fractions of the panel tried as zero packs
+static const double ZERO_PACK_SCALE[] = {0.125,0.25,0.5,1.0};
+static const int NZERO_PACK = 4;
+
+//multiples of the default tried as expr packs, and expr row blocks
+static const double EXPR_PACK_SCALE[] = {0.25,0.5,1.0,2.0,4.0};
+static const int NEXPR_PACK = 5;
+static const size_t EXPR_BLOCK[] = {4,8,16,32,64};
+static const int NEXPR_BLOCK = 5;
+
+//multiples of the buffer sized KC and MC that are tried for contract
+static const double CONTRACT_SCALE[] = {0.25,0.5,1.0,2.0,4.0};
+static const int NCONTRACT = 5;
+
+/*----------------------------------------------------------------------
+  time_kernel -- best time of reps calls of a kernel with parameters tp
+----------------------------------------------------------------------*/
+template <typename T>
+double time_kernel(const int kernel, const libj::tune_params& tp, const int reps,
+                   libj::tensor<T>& A, libj::tensor<T>& B, libj::tensor<T>& C)
+{
+  libj::tune_set<T>(kernel,tp);
+  double best = 1.e300;
+  for (int r=0;r<reps;r++)
+  {
+    Timer timer;
+    if (kernel == TUNE_ZERO) {libj::zero<T>(C);}
+    else {libj::eval((T) 2*A + B,C);}
+    const double t = timer.elapsed();
+    if (t < best) {best = t;}
+  }
+  return best;
+}
+
+/*----------------------------------------------------------------------
+  time_contract -- best time of reps products C = A*B with parameters tp
+----------------------------------------------------------------------*/
+template <typename T>
+double time_contract(const libj::tune_params& tp, const int reps,
+                     libj::block_sparse_tensor<T>& A, libj::block_sparse_tensor<T>& B,
+                     libj::block_sparse_tensor<T>& C)
+{
+  libj::tune_set<T>(TUNE_CONTRACT,tp);
+  double best = 1.e300;
+  for (int r=0;r<reps;r++)
+  {
+    Timer timer;
+    libj::contract((T) 1,A,"ik",B,"kj",(T) 0,C,"ij");
+    const double t = timer.elapsed();
+    if (t < best) {best = t;}
+  }
+  return best;
+}
+
+/*----------------------------------------------------------------------
+  tune_contract -- the best KC and MC for type T, of an n x n product
+    sized so that the three matrices hold bytes
+----------------------------------------------------------------------*/
+template <typename T>
+libj::tune_params tune_contract(const size_t bytes, const int reps)
+{
+  size_t n = 64;
+  while (3*(2*n)*(2*n)*sizeof(T) <= bytes && n < 2048) {n *= 2;}
+  const std::vector<std::vector<size_t>> irreps = {{n},{n}};
+  libj::block_sparse_tensor<T> A(irreps,0),B(irreps,0),C(irreps,0);
+  for (size_t i=0;i<A.size();i++) {A.data()[i] = (T) (i % 7); B.data()[i] = (T) (i % 5);}
+
+  //the buffer sized KC and MC are the base of the candidates
+  libj::tune_params tp = libj::tune_default(TUNE_CONTRACT,libj::tune_type<T>());
+  libj::tune_set<T>(TUNE_CONTRACT,tp);
+  size_t KC,MC;
+  libj::contract_blocks<T>(n,KC,MC);
+
+  libj::tune_params best = tp;
+  double best_time = time_contract<T>(tp,reps,A,B,C);
+
+  //KC, with MC sized to the buffer
+  for (int p=0;p<NCONTRACT;p++)
+  {
+    tp.panel = (size_t) (CONTRACT_SCALE[p]*KC);
+    tp.pack = 0;
+    if (tp.panel < 1) {continue;}
+    const double t = time_contract<T>(tp,reps,A,B,C);
+    if (t < best_time) {best_time = t; best = tp;}
+  }
+
+  //MC, with the best KC
+  tp = best;
+  for (int p=0;p<NCONTRACT;p++)
+  {
+    tp.pack = (size_t) (CONTRACT_SCALE[p]*MC);
+    if (tp.pack < CONTRACT_MR) {continue;}
+    const double t = time_contract<T>(tp,reps,A,B,C);
+    if (t < best_time) {best_time = t; best = tp;}
+  }
+
+  //what the profile asks for, and what the buffers allow
+  libj::tune_set<T>(TUNE_CONTRACT,best);
+  libj::contract_blocks<T>(n,KC,MC);
+  printf("%-8s %-7s KC %6zu MC %6zu MR %3zu (used KC %zu MC %zu) : %8.3f GFLOP/s\n",
+         libj::tune_kernel_name(TUNE_CONTRACT),libj::tune_type_name(libj::tune_type<T>()),
+         best.panel,best.pack,best.block,KC,MC,2.0*n*n*n/best_time*1.e-9);
+  return best;
+}
+
+/*----------------------------------------------------------------------
+  tune -- the best parameters of a kernel for type T
+----------------------------------------------------------------------*/
+template <typename T>
+libj::tune_params tune(const int kernel, const size_t bytes, const int reps)
+{
+  const size_t n = bytes/sizeof(T);
+  libj::tensor<T> A(n),B(n),C(n);
+  for (size_t i=0;i<n;i++) {A[i] = (T) (i % 7); B[i] = (T) (i % 5); C[i] = (T) 1;}
+
+  const libj::tune_params def = libj::tune_default(kernel,libj::tune_type<T>());
+  libj::tune_params best = def;
+  double best_time = time_kernel<T>(kernel,def,reps,A,B,C);
+
+  //panels, with the default pack
+  libj::tune_params tp = def;
+  for (int p=0;p<NPANEL;p++)
+  {
+    tp.panel = (size_t) (PANEL_SCALE[p]*def.panel);
+    if (tp.panel < tp.block) {continue;}
+    tp.pack = (kernel == TUNE_ZERO) ? tp.panel/2 : def.pack;
+    const double t = time_kernel<T>(kernel,tp,reps,A,B,C);
+    if (t < best_time) {best_time = t; best = tp;}
+  }
+
+  //packs, with the best panel
+  if (kernel == TUNE_ZERO)
+  {
+    tp = best;
+    for (int p=0;p<NZERO_PACK;p++)
+    {
+      tp.pack = (size_t) (ZERO_PACK_SCALE[p]*best.panel);
+      if (tp.pack < tp.block) {continue;}
+      const double t = time_kernel<T>(kernel,tp,reps,A,B,C);
+      if (t < best_time) {best_time = t; best = tp;}
+    }
+  }
+
+  //packs and row blocks of expr, on every other element of the tensors,
+  //  which are blocked rather than flat
+  if (kernel == TUNE_EXPR)
+  {
+    const size_t h = n/2;
+    libj::tensor<T> AS,BS,CS;
+    AS.assign(A.data(),{h},{2});
+    BS.assign(B.data(),{h},{2});
+    CS.assign(C.data(),{h},{2});
+    tp = best;
+    double strided_best = time_kernel<T>(kernel,tp,reps,AS,BS,CS);
+    const libj::tune_params panel_best = best;
+    for (int p=0;p<NEXPR_PACK;p++)
+    {
+      tp.pack = (size_t) (EXPR_PACK_SCALE[p]*def.pack);
+      if (tp.pack < 1 || tp.pack > panel_best.panel) {continue;}
+      const double t = time_kernel<T>(kernel,tp,reps,AS,BS,CS);
+      if (t < strided_best) {strided_best = t; best = tp;}
+    }
+    tp = best;
+    for (int b=0;b<NEXPR_BLOCK;b++)
+    {
+      tp.block = EXPR_BLOCK[b];
+      if (tp.block > tp.pack) {continue;}
+      const double t = time_kernel<T>(kernel,tp,reps,AS,BS,CS);
+      if (t < strided_best) {strided_best = t; best = tp;}
+    }
+    printf("%-8s %-7s strided pack %6zu block %3zu : %8.3f GB/s\n",
+           libj::tune_kernel_name(kernel),libj::tune_type_name(libj::tune_type<T>()),
+           best.pack,best.block,3.0*h*sizeof(T)/strided_best*1.e-9);
+  }
+
+  printf("%-8s %-7s panel %9zu pack %9zu block %3zu : %8.3f GB/s\n",
+         libj::tune_kernel_name(kernel),libj::tune_type_name(libj::tune_type<T>()),
+         best.panel,best.pack,best.block,
+         (kernel == TUNE_ZERO ? 1.0 : 3.0)*n*sizeof(T)/best_time*1.e-9);
+  libj::tune_set<T>(kernel,best);
+  return best;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t mib = 64;
+  int reps = 5;
+  const char* path = getenv("LIBJ_TUNE_PROFILE");
+  std::vector<char> home_path;
+  for (int i=1;i<argc;i++)
+  {
+    if (strcmp(argv[i],"-o") == 0 && i+1 < argc) {path = argv[++i];}
+    else if (strcmp(argv[i],"-m") == 0 && i+1 < argc) {mib = (size_t) atol(argv[++i]);}
+    else if (strcmp(argv[i],"-r") == 0 && i+1 < argc) {reps = atoi(argv[++i]);}
+    else
+    {
+      printf("usage: %s [-o profile] [-m MiB] [-r reps]\n",argv[0]);
+      return 1;
+    }
+  }
+  if (path == NULL)
+  {
+    const char* home = getenv("HOME");
+    if (home == NULL)
+    {
+      printf("ERROR jblis_tune\n");
+      printf("no profile given, and HOME is not set\n");
+      return 1;
+    }
+    home_path.resize(strlen(home)+16);
+    snprintf(home_path.data(),home_path.size(),"%s/.libj_tune",home);
+    path = home_path.data();
+  }
+  if (mib == 0 || reps < 1)
+  {
+    printf("ERROR jblis_tune\n");
+    printf("-m and -r must be positive\n");
+    return 1;
+  }
+
+  libj::cache_print(stdout);
+  #if defined (_OPENMP)
+  printf("%d OpenMP threads\n",omp_get_max_threads());
+  #endif
+
+  const size_t bytes = mib*1024*1024;
+  for (int kernel=0;kernel<TUNE_NKERNEL;kernel++)
+  {
+    if (kernel == TUNE_CONTRACT)
+    {
+      tune_contract<double>(bytes,reps);
+      tune_contract<float>(bytes,reps);
+      continue;
+    }
+    tune<double>(kernel,bytes,reps);
+    tune<float>(kernel,bytes,reps);
+    tune<long>(kernel,bytes,reps);
+    tune<int>(kernel,bytes,reps);
+  }
+
+  if (libj::tune_save(path) != 0)
+  {
+    printf("ERROR jblis_tune\n");
+    printf("could not write %s\n",path);
+    return 1;
+  }
+  printf("wrote %s\n",path);
+  return 0;
+}
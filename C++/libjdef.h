@@ -8,6 +8,9 @@
 #define L1_BYTES 32768
 #define L2_BYTES 262144
 #define LINE_BYTES 64
+#define LIBJ_L1_BYTES L1_BYTES
+#define LIBJ_L2_BYTES L2_BYTES
+#define LIBJ_LINE_BYTES LINE_BYTES
 
 //ALIGNMENT DEFINITIONS
 #define DOUBLE_ALIGN 32
@@ -15,6 +18,7 @@
 #define LONG_ALIGN 32
 #define INT_ALIGN 32
 #define MAX_ALIGN DOUBLE_ALIGN
+#define LIBJ_MAX_ALIGN MAX_ALIGN
 
 //compiler specific definitions
 #define LIBJ_RESTRICT __restrict__
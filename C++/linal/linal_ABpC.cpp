@@ -1,6 +1,7 @@
 /*------------------------------------------------
   linal_ABpC.cpp
         JHT, December 8, 2021 : created 
+        JHT, October 19, 2026 : C is scaled by BETA, not BETA+1
 
     C = ALPHA*A.B + BETA*C  
 
@@ -61,8 +62,9 @@ void linal_ABpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B
 
       cc = C+M*J; //column of C we're working on
 
-      //+BETA*C for this column
-      simd_axpy<T>(M,BETA,cc,cc); 
+      //BETA*C for this column
+      if (fabs((double) BETA) < DZTOL) {simd_zero<T>(M,cc);}
+      else {simd_scal_mul<T>(M,BETA,cc);}
       
       //loop through the other cols of A and down col of B 
       for (auto I=0;I<K;I++)
@@ -0,0 +1,267 @@
+/*-------------------------------------------------------
+  mem.hpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : allocations reported to mem_stats.hpp
+	JHT, October 19, 2026 : mem_alloc with an explicit policy
+
+  Allocation backend shared by Core, vec, gemat, and
+  libj::tensor.
+
+  Small allocations come from malloc. Allocations of at
+  least policy.min_bytes come from anonymous mmap, where
+  the policy sets
+
+    pages	: MEM_PAGES_DEFAULT, normal pages
+		  MEM_PAGES_THP, transparent 2 MiB huge pages
+		    (madvise MADV_HUGEPAGE)
+		  MEM_PAGES_HUGETLB, explicit huge pages
+		    (MAP_HUGETLB), falling back to THP when the
+		    huge page pool is empty
+    place	: MEM_PLACE_DEFAULT, the kernel's policy
+		  MEM_PLACE_LOCAL, on the node of the thread that
+		    first touches each page
+		  MEM_PLACE_INTERLEAVE, pages round robin over
+		    the allowed NUMA nodes
+		  set with the mbind system call, so no libnuma
+    touch	: if true, the pages are zeroed by an OpenMP
+		  static loop, so that with MEM_PLACE_LOCAL each
+		  page lands on the node of the thread that will
+		  use it in a static loop over the same data
+
+  The default policy is read once from the environment
+
+    LIBJ_MEM_PAGES	= default | thp | hugetlb
+    LIBJ_MEM_PLACE	= default | local | interleave
+    LIBJ_MEM_TOUCH	= 0 | 1
+    LIBJ_MEM_MIN_BYTES	= bytes, default 2 MiB
+
+  Every pointer is aligned to at least MEM_ALIGN bytes,
+  and must be returned with mem_free. Allocations are
+  recorded in the registry of mem_stats.hpp, under the
+  kind of container given to mem_alloc
+
+  USAGE
+  --------------------------
+  double* x = (double*) libj::mem_alloc(n*sizeof(double),MEM_KIND_VEC);
+  libj::mem_free(x);
+
+  libj::mem_policy pol = libj::mem_get_policy();
+  pol.pages = MEM_PAGES_THP;				//this allocation only
+  void* p = libj::mem_alloc(bytes,MEM_KIND_OTHER,pol);
+
+  libj::mem_policy pol = libj::mem_get_policy();
+  pol.pages = MEM_PAGES_THP;
+  pol.place = MEM_PLACE_INTERLEAVE;
+  libj::mem_set_policy(pol);
+--------------------------------------------------------*/
+#ifndef LIBJ_MEM_HPP
+#define LIBJ_MEM_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "mem_stats.hpp"
+#include <unistd.h>
+#if defined (__linux__)
+  #include <sys/syscall.h>
+#endif
+
+#define MEM_PAGES_DEFAULT 0
+#define MEM_PAGES_THP 1
+#define MEM_PAGES_HUGETLB 2
+
+#define MEM_PLACE_DEFAULT 0
+#define MEM_PLACE_LOCAL 1
+#define MEM_PLACE_INTERLEAVE 2
+
+#define MEM_ALIGN 64 //alignment of every pointer
+#define MEM_HUGE_BYTES 2097152 //2 MiB
+
+//from linux/mempolicy.h
+#define MEM_MPOL_PREFERRED 1
+#define MEM_MPOL_INTERLEAVE 3
+#define MEM_MPOL_F_MEMS_ALLOWED 4
+#define MEM_MAX_NODES 1024
+
+namespace libj
+{
+
+struct mem_policy
+{
+  int    pages;
+  int    place;
+  bool   touch;
+  size_t min_bytes;	//smallest allocation that is mmaped
+};
+
+//header before each pointer
+struct mem_head
+{
+  void*  base;		//start of the malloc or mmap
+  size_t bytes;		//bytes of the mmap, 0 for malloc
+  long   request;	//bytes asked for
+  int    kind;		//kind of container
+  int    tag;		//tag of the allocating thread
+};
+
+//---------------------------------------------------------------------------
+// mem_env_policy -- the default policy, from the environment
+//---------------------------------------------------------------------------
+inline mem_policy mem_env_policy()
+{
+  mem_policy pol = {MEM_PAGES_DEFAULT,MEM_PLACE_DEFAULT,false,MEM_HUGE_BYTES};
+  const char* env = getenv("LIBJ_MEM_PAGES");
+  if (env != NULL)
+  {
+    if (strcmp(env,"thp") == 0) {pol.pages = MEM_PAGES_THP;}
+    else if (strcmp(env,"hugetlb") == 0) {pol.pages = MEM_PAGES_HUGETLB;}
+  }
+  env = getenv("LIBJ_MEM_PLACE");
+  if (env != NULL)
+  {
+    if (strcmp(env,"local") == 0) {pol.place = MEM_PLACE_LOCAL;}
+    else if (strcmp(env,"interleave") == 0) {pol.place = MEM_PLACE_INTERLEAVE;}
+  }
+  env = getenv("LIBJ_MEM_TOUCH");
+  if (env != NULL) {pol.touch = (atoi(env) != 0);}
+  env = getenv("LIBJ_MEM_MIN_BYTES");
+  if (env != NULL) {pol.min_bytes = (size_t) atol(env);}
+  return pol;
+}
+
+inline mem_policy& mem_policy_ref()
+{
+  static mem_policy pol = mem_env_policy();
+  return pol;
+}
+
+//set before allocating from more than one thread
+inline const mem_policy& mem_get_policy() {return mem_policy_ref();}
+inline void mem_set_policy(const mem_policy& pol) {mem_policy_ref() = pol;}
+
+//---------------------------------------------------------------------------
+// mem_bind -- set the NUMA placement of a range, returns 0 on success
+//---------------------------------------------------------------------------
+inline int mem_bind(void* ptr, const size_t bytes, const int place)
+{
+  #if defined (__linux__) && defined (SYS_mbind) && defined (SYS_get_mempolicy)
+  unsigned long mask[MEM_MAX_NODES/(8*sizeof(unsigned long))];
+  memset(mask,0,sizeof(mask));
+  if (place == MEM_PLACE_INTERLEAVE)
+  {
+    int mode;
+    if (syscall(SYS_get_mempolicy,&mode,mask,(unsigned long) MEM_MAX_NODES,
+                NULL,(unsigned long) MEM_MPOL_F_MEMS_ALLOWED) != 0) {return 1;}
+    return (syscall(SYS_mbind,ptr,bytes,MEM_MPOL_INTERLEAVE,mask,
+                    (unsigned long) MEM_MAX_NODES,0) == 0) ? 0 : 1;
+  } else if (place == MEM_PLACE_LOCAL) {
+    //preferred with no nodes is local allocation
+    return (syscall(SYS_mbind,ptr,bytes,MEM_MPOL_PREFERRED,NULL,
+                    0UL,0) == 0) ? 0 : 1;
+  }
+  #endif
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// mem_touch -- zero the pages of a range in an OpenMP static loop
+//---------------------------------------------------------------------------
+inline void mem_touch(void* ptr, const size_t bytes)
+{
+  const long page = sysconf(_SC_PAGESIZE);
+  const long npage = (long) ((bytes + page - 1)/page);
+  char* cptr = (char*) ptr;
+  #pragma omp parallel for schedule(static)
+  for (long p=0;p<npage;p++)
+  {
+    const size_t off = (size_t) p*page;
+    const size_t len = (bytes-off < (size_t) page) ? bytes-off : (size_t) page;
+    memset(cptr+off,0,len);
+  }
+}
+
+//---------------------------------------------------------------------------
+// mem_alloc -- allocate bytes, aligned to MEM_ALIGN, with the given
+//   policy. NULL on failure
+//---------------------------------------------------------------------------
+inline void* mem_alloc(const size_t bytes, const int kind, const mem_policy& pol)
+{
+  const size_t total = bytes + sizeof(mem_head) + MEM_ALIGN;
+  const int k = (kind >= 0 && kind < MEM_NKIND) ? kind : MEM_KIND_OTHER;
+  mem_head head = {NULL,0,(long) bytes,k,mem_thread_tag()};
+  uintptr_t region = 0;			//where the pointer and header go
+
+  if (bytes < pol.min_bytes || bytes == 0)
+  {
+    head.base = malloc(total);
+    if (head.base == NULL) {return NULL;}
+
+  } else {
+    void* base = MAP_FAILED;
+    size_t len = total;
+    #if defined (MAP_HUGETLB)
+    if (pol.pages == MEM_PAGES_HUGETLB)
+    {
+      len = ((total + MEM_HUGE_BYTES - 1)/MEM_HUGE_BYTES)*MEM_HUGE_BYTES;
+      base = mmap(NULL,len,PROT_READ|PROT_WRITE,
+                  MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+    }
+    #endif
+    if (base == MAP_FAILED)
+    {
+      //room to start on a huge page boundary
+      len = (pol.pages != MEM_PAGES_DEFAULT) ? total + MEM_HUGE_BYTES : total;
+      base = mmap(NULL,len,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+      if (base == MAP_FAILED) {return NULL;}
+      if (pol.pages != MEM_PAGES_DEFAULT)
+      {
+        region = ((uintptr_t) base + MEM_HUGE_BYTES - 1) & ~((uintptr_t) MEM_HUGE_BYTES - 1);
+        #if defined (MADV_HUGEPAGE)
+        madvise((void*) region,total,MADV_HUGEPAGE);
+        #endif
+      }
+    }
+    if (pol.place != MEM_PLACE_DEFAULT) {mem_bind(base,len,pol.place);}
+    head.base = base;
+    head.bytes = len;
+  }
+  if (region == 0) {region = (uintptr_t) head.base;}
+
+  //the header sits just before the aligned pointer
+  const uintptr_t start = region + sizeof(mem_head);
+  char* ptr = (char*) ((start + MEM_ALIGN - 1) & ~((uintptr_t) MEM_ALIGN - 1));
+  memcpy(ptr-sizeof(mem_head),&head,sizeof(mem_head));
+
+  if (head.bytes > 0 && pol.touch) {mem_touch(ptr,bytes);}
+  mem_record_alloc(head.request,head.kind,head.tag);
+  return (void*) ptr;
+}
+
+//with the current policy
+inline void* mem_alloc(const size_t bytes, const int kind = MEM_KIND_OTHER)
+{
+  return mem_alloc(bytes,kind,mem_get_policy());
+}
+
+//---------------------------------------------------------------------------
+// mem_free -- return a pointer from mem_alloc, NULL is ignored
+//---------------------------------------------------------------------------
+inline void mem_free(void* ptr)
+{
+  if (ptr == NULL) {return;}
+  mem_head head;
+  memcpy(&head,(char*) ptr-sizeof(mem_head),sizeof(mem_head));
+  mem_record_free(head.request,head.kind,head.tag);
+  if (head.bytes == 0)
+  {
+    free(head.base);
+  } else {
+    munmap(head.base,head.bytes);
+  }
+}
+
+}//end libj namespace
+
+#endif
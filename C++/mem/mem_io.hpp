@@ -0,0 +1,403 @@
+/*-------------------------------------------------------
+  mem_io.hpp
+	JHT, October 19, 2026 : created
+
+  Binary records for the buffers of the libj containers
+  (gemat, usymat, geten3, geten4, and libj::tensor), for
+  checkpoints that are written and read at the speed of
+  the disk.
+
+  A record is a header of MEM_IO_HEAD_BYTES, then the raw
+  buffer, padded to a multiple of MEM_IO_ALIGN bytes, so
+  that records may follow each other in one file and the
+  data of each starts MEM_IO_ALIGN aligned. The header
+  holds
+
+    kind	: the container, as a MEM_KIND_* of mem_stats.hpp
+    type	: MEM_IO_DOUBLE, FLOAT, LONG, or INT
+    rank	: number of lengths (at most MEM_IO_MAXRANK)
+    lengths	: length of each dimension
+    strides	: stride of each dimension, in elements
+		  (zero for packed storage, as in usymat)
+    nelm	: number of elements in the buffer
+    alignment	: alignment of the buffer it was written from
+    checksum	: of the data, and of the header itself
+
+  Records are in the byte order of the machine that wrote
+  them, and are refused on a machine of the other order.
+
+  The checksum is a four lane Fletcher sum over 64 bit
+  words, which runs at memory bandwidth. It is checked by
+  every read, and by mem_io_verify. A mapped record is
+  not checked unless asked, as that reads every page.
+
+  READ and WRITE through FILE*
+  --------------------------
+  libj::mem_io_head h = libj::mem_io_make(MEM_KIND_GEMAT,
+      libj::mem_io_type<double>(),sizeof(double),2,lengths,strides,n,align);
+  libj::mem_io_write(fptr,h,data);	//header, data, padding
+  libj::mem_io_read_head(fptr,h);	//the next header
+  libj::mem_io_read_data(fptr,h,data);	//its data, which is checked
+
+  ZERO COPY through mmap (or a Pfile map_block)
+  --------------------------
+  libj::mem_io_map map;
+  libj::mem_io_map_open("ckpt.bin",map);  //private, copy on write
+  size_t pos = 0;
+  const void* rec = map.ptr + pos;
+  const void* data = libj::mem_io_parse(rec,map.len-pos,h);
+  pos += libj::mem_io_record_bytes(h);	//next record
+  libj::mem_io_map_close(map);
+
+  const void* rec = pfile.map_block(fid,pos,MEM_IO_HEAD_BYTES);
+  libj::mem_io_parse(rec,MEM_IO_HEAD_BYTES,h);
+  rec = pfile.map_block(fid,pos,libj::mem_io_record_bytes(h));
+
+  The containers wrap these as save(FILE*), load(FILE*),
+  and view(record,bytes). All functions return 0, or one
+  of the MEM_IO_ERR_* codes, described by mem_io_error.
+--------------------------------------------------------*/
+#ifndef LIBJ_MEM_IO_HPP
+#define LIBJ_MEM_IO_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "mem_stats.hpp"
+
+#define MEM_IO_VERSION 1
+#define MEM_IO_ORDER 0x01020304u	//byte order marker
+#define MEM_IO_MAXRANK 16
+#define MEM_IO_HEAD_BYTES 512		//header on disk, padded
+#define MEM_IO_ALIGN 512		//records are padded to this
+#define MEM_IO_CHUNK (64L*1024L*1024L)	//bytes per fread/fwrite
+
+//types
+#define MEM_IO_NONE 0
+#define MEM_IO_DOUBLE 1
+#define MEM_IO_FLOAT 2
+#define MEM_IO_LONG 3
+#define MEM_IO_INT 4
+
+//errors
+#define MEM_IO_ERR_WRITE -1	//could not write
+#define MEM_IO_ERR_READ -2	//could not read, or the file ended
+#define MEM_IO_ERR_HEAD -3	//not a record, or a damaged header
+#define MEM_IO_ERR_SUM -4	//data does not match its checksum
+#define MEM_IO_ERR_MAP -5	//could not map the file
+#define MEM_IO_ERR_TYPE -6	//record is of another type or container
+#define MEM_IO_ERR_SHAPE -7	//container is set to another shape
+#define MEM_IO_ERR_SET -8	//container is allocated, so cannot view
+
+namespace libj
+{
+
+struct mem_io_head
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t order;
+  uint32_t kind;
+  uint32_t type;
+  uint32_t rank;
+  uint32_t pad;
+  uint64_t elem_bytes;
+  uint64_t nelm;
+  uint64_t data_bytes;
+  uint64_t alignment;
+  uint64_t lengths[MEM_IO_MAXRANK];
+  uint64_t strides[MEM_IO_MAXRANK];
+  uint64_t checksum;		//of the data
+  uint64_t head_checksum;	//of everything above
+};
+
+static const char MEM_IO_MAGIC[8] = {'L','I','B','J','R','E','C','\0'};
+
+template<typename T> inline uint32_t mem_io_type() {return MEM_IO_NONE;}
+template<> inline uint32_t mem_io_type<double>() {return MEM_IO_DOUBLE;}
+template<> inline uint32_t mem_io_type<float>() {return MEM_IO_FLOAT;}
+template<> inline uint32_t mem_io_type<long>() {return MEM_IO_LONG;}
+template<> inline uint32_t mem_io_type<int>() {return MEM_IO_INT;}
+
+inline const char* mem_io_error(const int err)
+{
+  switch (err)
+  {
+    case 0:                return "no error";
+    case MEM_IO_ERR_WRITE: return "could not write";
+    case MEM_IO_ERR_READ:  return "could not read";
+    case MEM_IO_ERR_HEAD:  return "not a libj record, or a damaged header";
+    case MEM_IO_ERR_SUM:   return "data does not match its checksum";
+    case MEM_IO_ERR_MAP:   return "could not map the file";
+    case MEM_IO_ERR_TYPE:  return "record is of another type or container";
+    case MEM_IO_ERR_SHAPE: return "container is set to another shape";
+    case MEM_IO_ERR_SET:   return "container is allocated, and cannot view a record";
+    default:               return "unknown error";
+  }
+}
+
+//---------------------------------------------------------------------------
+// checksum -- four lanes of a = a + w, b = b + a over 64 bit words. Every
+//   call but the last of a stream must be given a multiple of 32 bytes
+//---------------------------------------------------------------------------
+struct mem_io_sum
+{
+  uint64_t a[4];
+  uint64_t b[4];
+};
+
+inline void mem_io_sum_init(mem_io_sum& s)
+{
+  for (int l=0;l<4;l++) {s.a[l] = 0; s.b[l] = 0;}
+}
+
+inline void mem_io_sum_update(mem_io_sum& s, const void* data, const size_t bytes)
+{
+  const char* p = (const char*) data;
+  const size_t ngroup = bytes/32;
+  uint64_t a0=s.a[0],a1=s.a[1],a2=s.a[2],a3=s.a[3];
+  uint64_t b0=s.b[0],b1=s.b[1],b2=s.b[2],b3=s.b[3];
+  for (size_t g=0;g<ngroup;g++)
+  {
+    uint64_t w[4];
+    memcpy(w,p+32*g,32);
+    a0 += w[0]; b0 += a0;
+    a1 += w[1]; b1 += a1;
+    a2 += w[2]; b2 += a2;
+    a3 += w[3]; b3 += a3;
+  }
+  s.a[0]=a0; s.a[1]=a1; s.a[2]=a2; s.a[3]=a3;
+  s.b[0]=b0; s.b[1]=b1; s.b[2]=b2; s.b[3]=b3;
+
+  //the tail, zero padded to a group
+  const size_t tail = bytes - 32*ngroup;
+  if (tail > 0)
+  {
+    uint64_t w[4] = {0,0,0,0};
+    memcpy(w,p+32*ngroup,tail);
+    for (int l=0;l<4;l++) {s.a[l] += w[l]; s.b[l] += s.a[l];}
+  }
+}
+
+inline uint64_t mem_io_sum_final(const mem_io_sum& s)
+{
+  uint64_t h = 0;
+  for (int l=0;l<4;l++)
+  {
+    h = (h << 13 | h >> 51) ^ s.a[l];
+    h = (h << 29 | h >> 35) ^ s.b[l];
+  }
+  return h;
+}
+
+inline uint64_t mem_io_checksum(const void* data, const size_t bytes)
+{
+  mem_io_sum s;
+  mem_io_sum_init(s);
+  mem_io_sum_update(s,data,bytes);
+  return mem_io_sum_final(s);
+}
+
+inline uint64_t mem_io_head_sum(const mem_io_head& h)
+{
+  return mem_io_checksum(&h,offsetof(mem_io_head,head_checksum));
+}
+
+//---------------------------------------------------------------------------
+// record geometry
+//---------------------------------------------------------------------------
+inline size_t mem_io_pad(const size_t bytes)
+{
+  return (bytes + MEM_IO_ALIGN - 1)/MEM_IO_ALIGN*MEM_IO_ALIGN;
+}
+
+inline size_t mem_io_record_bytes(const mem_io_head& h)
+{
+  return MEM_IO_HEAD_BYTES + mem_io_pad(h.data_bytes);
+}
+
+//---------------------------------------------------------------------------
+// mem_io_make -- a header, without the checksums
+//---------------------------------------------------------------------------
+inline mem_io_head mem_io_make(const int kind, const uint32_t type,
+                               const size_t elem_bytes, const size_t rank,
+                               const size_t* lengths, const size_t* strides,
+                               const size_t nelm, const size_t alignment)
+{
+  mem_io_head h;
+  memset(&h,0,sizeof(h));
+  memcpy(h.magic,MEM_IO_MAGIC,8);
+  h.version = MEM_IO_VERSION;
+  h.order = MEM_IO_ORDER;
+  h.kind = (uint32_t) kind;
+  h.type = type;
+  h.rank = (uint32_t) rank;
+  h.elem_bytes = elem_bytes;
+  h.nelm = nelm;
+  h.data_bytes = nelm*elem_bytes;
+  h.alignment = alignment;
+  for (size_t i=0;i<rank && i<MEM_IO_MAXRANK;i++)
+  {
+    h.lengths[i] = lengths[i];
+    h.strides[i] = strides[i];
+  }
+  return h;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_check_head -- 0 if h is a sound header
+//---------------------------------------------------------------------------
+inline int mem_io_check_head(const mem_io_head& h)
+{
+  if (memcmp(h.magic,MEM_IO_MAGIC,8) != 0) {return MEM_IO_ERR_HEAD;}
+  if (h.version != MEM_IO_VERSION || h.order != MEM_IO_ORDER) {return MEM_IO_ERR_HEAD;}
+  if (h.head_checksum != mem_io_head_sum(h)) {return MEM_IO_ERR_HEAD;}
+  if (h.rank > MEM_IO_MAXRANK || h.data_bytes != h.nelm*h.elem_bytes) {return MEM_IO_ERR_HEAD;}
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_write -- write a record of bytes data_bytes of h at the position
+//   of fptr. Sets the checksums of h
+//---------------------------------------------------------------------------
+inline int mem_io_write(FILE* fptr, mem_io_head& h, const void* data)
+{
+  if (h.rank > MEM_IO_MAXRANK) {return MEM_IO_ERR_HEAD;}
+  h.checksum = mem_io_checksum(data,h.data_bytes);
+  h.head_checksum = mem_io_head_sum(h);
+
+  char head[MEM_IO_HEAD_BYTES];
+  memset(head,0,MEM_IO_HEAD_BYTES);
+  memcpy(head,&h,sizeof(h));
+  if (fwrite(head,1,MEM_IO_HEAD_BYTES,fptr) != MEM_IO_HEAD_BYTES) {return MEM_IO_ERR_WRITE;}
+
+  const char* p = (const char*) data;
+  for (size_t done=0;done<h.data_bytes;)
+  {
+    const size_t len = (h.data_bytes-done < (size_t) MEM_IO_CHUNK) ? h.data_bytes-done
+                                                                    : (size_t) MEM_IO_CHUNK;
+    if (fwrite(p+done,1,len,fptr) != len) {return MEM_IO_ERR_WRITE;}
+    done += len;
+  }
+
+  const size_t pad = mem_io_pad(h.data_bytes) - h.data_bytes;
+  if (pad > 0)
+  {
+    static const char zeros[MEM_IO_ALIGN] = {0};
+    if (fwrite(zeros,1,pad,fptr) != pad) {return MEM_IO_ERR_WRITE;}
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_read_head -- read and check the header at the position of fptr
+//---------------------------------------------------------------------------
+inline int mem_io_read_head(FILE* fptr, mem_io_head& h)
+{
+  char head[MEM_IO_HEAD_BYTES];
+  if (fread(head,1,MEM_IO_HEAD_BYTES,fptr) != MEM_IO_HEAD_BYTES) {return MEM_IO_ERR_READ;}
+  memcpy(&h,head,sizeof(h));
+  return mem_io_check_head(h);
+}
+
+//---------------------------------------------------------------------------
+// mem_io_read_data -- read the data of the record whose header was just
+//   read into data, checking it as it goes. Leaves fptr at the next record
+//---------------------------------------------------------------------------
+inline int mem_io_read_data(FILE* fptr, const mem_io_head& h, void* data)
+{
+  mem_io_sum s;
+  mem_io_sum_init(s);
+  char* p = (char*) data;
+  for (size_t done=0;done<h.data_bytes;)
+  {
+    const size_t len = (h.data_bytes-done < (size_t) MEM_IO_CHUNK) ? h.data_bytes-done
+                                                                    : (size_t) MEM_IO_CHUNK;
+    if (fread(p+done,1,len,fptr) != len) {return MEM_IO_ERR_READ;}
+    mem_io_sum_update(s,p+done,len);
+    done += len;
+  }
+
+  const size_t pad = mem_io_pad(h.data_bytes) - h.data_bytes;
+  if (pad > 0 && fseek(fptr,(long) pad,SEEK_CUR) != 0) {return MEM_IO_ERR_READ;}
+  return (mem_io_sum_final(s) == h.checksum) ? 0 : MEM_IO_ERR_SUM;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_parse -- the header of the record at rec (of at least bytes), and
+//   a pointer to its data, or NULL if it is not a record. The data may be
+//   past bytes, if only the header was mapped
+//---------------------------------------------------------------------------
+inline const void* mem_io_parse(const void* rec, const size_t bytes, mem_io_head& h)
+{
+  if (rec == NULL || bytes < MEM_IO_HEAD_BYTES) {return NULL;}
+  memcpy(&h,rec,sizeof(h));
+  if (mem_io_check_head(h) != 0) {return NULL;}
+  return (const char*) rec + MEM_IO_HEAD_BYTES;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_check_type -- 0 if h is a record of the container kind, of type T,
+//   and of the rank given
+//---------------------------------------------------------------------------
+template<typename T>
+inline int mem_io_check_type(const mem_io_head& h, const int kind, const size_t rank)
+{
+  if (mem_io_type<T>() == MEM_IO_NONE || h.type != mem_io_type<T>()) {return MEM_IO_ERR_TYPE;}
+  if (h.kind != (uint32_t) kind || h.rank != rank || h.elem_bytes != sizeof(T)) {return MEM_IO_ERR_TYPE;}
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_verify -- 0 if data matches the checksum of h
+//---------------------------------------------------------------------------
+inline int mem_io_verify(const mem_io_head& h, const void* data)
+{
+  return (mem_io_checksum(data,h.data_bytes) == h.checksum) ? 0 : MEM_IO_ERR_SUM;
+}
+
+//---------------------------------------------------------------------------
+// mem_io_map -- a whole file, mapped private. Pages are read as they are
+//   touched, and writes to them are copied rather than reaching the file,
+//   so containers may view and modify the records
+//---------------------------------------------------------------------------
+struct mem_io_map
+{
+  char*  ptr;
+  size_t len;
+};
+
+inline int mem_io_map_open(const char* path, mem_io_map& map)
+{
+  map.ptr = NULL;
+  map.len = 0;
+  const int fd = ::open(path,O_RDONLY);
+  if (fd < 0) {return MEM_IO_ERR_MAP;}
+  struct stat st;
+  if (fstat(fd,&st) != 0 || st.st_size <= 0) {::close(fd); return MEM_IO_ERR_MAP;}
+  void* ptr = mmap(NULL,(size_t) st.st_size,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+  ::close(fd);
+  if (ptr == MAP_FAILED) {return MEM_IO_ERR_MAP;}
+  map.ptr = (char*) ptr;
+  map.len = (size_t) st.st_size;
+  return 0;
+}
+
+inline int mem_io_map_close(mem_io_map& map)
+{
+  int err = 0;
+  if (map.ptr != NULL && munmap(map.ptr,map.len) != 0) {err = MEM_IO_ERR_MAP;}
+  map.ptr = NULL;
+  map.len = 0;
+  return err;
+}
+
+}//end libj namespace
+
+#endif
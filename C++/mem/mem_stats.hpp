@@ -0,0 +1,301 @@
+/*-------------------------------------------------------
+  mem_stats.hpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : cache pool kind
+	JHT, October 19, 2026 : tag queries do not add tags,
+	                        tag names are escaped in JSON
+
+  Registry of the memory held by libj containers. Every
+  mem_alloc and mem_free (see mem.hpp) reports to it, with
+  the kind of container it is for, and the tag of the
+  calling thread.
+
+  For each kind, each tag, and in total, the registry keeps
+    live	: bytes allocated and not yet freed
+    peak	: high water mark of live
+    count	: number of allocations
+    hist	: number of allocations of [2^k,2^(k+1)) bytes
+
+  All counters are atomics, so containers may be made and
+  freed from any thread. Tags are names (up to
+  MEM_MAX_TAGS of them) set per thread, for as long as a
+  mem_tag_scope lives. Only a mem_tag_scope adds a tag,
+  mem_stats_tag of a name never set is all zero.
+
+  USAGE
+  --------------------------
+  {
+    libj::mem_tag_scope tag("ccsd_t2");	//this thread's allocations
+    libj::tensor<double> T2;		//count towards ccsd_t2
+    ...
+  }
+  libj::mem_stat tot = libj::mem_stats_total();
+  printf("peak %ld bytes\n",tot.peak);
+  libj::mem_stats_json(stdout);		//everything, as JSON
+  std::string s = libj::mem_stats_json();
+--------------------------------------------------------*/
+#ifndef LIBJ_MEM_STATS_HPP
+#define LIBJ_MEM_STATS_HPP
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+//kinds of container
+#define MEM_KIND_OTHER 0
+#define MEM_KIND_CORE 1
+#define MEM_KIND_VEC 2
+#define MEM_KIND_GEMAT 3
+#define MEM_KIND_USYMAT 4
+#define MEM_KIND_GETEN3 5
+#define MEM_KIND_GETEN4 6
+#define MEM_KIND_TENSOR 7
+#define MEM_KIND_PACKED_TENSOR 8
+#define MEM_KIND_BLOCK_SPARSE_TENSOR 9
+#define MEM_KIND_CACHE 10
+#define MEM_NKIND 11
+
+#define MEM_MAX_TAGS 64 //tags, tag 0 is untagged
+#define MEM_TAG_LEN 32 //max length of a tag name
+#define MEM_NHIST 48 //histogram bins
+
+namespace libj
+{
+
+//a snapshot of one set of counters
+struct mem_stat
+{
+  long live;
+  long peak;
+  long count;
+  long hist[MEM_NHIST];
+};
+
+//one set of counters
+struct mem_counter
+{
+  std::atomic<long> live;
+  std::atomic<long> peak;
+  std::atomic<long> count;
+  std::atomic<long> hist[MEM_NHIST];
+
+  mem_counter() : live(0), peak(0), count(0)
+  {
+    for (int k=0;k<MEM_NHIST;k++) {hist[k] = 0;}
+  }
+
+  void add(const long bytes, const int bin)
+  {
+    const long now = live.fetch_add(bytes) + bytes;
+    long old = peak.load();
+    while (now > old && !peak.compare_exchange_weak(old,now)) {}
+    count++;
+    hist[bin]++;
+  }
+
+  void sub(const long bytes) {live -= bytes;}
+
+  mem_stat get() const
+  {
+    mem_stat s;
+    s.live = live.load();
+    s.peak = peak.load();
+    s.count = count.load();
+    for (int k=0;k<MEM_NHIST;k++) {s.hist[k] = hist[k].load();}
+    return s;
+  }
+};
+
+struct mem_registry
+{
+  mem_counter total;
+  mem_counter kind[MEM_NKIND];
+  mem_counter tag[MEM_MAX_TAGS];
+  char        tag_name[MEM_MAX_TAGS][MEM_TAG_LEN];
+  int         ntag;
+  std::mutex  lock;		//for adding tags
+
+  mem_registry() : ntag(1)
+  {
+    memset(tag_name,0,sizeof(tag_name));
+    strcpy(tag_name[0],"untagged");
+  }
+};
+
+inline mem_registry& mem_reg()
+{
+  static mem_registry reg;
+  return reg;
+}
+
+inline const char* mem_kind_name(const int kind)
+{
+  static const char* name[MEM_NKIND] = {"other","core","vec","gemat","usymat",
+                                        "geten3","geten4","tensor","packed_tensor",
+                                        "block_sparse_tensor","cache"};
+  return (kind >= 0 && kind < MEM_NKIND) ? name[kind] : name[0];
+}
+
+//---------------------------------------------------------------------------
+// tags
+//---------------------------------------------------------------------------
+inline int& mem_thread_tag()
+{
+  static thread_local int tag = 0;
+  return tag;
+}
+
+//id of a tag name, or -1 if there is none. Call with reg.lock held
+inline int mem_tag_find(const mem_registry& reg, const char* name)
+{
+  for (int t=0;t<reg.ntag;t++)
+  {
+    if (strncmp(reg.tag_name[t],name,MEM_TAG_LEN-1) == 0) {return t;}
+  }
+  return -1;
+}
+
+//id of a tag name, added if new. Names past MEM_MAX_TAGS go to tag 0
+inline int mem_tag_id(const char* name)
+{
+  mem_registry& reg = mem_reg();
+  std::lock_guard<std::mutex> guard(reg.lock);
+  const int t = mem_tag_find(reg,name);
+  if (t >= 0) {return t;}
+  if (reg.ntag == MEM_MAX_TAGS) {return 0;}
+  strncpy(reg.tag_name[reg.ntag],name,MEM_TAG_LEN-1);
+  return reg.ntag++;
+}
+
+//sets the tag of this thread, and restores the last one when done
+class mem_tag_scope
+{
+  private:
+  int m_last;
+  public:
+  mem_tag_scope(const char* name) : m_last(mem_thread_tag())
+  {
+    mem_thread_tag() = mem_tag_id(name);
+  }
+  ~mem_tag_scope() {mem_thread_tag() = m_last;}
+  mem_tag_scope(const mem_tag_scope&) = delete;
+  mem_tag_scope& operator=(const mem_tag_scope&) = delete;
+};
+
+//---------------------------------------------------------------------------
+// recording, from mem_alloc and mem_free
+//---------------------------------------------------------------------------
+inline void mem_record_alloc(const long bytes, const int kind, const int tag)
+{
+  int bin = 0;
+  while (bin < MEM_NHIST-1 && (2L << bin) <= bytes) {bin++;}
+  mem_registry& reg = mem_reg();
+  reg.total.add(bytes,bin);
+  reg.kind[kind].add(bytes,bin);
+  reg.tag[tag].add(bytes,bin);
+}
+
+inline void mem_record_free(const long bytes, const int kind, const int tag)
+{
+  mem_registry& reg = mem_reg();
+  reg.total.sub(bytes);
+  reg.kind[kind].sub(bytes);
+  reg.tag[tag].sub(bytes);
+}
+
+//---------------------------------------------------------------------------
+// queries
+//---------------------------------------------------------------------------
+inline mem_stat mem_stats_total() {return mem_reg().total.get();}
+inline mem_stat mem_stats_kind(const int kind) {return mem_reg().kind[kind].get();}
+
+//counters of a tag, all zero if no mem_tag_scope has set it
+inline mem_stat mem_stats_tag(const char* name)
+{
+  mem_registry& reg = mem_reg();
+  int t;
+  {
+    std::lock_guard<std::mutex> guard(reg.lock);
+    t = mem_tag_find(reg,name);
+  }
+  if (t < 0) {return mem_counter().get();}
+  return reg.tag[t].get();
+}
+
+//---------------------------------------------------------------------------
+// JSON
+//---------------------------------------------------------------------------
+//str as a JSON string, quoted, with '"', '\\', and control characters escaped
+inline void mem_json_string(std::string& s, const char* str)
+{
+  s += '"';
+  for (const char* c=str;*c!='\0';c++)
+  {
+    if (*c == '"' || *c == '\\') {s += '\\'; s += *c;}
+    else if ((unsigned char) *c < 0x20)
+    {
+      char esc[8];
+      snprintf(esc,sizeof(esc),"\\u%04x",(unsigned) (unsigned char) *c);
+      s += esc;
+    } else {
+      s += *c;
+    }
+  }
+  s += '"';
+}
+
+inline void mem_json_stat(std::string& s, const char* name, const mem_stat& st)
+{
+  char buf[128];
+  mem_json_string(s,name);
+  snprintf(buf,sizeof(buf),":{\"live\":%ld,\"peak\":%ld,\"count\":%ld,\"hist\":{",
+           st.live,st.peak,st.count);
+  s += buf;
+  bool first = true;
+  for (int k=0;k<MEM_NHIST;k++)
+  {
+    if (st.hist[k] == 0) {continue;}
+    snprintf(buf,sizeof(buf),"%s\"%ld\":%ld",first ? "" : ",",1L << k,st.hist[k]);
+    s += buf;
+    first = false;
+  }
+  s += "}}";
+}
+
+//all counters as JSON. Histogram keys are the smallest size of each bin
+inline std::string mem_stats_json()
+{
+  mem_registry& reg = mem_reg();
+  std::string s = "{";
+  mem_json_stat(s,"total",reg.total.get());
+  s += ",\"kind\":{";
+  for (int k=0;k<MEM_NKIND;k++)
+  {
+    if (k > 0) {s += ",";}
+    mem_json_stat(s,mem_kind_name(k),reg.kind[k].get());
+  }
+  s += "},\"tag\":{";
+  int ntag;
+  {
+    std::lock_guard<std::mutex> guard(reg.lock);
+    ntag = reg.ntag;
+  }
+  for (int t=0;t<ntag;t++)
+  {
+    if (t > 0) {s += ",";}
+    mem_json_stat(s,reg.tag_name[t],reg.tag[t].get());
+  }
+  s += "}}";
+  return s;
+}
+
+inline void mem_stats_json(FILE* fptr)
+{
+  fprintf(fptr,"%s\n",mem_stats_json().c_str());
+}
+
+}//end libj namespace
+
+#endif
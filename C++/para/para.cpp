@@ -1,6 +1,10 @@
 /*--------------------------------------------------------------------------- 
   para.hpp
 	JHT, Febuary 21, 2022 : created
+	JHT, October 19, 2026 : OpenMP tasks and MPI progress thread
+	JHT, October 19, 2026 : nonblocking print_all_begin/end
+	JHT, October 19, 2026 : progress thread starts on the first post
+	JHT, October 19, 2026 : task_region body runs on the master thread
 
   .cpp file for the para class object, which is the interaface to the other
   para classes and routines
@@ -13,10 +17,31 @@
 int Para::init()
 {
   if (pworld.init() != 0) {error(-1);}
+  return m_init_rest();
+}
+
+//---------------------------------------------------------------------------
+// Para() -- initialization, requesting a level of MPI thread support 
+//---------------------------------------------------------------------------
+int Para::init(const int thread_level)
+{
+  if (pworld.init(thread_level) != 0) {error(-1);}
+  return m_init_rest();
+}
+
+//---------------------------------------------------------------------------
+// m_init_rest -- initialization after pworld 
+//---------------------------------------------------------------------------
+int Para::m_init_rest()
+{
   if (pprint.init(pworld) != 0) {error(-1);}
   if (pworld.mpi_doesIO) {
     if (pfile.init(pworld) != 0) {error(-1);}
   }
+  #if defined LIBJ_MPI
+  if (pmpio.init(pworld) != 0) {error(-1);}
+  #endif
+  pdata.attach(pworld,pfile,pmpio);
   return 0;
 }
 
@@ -25,7 +50,9 @@ int Para::init()
 //---------------------------------------------------------------------------
 int Para::destroy()
 {
+  if (pprogress.stop() != 0) {error(1);}
   if (pprint.destroy(pworld) != 0) {error(1);}
+  if (pmpio.destroy(pworld) != 0) {error(1);}
   if (pworld.destroy() != 0) {error(1);}
   return 0;
 }
@@ -119,6 +146,24 @@ int Para::print_all()
   return 0;
 }
 
+//---------------------------------------------------------------------------
+// print_all_begin
+//---------------------------------------------------------------------------
+int Para::print_all_begin()
+{
+  pprint.print_all_begin(pworld);
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// print_all_end
+//---------------------------------------------------------------------------
+int Para::print_all_end()
+{
+  pprint.print_all_end(pworld);
+  return 0;
+}
+
 //---------------------------------------------------------------------------
 // print_master_add
 //---------------------------------------------------------------------------
@@ -288,3 +333,84 @@ int Para::file_getid(const char* fname)
 
   return fid;
 }
+
+//---------------------------------------------------------------------------
+// task_region
+//	runs body on the master thread of an OpenMP parallel region, so that
+//	it can spawn tasks for the other threads, and may call MPI under any
+//	thread level. Waits on all tasks at the end
+//---------------------------------------------------------------------------
+int Para::task_region(const std::function<void()>& body)
+{
+  #if defined LIBJ_OMP
+  #pragma omp parallel
+  {
+    #pragma omp master
+    {
+      body();
+    }
+    #pragma omp barrier
+  }
+  #else
+  body();
+  #endif
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// spawn
+//	spawns task as an OpenMP task, or runs it right away without OpenMP
+//---------------------------------------------------------------------------
+void Para::spawn(const std::function<void()>& task)
+{
+  #if defined LIBJ_OMP
+  #pragma omp task firstprivate(task)
+  {
+    task();
+  }
+  #else
+  task();
+  #endif
+}
+
+//---------------------------------------------------------------------------
+// taskwait
+//	waits on the tasks spawned by this thread. Progresses the posted
+//	requests if there is no progress thread, and this thread may call
+//	MPI (see Pprogress::poll)
+//---------------------------------------------------------------------------
+void Para::taskwait()
+{
+  #if defined LIBJ_OMP
+  #pragma omp taskwait
+  #endif
+  if (!pprogress.threaded()) {pprogress.poll();}
+}
+
+#if defined LIBJ_MPI
+//---------------------------------------------------------------------------
+// post
+//	hands a nonblocking request to the progress engine, which is
+//	started by the first post
+//---------------------------------------------------------------------------
+int Para::post(MPI_Request req)
+{
+  pprogress.start(pworld,PARA_PROGRESS_US);
+  return pprogress.post(req);
+}
+
+int Para::post(MPI_Request req, const std::function<void(const MPI_Status&)>& cb)
+{
+  pprogress.start(pworld,PARA_PROGRESS_US);
+  return pprogress.post(req,cb);
+}
+#endif
+
+//---------------------------------------------------------------------------
+// post_wait_all
+//	waits on all posted requests
+//---------------------------------------------------------------------------
+int Para::post_wait_all()
+{
+  return pprogress.wait_all();
+}
@@ -1,6 +1,11 @@
 /*--------------------------------------------------------------------
   para.hpp
 	JHT, Febuary 21, 2022 : created
+	JHT, October 19, 2026 : shared MPI-IO files (pmpio), pdata attached
+	JHT, October 19, 2026 : OpenMP tasks and MPI progress thread
+	JHT, October 19, 2026 : nonblocking print_all_begin/end
+	JHT, October 19, 2026 : progress thread starts on the first post
+	JHT, October 19, 2026 : task_region body runs on the master thread
 
   .hpp for the para class, which is the interface to the other para
   classes and routines.
@@ -18,9 +23,32 @@
     - error can be called to terminate the program
   Para para;
   para.init();
+  para.init(MPI_THREAD_MULTIPLE);	//request a thread support level
   para.destroy();
   para.error(1);
 
+  ----------------------------------
+  TASKS
+    - work is spawned as OpenMP tasks on the threads of this task, inside
+      a task region (an omp parallel region, with the master thread
+      spawning, so the body may call MPI under any thread level)
+    - nonblocking MPI requests posted to para are driven to completion by
+      a progress thread, so the communication overlaps with the tasks.
+      The thread is started by the first post, and only when MPI provides
+      MPI_THREAD_MULTIPLE, which must be requested with
+      init(MPI_THREAD_MULTIPLE). Otherwise the requests are progressed
+      by taskwait, when it is called on the main thread (tasks run on
+      other threads skip it). Callbacks run when the request completes
+  
+    Usage example:
+    para.task_region([&]{
+      for (long i=0;i<n;i++) {para.spawn([=]{work(i);});}
+      MPI_Irecv(buf,n,MPI_DOUBLE,src,tag,para.pworld.comm_world,&req);
+      para.post(req,[&](const MPI_Status& s){have_buf = true;});
+      para.taskwait();
+    });
+    para.post_wait_all();
+
   ----------------------------------
   PRINTING TO STDIO 
     -  messages are "added" by concatination to a string buffer. When a 
@@ -36,6 +64,14 @@
     para.print_addstore(" world! 42 = %d \n",42);
     para.print_all();
     para.print_master_now("master prints this right away\n");
+
+    - print_all_begin starts printing (and resets) the queue without 
+      waiting on the master, and print_all_end finishes it. Tasks other 
+      than the master can keep computing in between
+
+    para.print_all_begin();
+    ... compute ...
+    para.print_all_end();
   
 
   ----------------------------------
@@ -56,6 +92,10 @@
   
   ----------------------------------
   DATASYSTEM 
+    - pdata is attached to pfile and pmpio on init, so indexes of lists
+      can be moved between tasks with pdata.get, put, and accumulate
+    - work on the indexes of lists can be handed out dynamically with a
+      Psched (see psched.hpp)
 
 --------------------------------------------------------------------*/
 #ifndef LIBJ_PARA_HPP
@@ -65,19 +105,30 @@
 #include "strvec.hpp"
 #include "pprint.hpp"
 #include "pfile.hpp"
+#include "pmpio.hpp"
 #include "pdata.hpp"
+#include "psched.hpp"
+#include "pprogress.hpp"
+#include <functional>
+
+#define PARA_PROGRESS_US 50 //microseconds between progress thread polls
 
 class Para
 {
+  private:
+  int m_init_rest();
 
   public:
   Pworld pworld;
   Pprint pprint;
   Pfile  pfile;
+  Pmpio  pmpio;
   Pdata  pdata;
+  Pprogress pprogress;
 
   //init, destory, and error functions
   int init();
+  int init(const int thread_level);
   int destroy();
   void error(const int stat);
 
@@ -91,6 +142,8 @@ class Para
   int print_reset();
   int print_all();
   int print_all_noreset();
+  int print_all_begin();
+  int print_all_end();
   int print_now(const char* fstring,...);
   int print_master_now(const char* fstring,...);
 
@@ -104,6 +157,16 @@ class Para
   int file_save();
   int file_recover();
 
+  //TASKS
+  int task_region(const std::function<void()>& body);
+  void spawn(const std::function<void()>& task);
+  void taskwait();
+  #if defined LIBJ_MPI
+  int post(MPI_Request req);
+  int post(MPI_Request req, const std::function<void(const MPI_Status&)>& cb);
+  #endif
+  int post_wait_all();
+
   
 };
 
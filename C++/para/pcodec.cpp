@@ -0,0 +1,357 @@
+/*------------------------------------------------------------------------
+ * pcodec.cpp
+ *  JHT, October 19, 2026 : created
+ *
+ *  .cpp file for Pcodec, block compression of Pdata indexes
+------------------------------------------------------------------------*/
+#include "pcodec.hpp"
+#include <string.h>
+#include <math.h>
+
+//block methods, the first byte of each block
+#define PCODEC_M_RAW 0
+#define PCODEC_M_LZ 1
+#define PCODEC_M_QUANT 2
+#define PCODEC_M_QUANT_LZ 3
+
+#define PCODEC_HASH_BITS 12
+#define PCODEC_MIN_MATCH 4
+#define PCODEC_TAIL 5 //bytes at the end of a buffer that are always literals
+
+//-----------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------
+static inline uint32_t read32(const unsigned char* p)
+{
+  uint32_t v;
+  memcpy(&v,p,sizeof(v));
+  return v;
+}
+
+static inline long put_len(unsigned char* dst, long len)
+{
+  long op = 0;
+  while (len >= 255) {dst[op++] = 255; len -= 255;}
+  dst[op++] = (unsigned char) len;
+  return op;
+}
+
+static inline long put_varint(unsigned char* dst, uint64_t v)
+{
+  long op = 0;
+  while (v >= 0x80) {dst[op++] = (unsigned char) (v | 0x80); v >>= 7;}
+  dst[op++] = (unsigned char) v;
+  return op;
+}
+
+//-----------------------------------------------------------------------
+// lz_compress -- LZ4 style sequences of
+//   token (literals << 4 | match-4), literals, 16 bit offset
+//   with 255 extension bytes for literal and match lengths of 15 or more.
+//   The last sequence has literals only
+//-----------------------------------------------------------------------
+long Pcodec::lz_compress(const unsigned char* src, const long n,
+                         unsigned char* dst)
+{
+  int table[1 << PCODEC_HASH_BITS];
+  for (int i=0;i<(1 << PCODEC_HASH_BITS);i++) {table[i] = -1;}
+
+  long ip = 0, anchor = 0, op = 0;
+  const long limit = n - PCODEC_TAIL;
+  while (ip + PCODEC_MIN_MATCH <= limit)
+  {
+    const uint32_t seq = read32(src+ip);
+    const uint32_t h = (seq*2654435761u) >> (32-PCODEC_HASH_BITS);
+    const long ref = table[h];
+    table[h] = (int) ip;
+    if (ref < 0 || ip-ref > 65535 || read32(src+ref) != seq) {ip++; continue;}
+
+    long match = PCODEC_MIN_MATCH;
+    while (ip+match < limit && src[ref+match] == src[ip+match]) {match++;}
+
+    //sequence
+    const long lit = ip - anchor;
+    const long ml = match - PCODEC_MIN_MATCH;
+    unsigned char* token = dst + op++;
+    *token = (unsigned char) (((lit < 15 ? lit : 15) << 4) | (ml < 15 ? ml : 15));
+    if (lit >= 15) {op += put_len(dst+op,lit-15);}
+    memcpy(dst+op,src+anchor,lit);
+    op += lit;
+    const long off = ip - ref;
+    dst[op++] = (unsigned char) (off & 0xff);
+    dst[op++] = (unsigned char) (off >> 8);
+    if (ml >= 15) {op += put_len(dst+op,ml-15);}
+
+    ip += match;
+    anchor = ip;
+  }
+
+  //last literals
+  const long lit = n - anchor;
+  dst[op++] = (unsigned char) ((lit < 15 ? lit : 15) << 4);
+  if (lit >= 15) {op += put_len(dst+op,lit-15);}
+  memcpy(dst+op,src+anchor,lit);
+  op += lit;
+  return op;
+}
+
+//-----------------------------------------------------------------------
+// lz_decompress -- returns the bytes written, or PCODEC_ERR_DATA
+//-----------------------------------------------------------------------
+long Pcodec::lz_decompress(const unsigned char* src, const long cn,
+                           unsigned char* dst, const long n)
+{
+  long ip = 0, op = 0;
+  while (ip < cn)
+  {
+    const int token = src[ip++];
+    long lit = token >> 4;
+    if (lit == 15)
+    {
+      unsigned char b;
+      do {
+        if (ip >= cn) {return PCODEC_ERR_DATA;}
+        b = src[ip++];
+        lit += b;
+      } while (b == 255);
+    }
+    if (ip+lit > cn || op+lit > n) {return PCODEC_ERR_DATA;}
+    memcpy(dst+op,src+ip,lit);
+    ip += lit;
+    op += lit;
+    if (ip == cn) {break;}
+
+    if (ip+2 > cn) {return PCODEC_ERR_DATA;}
+    const long off = (long) src[ip] | ((long) src[ip+1] << 8);
+    ip += 2;
+    long match = (token & 15) + PCODEC_MIN_MATCH;
+    if ((token & 15) == 15)
+    {
+      unsigned char b;
+      do {
+        if (ip >= cn) {return PCODEC_ERR_DATA;}
+        b = src[ip++];
+        match += b;
+      } while (b == 255);
+    }
+    if (off == 0 || off > op || op+match > n) {return PCODEC_ERR_DATA;}
+
+    //matches may overlap their own output
+    const unsigned char* ref = dst + op - off;
+    for (long i=0;i<match;i++) {dst[op+i] = ref[i];}
+    op += match;
+  }
+  return op;
+}
+
+//-----------------------------------------------------------------------
+// quantization of doubles to multiples of 2*tol, delta and zigzag coded
+//   varints. 0 escapes a value that is kept exactly
+//-----------------------------------------------------------------------
+static long quant_encode(const double* x, const long n, const double tol,
+                         unsigned char* dst)
+{
+  const double scale = 0.5/tol;
+  const double qmax = 4503599627370496.0; //2^52
+  int64_t prev = 0;
+  long op = 0;
+  for (long i=0;i<n;i++)
+  {
+    const double q = x[i]*scale;
+    if (!(fabs(q) <= qmax))
+    {
+      dst[op++] = 0;
+      memcpy(dst+op,&x[i],sizeof(double));
+      op += sizeof(double);
+      continue;
+    }
+    const int64_t qi = (int64_t) llround(q);
+    const int64_t d = qi - prev;
+    const uint64_t z = ((uint64_t) d << 1) ^ (uint64_t) (d >> 63);
+    op += put_varint(dst+op,z+1);
+    prev = qi;
+  }
+  return op;
+}
+
+static int quant_decode(const unsigned char* src, const long cn,
+                        const double tol, double* x, const long n)
+{
+  const double step = 2.0*tol;
+  int64_t prev = 0;
+  long ip = 0;
+  for (long i=0;i<n;i++)
+  {
+    uint64_t v = 0;
+    int shift = 0;
+    unsigned char b;
+    do {
+      if (ip >= cn || shift > 63) {return PCODEC_ERR_DATA;}
+      b = src[ip++];
+      v |= (uint64_t) (b & 0x7f) << shift;
+      shift += 7;
+    } while (b & 0x80);
+
+    if (v == 0)
+    {
+      if (ip+(long) sizeof(double) > cn) {return PCODEC_ERR_DATA;}
+      memcpy(&x[i],src+ip,sizeof(double));
+      ip += sizeof(double);
+      continue;
+    }
+    const uint64_t z = v - 1;
+    const int64_t d = (int64_t) (z >> 1) ^ -(int64_t) (z & 1);
+    prev += d;
+    x[i] = (double) prev*step;
+  }
+  return (ip == cn) ? 0 : PCODEC_ERR_DATA;
+}
+
+//-----------------------------------------------------------------------
+// compress
+//-----------------------------------------------------------------------
+long Pcodec::compress(const int codec, const double tol, const void* src,
+                      const long bytes, std::vector<char>& dst)
+{
+  if (codec != PCODEC_NONE && codec != PCODEC_LZ && codec != PCODEC_LOSSY)
+  {
+    return PCODEC_ERR_CODEC;
+  }
+  if (codec == PCODEC_LOSSY && (bytes % sizeof(double) != 0 || !(tol > 0)))
+  {
+    return PCODEC_ERR_CODEC;
+  }
+
+  const long nblocks = (bytes + PCODEC_BLOCK - 1)/PCODEC_BLOCK;
+  const unsigned char* in = (const unsigned char*) src;
+  std::vector<std::vector<unsigned char>> block(nblocks);
+
+  #pragma omp parallel if (nblocks > 1)
+  {
+    std::vector<unsigned char> quant, lz;
+
+    #pragma omp for schedule(dynamic)
+    for (long b=0;b<nblocks;b++)
+    {
+      const long off = b*PCODEC_BLOCK;
+      const long n = (bytes-off < PCODEC_BLOCK) ? bytes-off : PCODEC_BLOCK;
+      std::vector<unsigned char>& out = block[b];
+
+      //best of raw and what the codec gives
+      int method = PCODEC_M_RAW;
+      const unsigned char* best = in + off;
+      long best_len = n;
+
+      if (codec == PCODEC_LZ)
+      {
+        lz.resize(lz_bound(n));
+        const long c = lz_compress(in+off,n,lz.data());
+        if (c < best_len) {method = PCODEC_M_LZ; best = lz.data(); best_len = c;}
+
+      } else if (codec == PCODEC_LOSSY) {
+        const long nx = n/sizeof(double);
+        quant.resize(nx*(sizeof(double)+1));
+        const long qn = quant_encode((const double*) (in+off),nx,tol,quant.data());
+        lz.resize(lz_bound(qn));
+        const long c = lz_compress(quant.data(),qn,lz.data());
+        if (c < qn) {method = PCODEC_M_QUANT_LZ; best = lz.data(); best_len = c;}
+        else {method = PCODEC_M_QUANT; best = quant.data(); best_len = qn;}
+        if (best_len >= n) {method = PCODEC_M_RAW; best = in + off; best_len = n;}
+      }
+
+      out.resize(best_len+1);
+      out[0] = (unsigned char) method;
+      memcpy(out.data()+1,best,best_len);
+    }
+  }
+
+  //header, sizes, blocks
+  long total = sizeof(Pcodec_head) + nblocks*sizeof(uint32_t);
+  for (long b=0;b<nblocks;b++) {total += (long) block[b].size();}
+  dst.resize(total);
+
+  Pcodec_head head = {(int32_t) codec,(int32_t) nblocks,(int64_t) bytes,tol};
+  memcpy(dst.data(),&head,sizeof(head));
+  char* csize = dst.data() + sizeof(head);
+  char* out = csize + nblocks*sizeof(uint32_t);
+  for (long b=0;b<nblocks;b++)
+  {
+    const uint32_t len = (uint32_t) block[b].size();
+    memcpy(csize+b*sizeof(uint32_t),&len,sizeof(len));
+    memcpy(out,block[b].data(),len);
+    out += len;
+  }
+  return total;
+}
+
+//-----------------------------------------------------------------------
+// decompress
+//-----------------------------------------------------------------------
+int Pcodec::decompress(const void* src, const long cbytes, void* dst,
+                       const long bytes)
+{
+  const char* in = (const char*) src;
+  if (cbytes < (long) sizeof(Pcodec_head)) {return PCODEC_ERR_DATA;}
+  Pcodec_head head;
+  memcpy(&head,in,sizeof(head));
+  const long nblocks = head.m_nblocks;
+  if (head.m_bytes != bytes
+      || nblocks != (bytes + PCODEC_BLOCK - 1)/PCODEC_BLOCK) {return PCODEC_ERR_DATA;}
+  if (head.m_codec == PCODEC_LOSSY && bytes % sizeof(double) != 0) {return PCODEC_ERR_DATA;}
+
+  //block offsets
+  const char* csize = in + sizeof(head);
+  std::vector<long> offset(nblocks+1);
+  offset[0] = sizeof(head) + nblocks*sizeof(uint32_t);
+  for (long b=0;b<nblocks;b++)
+  {
+    uint32_t len;
+    memcpy(&len,csize+b*sizeof(uint32_t),sizeof(len));
+    if (len == 0) {return PCODEC_ERR_DATA;}
+    offset[b+1] = offset[b] + len;
+  }
+  if (offset[nblocks] > cbytes) {return PCODEC_ERR_DATA;}
+
+  unsigned char* out = (unsigned char*) dst;
+  int stat = 0;
+
+  #pragma omp parallel if (nblocks > 1)
+  {
+    std::vector<unsigned char> quant;
+
+    #pragma omp for schedule(dynamic) reduction(min:stat)
+    for (long b=0;b<nblocks;b++)
+    {
+      const long off = b*PCODEC_BLOCK;
+      const long n = (bytes-off < PCODEC_BLOCK) ? bytes-off : PCODEC_BLOCK;
+      const unsigned char* blk = (const unsigned char*) in + offset[b];
+      const int method = blk[0];
+      const long cn = offset[b+1] - offset[b] - 1;
+      blk++;
+
+      int bstat = 0;
+      if (method == PCODEC_M_RAW)
+      {
+        if (cn == n) {memcpy(out+off,blk,n);} else {bstat = PCODEC_ERR_DATA;}
+
+      } else if (method == PCODEC_M_LZ) {
+        if (lz_decompress(blk,cn,out+off,n) != n) {bstat = PCODEC_ERR_DATA;}
+
+      } else if (method == PCODEC_M_QUANT && head.m_codec == PCODEC_LOSSY) {
+        bstat = quant_decode(blk,cn,head.m_tol,(double*) (out+off),n/sizeof(double));
+
+      } else if (method == PCODEC_M_QUANT_LZ && head.m_codec == PCODEC_LOSSY) {
+        const long nx = n/sizeof(double);
+        quant.resize(nx*(sizeof(double)+1));
+        const long qn = lz_decompress(blk,cn,quant.data(),(long) quant.size());
+        if (qn < 0) {bstat = PCODEC_ERR_DATA;}
+        else {bstat = quant_decode(quant.data(),qn,head.m_tol,(double*) (out+off),nx);}
+
+      } else {
+        bstat = PCODEC_ERR_DATA;
+      }
+      if (bstat < stat) {stat = bstat;}
+    }
+  }
+  return stat;
+}
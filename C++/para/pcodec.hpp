@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------
+ * pcodec.hpp
+ *  JHT, October 19, 2026 : created
+ *
+   .hpp file for Pcodec, which compresses the indexes of Pdata lists
+   before they go to disk.
+
+   Codecs
+     PCODEC_NONE	: data is stored as is
+     PCODEC_LZ		: lossless, an LZ4 style byte oriented LZ77
+     PCODEC_LOSSY	: for doubles. Each value is rounded to the nearest
+			  multiple of 2*tol, so it comes back within tol of
+			  where it started. The multiples are delta coded as
+			  variable length integers, and then compressed with
+			  PCODEC_LZ. Values that are not finite, or too large
+			  for the tolerance, are kept exactly
+
+   Data is cut into blocks of PCODEC_BLOCK bytes, which are compressed
+   and decompressed independently, in parallel over OpenMP threads. A
+   block that does not shrink is stored as is. The compressed format is
+
+     Pcodec_head			header
+     uint32_t csize[nblocks]		compressed bytes of each block
+     block 0, block 1, ...		one method byte, then the data
+
+  General usage
+
+  std::vector<char> cbuf;
+  long cbytes = Pcodec::compress(PCODEC_LOSSY,1.e-10,data,bytes,cbuf);
+  ... write cbytes of cbuf ...
+  int stat = Pcodec::decompress(cbuf.data(),cbytes,data,bytes);
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PCODEC_HPP
+#define LIBJ_PCODEC_HPP
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "libjdef.h"
+
+//Codecs
+#define PCODEC_NONE 0
+#define PCODEC_LZ 1
+#define PCODEC_LOSSY 2
+
+#define PCODEC_BLOCK 65536 //bytes of data per block
+
+//Error message integers
+#define PCODEC_ERR_CODEC -1 //unknown codec, or lossy on data that is not doubles
+#define PCODEC_ERR_DATA -2 //compressed data is corrupt or the wrong size
+
+struct Pcodec_head
+{
+  int32_t m_codec;
+  int32_t m_nblocks;
+  int64_t m_bytes;	//bytes of the uncompressed data
+  double  m_tol;	//tolerance of PCODEC_LOSSY
+};
+
+class Pcodec
+{
+  public:
+  //compress bytes of src into dst, which is resized as needed.
+  //  Returns the compressed bytes, or a negative error
+  static long compress(const int codec, const double tol, const void* src,
+                       const long bytes, std::vector<char>& dst);
+
+  //decompress cbytes of src into the bytes of dst, returns 0 or error
+  static int decompress(const void* src, const long cbytes, void* dst,
+                        const long bytes);
+
+  //LZ of one buffer. Compression needs lz_bound(n) bytes of dst, and
+  //  decompression returns the bytes written to dst (at most n)
+  static long lz_bound(const long n) {return n + n/255 + 16;}
+  static long lz_compress(const unsigned char* src, const long n,
+                          unsigned char* dst);
+  static long lz_decompress(const unsigned char* src, const long cn,
+                            unsigned char* dst, const long n);
+
+};
+
+#endif
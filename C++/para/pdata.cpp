@@ -1,10 +1,21 @@
 /*----------------------------------------------------------------------------
   pdata.cpp
 	JHT, Febuary 14, 2022 : created
+	JHT, October 19, 2026 : collective IO of a list to a shared Pmpio file
+	JHT, October 19, 2026 : one-sided get, put, and accumulate of indexes
+	JHT, October 19, 2026 : node shared copies of replicated lists
+	JHT, October 19, 2026 : hash index of list tags
+	JHT, October 19, 2026 : compressed indexes in Pfile storage
+	JHT, October 19, 2026 : windows are read from, and written back to,
+	                        the Pfiles
+	JHT, October 19, 2026 : file reads and writes are checked, and
+	                        free_window keeps shared file storage
 
   .cpp file for Pdata class
 ----------------------------------------------------------------------------*/
 #include "pdata.hpp"
+#include <limits.h>
+#include <string.h>
 
 //----------------------------------------------------------------------------
 // Pdata() constructor
@@ -12,6 +23,9 @@
 Pdata::Pdata()
 {
   m_num_lists=0;
+  m_task_id=0;
+  m_pfile=NULL;
+  m_pmpio=NULL;
 }
 //----------------------------------------------------------------------------
 // list_size
@@ -33,7 +47,7 @@ void Pdata::add_index(const long list_id, const int task_id,
                      const long file_pos, const long index_size)
 {
   m_list_size[list_id]++;
-  m_index[list_id].push_back({task_id,file_pos,index_size});
+  m_index[list_id].push_back({task_id,file_pos,index_size,0});
 }
 
 //----------------------------------------------------------------------------
@@ -90,11 +104,9 @@ void Pdata::print_lists(const Pworld& pworld, Pprint& pprint) const
 //----------------------------------------------------------------------------
 long Pdata::find_list(const long list_tag) const
 {
-  for (long i=0;i<m_num_lists;i++)
-  {
-    if (m_list_tags[i] == list_tag) {return i;}
-  }
-  return -1;
+  return m_tag_index.find(Phash::hash(list_tag),
+                          [&](const long list)
+                          {return m_list_tags[list] == list_tag;});
 }
 
 //----------------------------------------------------------------------------
@@ -113,9 +125,15 @@ long Pdata::add_list(const long list_tag, const int file_id,
   { 
     m_num_lists++;
     m_list_tags.push_back(list_tag);
+    m_tag_index.insert(Phash::hash(list_tag),m_num_lists-1);
     m_list_size.push_back(0);
-    m_list_info.push_back({file_id,bytes});
+    m_list_info.push_back({file_id,bytes,PDATA_STORE_FILE,PDATA_STORE_FILE,-1,PCODEC_NONE,0.0});
     m_index.resize(m_num_lists);
+    m_disp.resize(m_num_lists);
+    #if defined LIBJ_MPI
+    m_win.push_back(MPI_WIN_NULL);
+    #endif
+    m_win_base.push_back(NULL);
     return m_num_lists-1;
   //list does exist, and is the same
   } else if (list_id >= 0 
@@ -130,3 +148,502 @@ long Pdata::add_list(const long list_tag, const int file_id,
   return 0;
 }
 
+
+//----------------------------------------------------------------------------
+// task_bytes
+//	bytes of the indexes of a list stored by task_id
+//----------------------------------------------------------------------------
+long Pdata::task_bytes(const long list_id, const int task_id) const
+{
+  long bytes = 0;
+  const long byteso = m_list_info[list_id].m_bytes;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    if (m_index[list_id][index].m_storage_task == task_id)
+    {
+      bytes += byteso*m_index[list_id][index].m_size;
+    }
+  }
+  return bytes;
+}
+
+//----------------------------------------------------------------------------
+// set_view
+//	sets the view of a Pmpio file to the indexes of a list stored by this
+//	task. Collective
+//----------------------------------------------------------------------------
+int Pdata::set_view(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+                    const long list_id) const
+{
+  const long byteso = m_list_info[list_id].m_bytes;
+  std::vector<long> pos;
+  std::vector<long> len;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    const Pindex_info& info = m_index[list_id][index];
+    if (info.m_storage_task == pworld.mpi_world_task_id)
+    {
+      pos.push_back(info.m_file_pos);
+      len.push_back(byteso*info.m_size);
+    }
+  }
+  return pmpio.set_blocks(mpio_fid,0,(int) pos.size(),pos.data(),len.data());
+}
+
+//----------------------------------------------------------------------------
+// write_all
+//	writes the indexes of a list stored by this task, packed in data in
+//	order of file position, to a Pmpio file. Collective
+//----------------------------------------------------------------------------
+int Pdata::write_all(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+                     const long list_id, const void* data) const
+{
+  int stat = set_view(pworld,pmpio,mpio_fid,list_id);
+  if (stat != 0) {return stat;}
+  stat = pmpio.write_all(mpio_fid,data,
+                         (size_t) task_bytes(list_id,pworld.mpi_world_task_id));
+  const int vstat = pmpio.reset_view(mpio_fid);
+  return (stat != 0) ? stat : vstat;
+}
+
+//----------------------------------------------------------------------------
+// read_all
+//	reads the indexes of a list stored by this task from a Pmpio file.
+//	Collective
+//----------------------------------------------------------------------------
+int Pdata::read_all(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+                    const long list_id, void* data) const
+{
+  int stat = set_view(pworld,pmpio,mpio_fid,list_id);
+  if (stat != 0) {return stat;}
+  stat = pmpio.read_all(mpio_fid,data,
+                        (size_t) task_bytes(list_id,pworld.mpi_world_task_id));
+  const int vstat = pmpio.reset_view(mpio_fid);
+  return (stat != 0) ? stat : vstat;
+}
+
+//----------------------------------------------------------------------------
+// attach
+//	sets the task id and the file systems used for the distributed
+//	storage
+//----------------------------------------------------------------------------
+void Pdata::attach(const Pworld& pworld, Pfile& pfile, Pmpio& pmpio)
+{
+  m_task_id = pworld.mpi_world_task_id;
+  m_pfile = &pfile;
+  m_pmpio = &pmpio;
+}
+
+//----------------------------------------------------------------------------
+// m_check
+//	checks that the list and index exist
+//----------------------------------------------------------------------------
+int Pdata::m_check(const long list_id, const long index) const
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  if (index < 0 || index >= m_list_size[list_id]) {return PDATA_ERR_LIST;}
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// set_shared_file
+//	the list is stored in a Pmpio file shared by all tasks
+//----------------------------------------------------------------------------
+int Pdata::set_shared_file(const long list_id, const int mpio_fid)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  const int store = m_list_info[list_id].m_store;
+  if (store == PDATA_STORE_WIN || store == PDATA_STORE_NODE) {return PDATA_ERR_WIN;}
+  m_list_info[list_id].m_store = PDATA_STORE_SHARED;
+  m_list_info[list_id].m_mpio_fid = mpio_fid;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// set_codec
+//	compress the indexes of a list stored in Pfiles. Indexes already
+//	written keep the format they were written in, and are read back as
+//	such
+//----------------------------------------------------------------------------
+int Pdata::set_codec(const long list_id, const int codec, const double tol)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  if (codec != PCODEC_NONE && codec != PCODEC_LZ && codec != PCODEC_LOSSY)
+  {
+    return PDATA_ERR_CODEC;
+  }
+  if (codec == PCODEC_LOSSY)
+  {
+    if (m_list_info[list_id].m_bytes % sizeof(double) != 0) {return PDATA_ERR_TYPE;}
+    if (!(tol > 0)) {return PDATA_ERR_CODEC;}
+  }
+  m_list_info[list_id].m_codec = codec;
+  m_list_info[list_id].m_tol = tol;
+  return 0;
+}
+
+#if defined LIBJ_MPI
+
+//----------------------------------------------------------------------------
+// create_window
+//	moves the list to in memory storage. Each task allocates a window for
+//	the indexes it stores, and reads them in from the file of the list
+//	(the part of an index past the end of a Pfile is zero). The window is locked
+//	(shared) for all tasks until it is freed. Collective, and the window
+//	is made even if a read fails, the first error is returned
+//----------------------------------------------------------------------------
+int Pdata::create_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  if (m_list_info[list_id].m_store == PDATA_STORE_WIN) {return 0;}
+  if (m_list_info[list_id].m_store == PDATA_STORE_NODE) {return PDATA_ERR_WIN;}
+
+  //displacements of each index in the window of its task
+  std::vector<long> next(pworld.mpi_world_num_tasks,0);
+  m_disp[list_id].resize(m_list_size[list_id]);
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    const int task = m_index[list_id][index].m_storage_task;
+    m_disp[list_id][index] = next[task];
+    next[task] += index_bytes(list_id,index);
+  }
+
+  char* base = NULL;
+  if (MPI_Win_allocate((MPI_Aint) next[pworld.mpi_world_task_id],1,MPI_INFO_NULL,
+                       pworld.comm_world,&base,&m_win[list_id]) != MPI_SUCCESS)
+  {
+    return PDATA_ERR_WIN;
+  }
+  const size_t size = (size_t) next[pworld.mpi_world_task_id];
+  if (size > 0) {memset(base,0,size);}
+  m_win_base[list_id] = base;
+  m_list_info[list_id].m_file_store = m_list_info[list_id].m_store;
+  const int stat = m_window_io(list_id,true);
+
+  //no task gets an index before it is read in
+  MPI_Win_lock_all(0,m_win[list_id]);
+  MPI_Win_sync(m_win[list_id]);
+  MPI_Barrier(pworld.comm_world);
+
+  m_list_info[list_id].m_store = PDATA_STORE_WIN;
+  return stat;
+}
+
+//----------------------------------------------------------------------------
+// create_node_window
+//	moves the list to a single in memory copy per node. The shared root
+//	of each node allocates the whole list in a shared memory window, and
+//	the other tasks of the node map the same memory. Collective
+//----------------------------------------------------------------------------
+int Pdata::create_node_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  if (m_list_info[list_id].m_store == PDATA_STORE_NODE) {return 0;}
+  if (m_list_info[list_id].m_store == PDATA_STORE_WIN) {return PDATA_ERR_WIN;}
+
+  //displacements of each index in the list
+  m_disp[list_id].resize(m_list_size[list_id]);
+  long total = 0;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    m_disp[list_id][index] = total;
+    total += index_bytes(list_id,index);
+  }
+
+  //only the root allocates
+  const MPI_Aint size = (pworld.mpi_shared_task_id == pworld.mpi_shared_root) 
+                      ? (MPI_Aint) total : 0;
+  char* base = NULL;
+  if (MPI_Win_allocate_shared(size,1,MPI_INFO_NULL,pworld.comm_shared,
+                              &base,&m_win[list_id]) != MPI_SUCCESS)
+  {
+    return PDATA_ERR_WIN;
+  }
+
+  //everyone points at the copy of the root
+  MPI_Aint qsize;
+  int      qdisp;
+  MPI_Win_shared_query(m_win[list_id],pworld.mpi_shared_root,&qsize,&qdisp,&base);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,m_win[list_id]);
+
+  m_win_base[list_id] = base;
+  m_list_info[list_id].m_file_store = m_list_info[list_id].m_store;
+  m_list_info[list_id].m_store = PDATA_STORE_NODE;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// node_sync
+//	makes the updates to a node shared list of each task visible to the
+//	others on the node. Collective over comm_shared
+//----------------------------------------------------------------------------
+int Pdata::node_sync(const Pworld& pworld, const long list_id)
+{
+  if (m_list_info[list_id].m_store != PDATA_STORE_NODE) {return PDATA_ERR_WIN;}
+  MPI_Win_sync(m_win[list_id]);
+  MPI_Barrier(pworld.comm_shared);
+  MPI_Win_sync(m_win[list_id]);
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// free_window
+//	writes the indexes this task stores back to the file of the list,
+//	once every task is done with the window, and frees it. The list goes
+//	back to the storage it had before the window. Collective, and the
+//	window is freed even if a write fails, the first error is returned
+//----------------------------------------------------------------------------
+int Pdata::free_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return PDATA_ERR_LIST;}
+  const int store = m_list_info[list_id].m_store;
+  if (store != PDATA_STORE_WIN && store != PDATA_STORE_NODE) {return 0;}
+
+  //every put and accumulate is flushed, wait for them all to land
+  MPI_Win_sync(m_win[list_id]);
+  MPI_Barrier((store == PDATA_STORE_WIN) ? pworld.comm_world : pworld.comm_shared);
+  MPI_Win_sync(m_win[list_id]);
+
+  m_list_info[list_id].m_store = m_list_info[list_id].m_file_store;
+  const int stat = m_window_io(list_id,false);
+
+  MPI_Win_unlock_all(m_win[list_id]);
+  MPI_Win_free(&m_win[list_id]);
+  m_win_base[list_id] = NULL;
+  return stat;
+}
+
+#else
+
+int Pdata::create_window(const Pworld&, const long)
+{
+  return PDATA_ERR_NOMPI;
+}
+
+int Pdata::free_window(const Pworld&, const long)
+{
+  return 0;
+}
+
+int Pdata::create_node_window(const Pworld&, const long)
+{
+  return PDATA_ERR_NOMPI;
+}
+
+int Pdata::node_sync(const Pworld&, const long)
+{
+  return PDATA_ERR_NOMPI;
+}
+
+#endif
+
+//----------------------------------------------------------------------------
+// get
+//	copies an index of a list, stored by any task, into buf
+//----------------------------------------------------------------------------
+int Pdata::get(const long list_id, const long index, void* buf)
+{
+  int stat = m_check(list_id,index);
+  if (stat != 0) {return stat;}
+
+  const Pindex_info& info = m_index[list_id][index];
+  const long bytes = index_bytes(list_id,index);
+
+  switch (m_list_info[list_id].m_store)
+  {
+    #if defined LIBJ_MPI
+    case PDATA_STORE_WIN:
+      if (bytes > INT_MAX) {return PDATA_ERR_WIN;}
+      if (MPI_Get(buf,(int) bytes,MPI_BYTE,info.m_storage_task,
+                  (MPI_Aint) m_disp[list_id][index],(int) bytes,MPI_BYTE,
+                  m_win[list_id]) != MPI_SUCCESS) {return PDATA_ERR_WIN;}
+      MPI_Win_flush(info.m_storage_task,m_win[list_id]);
+      return 0;
+    #endif
+
+    case PDATA_STORE_NODE:
+      memcpy(buf,node_data(list_id,index),(size_t) bytes);
+      return 0;
+
+    case PDATA_STORE_SHARED:
+      if (m_pmpio == NULL) {return PDATA_ERR_IO;}
+      stat = m_pmpio->xread_at(m_list_info[list_id].m_mpio_fid,info.m_file_pos,
+                               buf,1,(size_t) bytes);
+      return (stat == 0) ? 0 : PDATA_ERR_IO;
+
+    default:
+      return m_file_get(list_id,index,buf);
+  }
+}
+
+//----------------------------------------------------------------------------
+// put
+//	copies buf into an index of a list, stored by any task
+//----------------------------------------------------------------------------
+int Pdata::put(const long list_id, const long index, const void* buf)
+{
+  int stat = m_check(list_id,index);
+  if (stat != 0) {return stat;}
+
+  Pindex_info& info = m_index[list_id][index];
+  const long bytes = index_bytes(list_id,index);
+
+  switch (m_list_info[list_id].m_store)
+  {
+    #if defined LIBJ_MPI
+    case PDATA_STORE_WIN:
+      if (bytes > INT_MAX) {return PDATA_ERR_WIN;}
+      if (MPI_Put(buf,(int) bytes,MPI_BYTE,info.m_storage_task,
+                  (MPI_Aint) m_disp[list_id][index],(int) bytes,MPI_BYTE,
+                  m_win[list_id]) != MPI_SUCCESS) {return PDATA_ERR_WIN;}
+      MPI_Win_flush(info.m_storage_task,m_win[list_id]);
+      return 0;
+    #endif
+
+    case PDATA_STORE_NODE:
+      memcpy(node_data(list_id,index),buf,(size_t) bytes);
+      return 0;
+
+    case PDATA_STORE_SHARED:
+      if (m_pmpio == NULL) {return PDATA_ERR_IO;}
+      stat = m_pmpio->xwrite_at(m_list_info[list_id].m_mpio_fid,info.m_file_pos,
+                                buf,1,(size_t) bytes);
+      return (stat == 0) ? 0 : PDATA_ERR_IO;
+
+    default:
+      return m_file_put(list_id,index,buf);
+  }
+}
+
+//----------------------------------------------------------------------------
+// m_file_get
+//	reads an index from the Pfile of this task. Indexes stored in the
+//	Pfile of another task are not forwarded, PDATA_ERR_REMOTE
+//----------------------------------------------------------------------------
+int Pdata::m_file_get(const long list_id, const long index, void* buf)
+{
+  const Pindex_info& info = m_index[list_id][index];
+  const long bytes = index_bytes(list_id,index);
+  const int fid = m_list_info[list_id].m_file_id;
+
+  if (info.m_storage_task != m_task_id || m_pfile == NULL) {return PDATA_ERR_REMOTE;}
+  if (!m_pfile->xisopen(fid)) {return PDATA_ERR_IO;}
+  if (info.m_csize > 0)
+  {
+    std::vector<char> cbuf(info.m_csize);
+    if (m_pfile->read(fid,info.m_file_pos,cbuf.data(),1,(size_t) info.m_csize) != 0)
+    {
+      return PDATA_ERR_IO;
+    }
+    const int stat = Pcodec::decompress(cbuf.data(),info.m_csize,buf,bytes);
+    return (stat == 0) ? 0 : PDATA_ERR_CODEC;
+  }
+  //the part past the end of the file was never written, and is zero
+  const int stat = m_pfile->read(fid,info.m_file_pos,buf,1,(size_t) bytes);
+  return (stat == 0 || stat == PFILE_ERR_EOF) ? 0 : PDATA_ERR_IO;
+}
+
+//----------------------------------------------------------------------------
+// m_file_put
+//	writes an index to the Pfile of this task, compressed if the list has
+//	a codec. Indexes stored in the Pfile of another task are not
+//	forwarded, PDATA_ERR_REMOTE
+//----------------------------------------------------------------------------
+int Pdata::m_file_put(const long list_id, const long index, const void* buf)
+{
+  Pindex_info& info = m_index[list_id][index];
+  const long bytes = index_bytes(list_id,index);
+  const int fid = m_list_info[list_id].m_file_id;
+
+  if (info.m_storage_task != m_task_id || m_pfile == NULL) {return PDATA_ERR_REMOTE;}
+  if (!m_pfile->xisopen(fid)) {return PDATA_ERR_IO;}
+  if (m_list_info[list_id].m_codec != PCODEC_NONE)
+  {
+    std::vector<char> cbuf;
+    const long csize = Pcodec::compress(m_list_info[list_id].m_codec,
+                                        m_list_info[list_id].m_tol,
+                                        buf,bytes,cbuf);
+    if (csize < 0) {return PDATA_ERR_CODEC;}
+    if (csize < bytes)
+    {
+      if (m_pfile->write(fid,info.m_file_pos,cbuf.data(),1,(size_t) csize) != 0)
+      {
+        return PDATA_ERR_IO;
+      }
+      info.m_csize = csize;
+      return 0;
+    }
+  }
+  if (m_pfile->write(fid,info.m_file_pos,buf,1,(size_t) bytes) != 0) {return PDATA_ERR_IO;}
+  info.m_csize = 0;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// m_window_io
+//	moves the indexes this task stores between the file of the list (its
+//	Pfile, or the shared Pmpio file) and the memory of a window, reading
+//	them in when load, and writing them back otherwise. The list is in
+//	its file storage while this runs. Returns the first error, after
+//	trying every index
+//----------------------------------------------------------------------------
+int Pdata::m_window_io(const long list_id, const bool load)
+{
+  const bool shared = (m_list_info[list_id].m_store == PDATA_STORE_SHARED);
+  const int mpio_fid = m_list_info[list_id].m_mpio_fid;
+  if (shared && m_pmpio == NULL) {return PDATA_ERR_IO;}
+  int first = 0;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    if (m_index[list_id][index].m_storage_task != m_task_id) {continue;}
+    char* data = m_win_base[list_id] + m_disp[list_id][index];
+    int stat;
+    if (shared)
+    {
+      const long pos = m_index[list_id][index].m_file_pos;
+      const size_t bytes = (size_t) index_bytes(list_id,index);
+      stat = load ? m_pmpio->xread_at(mpio_fid,pos,data,1,bytes)
+                  : m_pmpio->xwrite_at(mpio_fid,pos,data,1,bytes);
+      if (stat != 0) {stat = PDATA_ERR_IO;}
+    } else {
+      stat = load ? m_file_get(list_id,index,data)
+                  : m_file_put(list_id,index,data);
+    }
+    if (stat != 0 && first == 0) {first = stat;}
+  }
+  return first;
+}
+
+//----------------------------------------------------------------------------
+// accumulate
+//	adds the doubles of buf into an index of a list, stored by any task.
+//	This is atomic for windows only, as files have no atomic update
+//----------------------------------------------------------------------------
+int Pdata::accumulate(const long list_id, const long index, const double* buf)
+{
+  int stat = m_check(list_id,index);
+  if (stat != 0) {return stat;}
+  if (m_list_info[list_id].m_bytes % sizeof(double) != 0) {return PDATA_ERR_TYPE;}
+
+  const Pindex_info& info = m_index[list_id][index];
+  const long num = index_bytes(list_id,index) / (long) sizeof(double);
+
+  #if defined LIBJ_MPI
+  if (m_list_info[list_id].m_store == PDATA_STORE_WIN)
+  {
+    if (num > INT_MAX) {return PDATA_ERR_WIN;}
+    if (MPI_Accumulate(buf,(int) num,MPI_DOUBLE,info.m_storage_task,
+                       (MPI_Aint) m_disp[list_id][index],(int) num,MPI_DOUBLE,
+                       MPI_SUM,m_win[list_id]) != MPI_SUCCESS) {return PDATA_ERR_WIN;}
+    MPI_Win_flush(info.m_storage_task,m_win[list_id]);
+    return 0;
+  }
+  #endif
+
+  //read, add, write
+  std::vector<double> tmp(num);
+  stat = get(list_id,index,tmp.data());
+  if (stat != 0) {return stat;}
+  for (long i=0;i<num;i++) {tmp[i] += buf[i];}
+  return put(list_id,index,tmp.data());
+}
@@ -1,6 +1,13 @@
 /*----------------------------------------------------------------------------
   pdata.hpp
 	JHT, Febuary 13, 2022 : created
+	JHT, October 19, 2026 : collective IO of a list to a shared Pmpio file
+	JHT, October 19, 2026 : one-sided get, put, and accumulate of indexes
+	JHT, October 19, 2026 : node shared copies of replicated lists
+	JHT, October 19, 2026 : hash index of list tags
+	JHT, October 19, 2026 : compressed indexes in Pfile storage
+	JHT, October 19, 2026 : windows are read from, and written back to,
+	                        the Pfiles
 
   .hpp file for pdata class, which manages lists of data
 
@@ -15,6 +22,77 @@
     responsible for which index. We assume that the list structure isn't going
     to be changing during compute heavy routines, so that the memory and synch
     overhead between threads isn't so much of an issue
+
+  Shared files
+  ---------------------
+  - write_all and read_all move all of the indexes of a list that this
+    task stores, in one collective call, to or from a Pmpio file shared
+    by all tasks. Here m_file_pos is the byte position of the index in
+    the shared file, and the buffer holds the indexes of this task packed
+    in order of their position
+
+  Distributed storage
+  ---------------------
+  - get, put, and accumulate move one index of a list between any task
+    and this one, without the storing task taking part. Where the data
+    lives depends on the storage of the list
+      PDATA_STORE_FILE	: in the Pfile of the storing task (the default).
+			  Only the storing task can access it, when it does
+			  the IO of its node. Requests are not forwarded,
+			  other tasks get PDATA_ERR_REMOTE, and should move
+			  the list to a window instead
+      PDATA_STORE_WIN	: in memory, in an MPI-3 RMA window. Each task
+			  holds the indexes it stores, packed in index order.
+			  Accessed with passive target get/put/accumulate
+      PDATA_STORE_SHARED: in a Pmpio file shared by all tasks, at
+			  m_file_pos. Accessed with independent MPI-IO
+      PDATA_STORE_NODE	: all indexes in memory, one copy per node in an
+			  MPI-3 shared memory window on comm_shared. Every
+			  task of the node reads the same physical copy
+			  (node_data), and get and put are plain copies
+  - indexes must be added before create_window, which (like free_window)
+    is collective
+  - create_window reads the indexes of each task in from the file the
+    list is stored in (its Pfile, or the shared Pmpio file), and
+    free_window writes them back, after every task has finished with the
+    window, and returns the list to that storage. A node window is not
+    read in, it is filled by the tasks, and on free_window each index is
+    written back by its storing task from the copy of its node. The file
+    of the list must be open on the storing tasks, or these return
+    PDATA_ERR_IO (the window is still made, or freed)
+  - a failed read or write of a file returns PDATA_ERR_IO. The part of
+    an index past the end of its Pfile reads as zero
+  - accumulate sums doubles into the index, atomically for PDATA_STORE_WIN
+  - an index is moved whole, and the buffer must hold m_size elements
+
+  Compression
+  ---------------------
+  - set_codec makes put compress, and get decompress, the indexes of a
+    list stored in Pfiles (PDATA_STORE_FILE), see pcodec.hpp. Either
+    lossless (PCODEC_LZ), or for doubles, to within a tolerance
+    (PCODEC_LOSSY). The compressed index is written at the start of its
+    slot at m_file_pos, and m_csize records its size. The rest of the
+    slot is not written, so it stays a hole in filesystems with sparse
+    files. An index that does not shrink is written as is (m_csize = 0)
+  - the compressed copy is held in a buffer local to each get and put,
+    so they keep no scratch state between calls
+  - other storage ignores the codec
+
+  Usage example:
+    pdata.attach(pworld,pfile,pmpio);
+    pdata.create_window(pworld,list_id);
+    double* mine = (double*) pdata.local_data(list_id);
+    ... fill the indexes this task stores, then a barrier ...
+    pdata.get(list_id,index,buf);
+    pdata.accumulate(list_id,index,buf);
+    pdata.free_window(pworld,list_id);
+
+  Replicated data, one copy per node:
+    pdata.create_node_window(pworld,list_id);
+    double* x = (double*) pdata.node_data(list_id,index);
+    ... one task per node fills (or each fills its share) ...
+    pdata.node_sync(pworld,list_id);	//collective over comm_shared
+    pdata.free_window(pworld,list_id);
 ----------------------------------------------------------------------------*/
 #ifndef LIBJ_PDATA_HPP
 #define LIBJ_PDATA_HPP
@@ -24,7 +102,10 @@
 
 #include "pworld.hpp"
 #include "pfile.hpp"
+#include "pmpio.hpp"
 #include "pprint.hpp"
+#include "phash.hpp"
+#include "pcodec.hpp"
 
 //----------------------------------------------------------------------------
 // Plist_info
@@ -35,19 +116,41 @@ struct Plist_info
 {
   int        m_file_id;
   std::size_t m_bytes;
+  int        m_store;
+  int        m_file_store; //storage under a window, FILE or SHARED
+  int        m_mpio_fid;
+  int        m_codec;
+  double     m_tol;
 };
 
+//storage of a list
+#define PDATA_STORE_FILE 0
+#define PDATA_STORE_WIN 1
+#define PDATA_STORE_SHARED 2
+#define PDATA_STORE_NODE 3
+
+//Error message integers
+#define PDATA_ERR_LIST -1 //list or index does not exist
+#define PDATA_ERR_REMOTE -2 //data is in the Pfile of another task
+#define PDATA_ERR_NOMPI -3 //built without MPI
+#define PDATA_ERR_WIN -4 //window could not be made or accessed
+#define PDATA_ERR_IO -5 //file read or write failed
+#define PDATA_ERR_TYPE -6 //list elements are not doubles
+#define PDATA_ERR_CODEC -7 //unknown codec, or compressed data is corrupt
+
 //----------------------------------------------------------------------------
 // Pindex_info
 //	m_storage_task	which task is in charge of storing this index
 //	m_file_pos	location of this index in the relevant file	
 //	m_size		number of elements
+//	m_csize		compressed bytes on disk, 0 if stored as is
 //----------------------------------------------------------------------------
 struct Pindex_info
 {
   int  m_storage_task;
   long m_file_pos;
   long m_size;
+  long m_csize;
 };
 
 //----------------------------------------------------------------------------
@@ -56,16 +159,34 @@ struct Pindex_info
 // list_info tracks file ids and element bytes for each list
 // list_size tracks the number of indexes of each list
 // list_tags  stores an external tag of a particular list 
+// disp	stores the byte displacement of each index in the window of the
+//	task which stores it
 //----------------------------------------------------------------------------
 class Pdata
 {
   private:
   long                    m_num_lists;
   std::vector<long>       m_list_tags;
+  Phash                   m_tag_index;  //hash index of m_list_tags
   std::vector<long>       m_list_size; 
   std::vector<Plist_info> m_list_info;
 
   std::vector<std::vector<Pindex_info>> m_index;
+  std::vector<std::vector<long>>        m_disp;
+
+  //distributed storage
+  int                     m_task_id;
+  Pfile*                  m_pfile;
+  Pmpio*                  m_pmpio;
+  #if defined LIBJ_MPI
+  std::vector<MPI_Win>    m_win;
+  #endif
+  std::vector<char*>      m_win_base;
+
+  int m_check(const long list_id, const long index) const;
+  int m_file_get(const long list_id, const long index, void* buf);
+  int m_file_put(const long list_id, const long index, const void* buf);
+  int m_window_io(const long list_id, const bool load);
 
   public:
 
@@ -88,6 +209,55 @@ class Pdata
                  const long file_pos, const long index_size);
 
   long list_bytes(const long list_id) const;
+
+  //number of indexes of a list, and their info
+  long num_index(const long list_id) const {return m_list_size[list_id];}
+  const Pindex_info& index_info(const long list_id, const long index) const
+  {
+    return m_index[list_id][index];
+  }
+
+  //bytes of a list stored by a task
+  long task_bytes(const long list_id, const int task_id) const;
+
+  //collective IO of the indexes of a list stored by this task
+  int set_view(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+               const long list_id) const;
+  int write_all(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+                const long list_id, const void* data) const;
+  int read_all(const Pworld& pworld, Pmpio& pmpio, const int mpio_fid,
+               const long list_id, void* data) const;
+
+  //distributed storage
+  void attach(const Pworld& pworld, Pfile& pfile, Pmpio& pmpio);
+  int create_window(const Pworld& pworld, const long list_id);
+  int free_window(const Pworld& pworld, const long list_id);
+  int create_node_window(const Pworld& pworld, const long list_id);
+  int node_sync(const Pworld& pworld, const long list_id);
+  void* node_data(const long list_id, const long index)
+  {
+    return m_win_base[list_id] + m_disp[list_id][index];
+  }
+  int set_shared_file(const long list_id, const int mpio_fid);
+  int storage(const long list_id) const {return m_list_info[list_id].m_store;}
+  void* local_data(const long list_id) {return m_win_base[list_id];}
+  long index_bytes(const long list_id, const long index) const
+  {
+    return m_list_info[list_id].m_bytes*m_index[list_id][index].m_size;
+  }
+
+  //compression of indexes stored in Pfiles
+  int set_codec(const long list_id, const int codec, const double tol);
+  int codec(const long list_id) const {return m_list_info[list_id].m_codec;}
+  long stored_bytes(const long list_id, const long index) const
+  {
+    const long csize = m_index[list_id][index].m_csize;
+    return (csize > 0) ? csize : index_bytes(list_id,index);
+  }
+
+  int get(const long list_id, const long index, void* buf);
+  int put(const long list_id, const long index, const void* buf);
+  int accumulate(const long list_id, const long index, const double* buf);
 };
 
 #endif
@@ -1,10 +1,19 @@
 /*------------------------------------------------------------------------
  * pfile.cpp
  *  JHT, Febuary 8, 2022 : created
+ *  JHT, October 19, 2026 : asynchronous awrite and aread
+ *  JHT, October 19, 2026 : memory mapped block access
+ *  JHT, October 19, 2026 : asynchronous errors reported, no renumbering
+ *                          of files with outstanding requests
+ *  JHT, October 19, 2026 : write only files are not mapped
  *
  *  .hpp file for Pfile, which handles a (possibly parallel) filesystem
 ------------------------------------------------------------------------*/
 #include "pfile.hpp"
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
 
 //-----------------------------------------------------------------------
 // Constructor
@@ -13,6 +22,7 @@ Pfile::Pfile()
 {
   m_fio.reserve(PFILE_RES);
   m_isopen.reserve(PFILE_RES);
+  m_map.reserve(PFILE_RES);
   m_fname.reserve(PFILE_RES);
   m_fstat.reserve(PFILE_RES);
   m_nfiles = 0;
@@ -26,6 +36,7 @@ Pfile::~Pfile()
 {
   //close all in the future
   xclose_all();
+  m_pio.destroy();
 }
 
 //-----------------------------------------------------------------------
@@ -171,7 +182,9 @@ int Pfile::xadd(const char* fname)
     m_nfiles++;
     m_isopen.push_back({false});  
     m_fio.push_back({NULL,0});
+    m_map.push_back({NULL,0,false});
     m_fname.push_back(fname);
+    m_index.insert(Phash::hash(fname),m_nfiles-1);
     m_fstat.push_back("c");
     return m_nfiles-1; 
 }
@@ -229,15 +242,32 @@ int Pfile::remove(const Pworld& pworld, const int fid)
 //-----------------------------------------------------------------------
 int Pfile::xremove(const int fid)
 {
-  if (m_fio[fid].fptr != NULL) {fclose(m_fio[fid].fptr);}
+  //the file ids after fid shift down, which would move the asynchronous
+  //  requests and errors of those files onto others
+  if (m_pio.isinit() && !m_pio.idle()) {return PFILE_ERR_ASYNC;}
+  if (xisopen(fid)) {xclose(fid);}
   m_fio.erase(m_fio.begin()+fid);
+  m_map.erase(m_map.begin()+fid);
   m_isopen.erase(m_isopen.begin()+fid);
   m_fname.erase(fid);
   m_fstat.erase(fid);
   m_nfiles--;
+  m_reindex();
   return 0;
 }
 
+//-----------------------------------------------------------------------
+// m_reindex -- rebuild the hash index of the file names
+//-----------------------------------------------------------------------
+void Pfile::m_reindex()
+{
+  m_index.clear();
+  for (int file=0;file<m_nfiles;file++)
+  {
+    m_index.insert(Phash::hash(m_fname[file]),file);
+  }
+}
+
 //-----------------------------------------------------------------------
 // open -- opens a file with external name. Returns internal file ID
 //  or negative error if something goes wrong 
@@ -415,6 +445,8 @@ int Pfile::xclose(const int fid)
   //if file is open 
   if (xisopen(fid))
   {
+    const int astat = m_pio.isinit() ? m_pio.wait_file(fid) : 0;
+    if (m_map[fid].ptr != NULL) {unmap(fid);}
     stat = fclose(m_fio[fid].fptr);
     m_fio[fid].fptr = NULL;
     m_fio[fid].fpos = 0;
@@ -422,6 +454,7 @@ int Pfile::xclose(const int fid)
     strncpy(m_fstat[fid],"c",PFILE_LEN);
   
     if (stat != 0) {stat = PFILE_ERR_CLOSE;}
+    else if (astat != 0) {stat = PFILE_ERR_ASYNC;}
 
   //File is closed
   } else {
@@ -473,6 +506,7 @@ int Pfile::erase(const Pworld& pworld, const int fid)
 //-----------------------------------------------------------------------
 int Pfile::xerase(const int fid)
 {
+  if (m_pio.isinit() && !m_pio.idle()) {return PFILE_ERR_ASYNC;}
   int stat = xclose(fid);   
   //if (stat != 0) {return stat;}
   stat += remove(m_fname[fid]); //C remove function
@@ -532,34 +566,223 @@ int Pfile::file_loc(const Pworld& pworld, const char* fname) const
 //-----------------------------------------------------------------------
 int Pfile::xfile_loc(const char* fname) const
 {
-  int loc = -1;
-  for (int file=0;file<m_nfiles;file++)
-  {
-    if (strcmp(fname,m_fname[file]) == 0) {return file;}
-  }
-  return loc;
+  return (int) m_index.find(Phash::hash(fname),
+                           [&](const long file)
+                           {return strcmp(fname,m_fname[file]) == 0;});
 }
 
 //-----------------------------------------------------------------------
 // write -- write bytes to file
 //-----------------------------------------------------------------------
-void Pfile::write(const int file, const long pos, const void* data, 
-                  const size_t size, const size_t num)
+int Pfile::write(const int file, const long pos, const void* data, 
+                 const size_t size, const size_t num)
 {
+  if (m_pio.isinit() && m_pio.pending(file)) {m_pio.wait_idle(file);}
   seek(file,pos); //this updates m_fio[file].fpos
-  fwrite(data,size,num,m_fio[file].fptr);
-  m_fio[file].fpos += (long) size*num;
+  const size_t n = fwrite(data,size,num,m_fio[file].fptr);
+  m_fio[file].fpos += (long) (size*n);
+  if (n == num) {return 0;}
+  clearerr(m_fio[file].fptr);
+  m_fio[file].fpos = -1; //unknown, the next access seeks
+  return PFILE_ERR_IO;
 }
 
 //-----------------------------------------------------------------------
-// read -- read bytes from file
+// read -- read bytes from file, the part past the end of the file is
+//   zeroed
 //-----------------------------------------------------------------------
-void Pfile::read(const int file, const long pos, void* data, 
-                  const size_t size, const size_t num)
+int Pfile::read(const int file, const long pos, void* data, 
+                const size_t size, const size_t num)
 {
+  if (m_pio.isinit() && m_pio.pending(file)) {m_pio.wait_idle(file);}
   seek(file,pos);
-  fread(data,size,num,m_fio[file].fptr);
-  m_fio[file].fpos += (long) size*num;
+  const size_t n = fread(data,size,num,m_fio[file].fptr);
+  m_fio[file].fpos += (long) (size*n);
+  if (n == num) {return 0;}
+  const int err = ferror(m_fio[file].fptr) ? PFILE_ERR_IO : PFILE_ERR_EOF;
+  clearerr(m_fio[file].fptr);
+  m_fio[file].fpos = -1; //a partial element may have been read
+  memset((char*) data + size*n,0,size*(num-n));
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// async_init -- start the IO threads on tasks that do IO
+//-----------------------------------------------------------------------
+int Pfile::async_init(const Pworld& pworld, const int nthreads)
+{
+  if (pworld.mpi_doesIO)
+  {
+    return (m_pio.init(nthreads) == 0) ? 0 : PFILE_ERR_ASYNC;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// awrite -- queue a write of bytes to file. The FILE buffer is flushed
+//   first, and the FILE position is invalidated, so the next synchronous
+//   call seeks (and drops any stale buffered data)
+//-----------------------------------------------------------------------
+Pio_handle Pfile::awrite(const int file, const long pos, const void* data,
+                         const size_t size, const size_t num)
+{
+  fflush(m_fio[file].fptr);
+  m_fio[file].fpos = -1;
+  return m_pio.write(file,fileno(m_fio[file].fptr),pos,data,size*num);
+}
+
+//-----------------------------------------------------------------------
+// aread -- queue a read of bytes from file
+//-----------------------------------------------------------------------
+Pio_handle Pfile::aread(const int file, const long pos, void* data,
+                        const size_t size, const size_t num)
+{
+  fflush(m_fio[file].fptr);
+  m_fio[file].fpos = -1;
+  return m_pio.read(file,fileno(m_fio[file].fptr),pos,data,size*num);
+}
+
+//-----------------------------------------------------------------------
+// wait -- wait on an asynchronous request
+//-----------------------------------------------------------------------
+int Pfile::wait(const Pio_handle& handle)
+{
+  return (m_pio.wait(handle) == 0) ? 0 : PFILE_ERR_ASYNC;
+}
+
+//-----------------------------------------------------------------------
+// wait_file -- wait on all asynchronous requests of a file
+//-----------------------------------------------------------------------
+int Pfile::wait_file(const int file)
+{
+  return (m_pio.wait_file(file) == 0) ? 0 : PFILE_ERR_ASYNC;
+}
+
+//-----------------------------------------------------------------------
+// wait_all -- wait on all asynchronous requests
+//-----------------------------------------------------------------------
+int Pfile::wait_all()
+{
+  return (m_pio.wait_all() == 0) ? 0 : PFILE_ERR_ASYNC;
+}
+
+//-----------------------------------------------------------------------
+// map -- map an open file into memory, with an access pattern advice
+//   and (if huge) a request for transparent huge pages. Outstanding
+//   asynchronous IO is finished and the FILE buffer is flushed first
+//-----------------------------------------------------------------------
+int Pfile::map(const int file, const int advice, const bool huge)
+{
+  if (!xisopen(file)) {return PFILE_ERR_MAP;}
+  if (m_map[file].ptr != NULL) {unmap(file);}
+  if (m_pio.isinit()) {m_pio.wait_idle(file);}
+  fflush(m_fio[file].fptr);
+  m_fio[file].fpos = -1;
+
+  //"r" is mapped read only, and "+" modes read and write. "w" and "a"
+  //  descriptors are write only, which mmap cannot use
+  const char* fstat_str = m_fstat[file];
+  const bool write = strchr(fstat_str,'+') != NULL;
+  if (!write && fstat_str[0] != 'r') {return PFILE_ERR_WONLY;}
+
+  const int fd = fileno(m_fio[file].fptr);
+  struct stat st;
+  if (fstat(fd,&st) != 0 || st.st_size <= 0) {return PFILE_ERR_MAP;}
+
+  const size_t len = (size_t) st.st_size;
+  void* ptr = mmap(NULL,len,write ? PROT_READ | PROT_WRITE : PROT_READ,
+                   MAP_SHARED,fd,0);
+  if (ptr == MAP_FAILED) {return PFILE_ERR_MAP;}
+
+  m_map[file].ptr   = (char*) ptr;
+  m_map[file].len   = len;
+  m_map[file].write = write;
+
+  //hints, failures are ignored
+  advise(file,0,len,advice);
+  #if defined (MADV_HUGEPAGE)
+  if (huge) {madvise(ptr,len,MADV_HUGEPAGE);}
+  #endif
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// remap -- map the file again, to pick up a change in its size.
+//   Pointers from the old mapping are no longer valid
+//-----------------------------------------------------------------------
+int Pfile::remap(const int file)
+{
+  return map(file,PFILE_MAP_NORMAL,false);
+}
+
+//-----------------------------------------------------------------------
+// unmap -- write back (if writable) and remove the mapping
+//-----------------------------------------------------------------------
+int Pfile::unmap(const int file)
+{
+  int stat = 0;
+  if (m_map[file].ptr == NULL) {return 0;}
+  if (m_map[file].write && msync(m_map[file].ptr,m_map[file].len,MS_SYNC) != 0)
+  {
+    stat = PFILE_ERR_MAP;
+  }
+  if (munmap(m_map[file].ptr,m_map[file].len) != 0) {stat = PFILE_ERR_MAP;}
+  m_map[file].ptr = NULL;
+  m_map[file].len = 0;
+  m_map[file].write = false;
+  return stat;
+}
+
+//-----------------------------------------------------------------------
+// map_block -- pointer to bytes at pos of a file, mapping the file if
+//   needed. NULL if the block is outside of the mapping
+//-----------------------------------------------------------------------
+void* Pfile::map_block(const int file, const long pos, const size_t bytes)
+{
+  if (m_map[file].ptr == NULL && map(file,PFILE_MAP_NORMAL,false) != 0)
+  {
+    return NULL;
+  }
+  if (pos < 0 || (size_t) pos + bytes > m_map[file].len) {return NULL;}
+  return m_map[file].ptr + pos;
+}
+
+//-----------------------------------------------------------------------
+// advise -- access pattern advice for a block of a mapped file
+//-----------------------------------------------------------------------
+int Pfile::advise(const int file, const long pos, const size_t bytes,
+                  const int advice)
+{
+  if (m_map[file].ptr == NULL) {return PFILE_ERR_MAP;}
+
+  int flag;
+  switch (advice)
+  {
+    case PFILE_MAP_SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+    case PFILE_MAP_RANDOM:     flag = MADV_RANDOM;     break;
+    default:                   flag = MADV_NORMAL;     break;
+  }
+
+  //madvise needs a page aligned start
+  const size_t page  = (size_t) sysconf(_SC_PAGESIZE);
+  const size_t start = ((size_t) pos / page) * page;
+  if (start >= m_map[file].len) {return PFILE_ERR_MAP;}
+  const size_t len   = std::min(m_map[file].len - start,bytes + (size_t) pos - start);
+  return (madvise(m_map[file].ptr + start,len,flag) == 0) ? 0 : PFILE_ERR_MAP;
+}
+
+//-----------------------------------------------------------------------
+// prefetch -- start reading a block of a mapped file into memory
+//-----------------------------------------------------------------------
+int Pfile::prefetch(const int file, const long pos, const size_t bytes)
+{
+  if (m_map[file].ptr == NULL) {return PFILE_ERR_MAP;}
+  const size_t page  = (size_t) sysconf(_SC_PAGESIZE);
+  const size_t start = ((size_t) pos / page) * page;
+  if (start >= m_map[file].len) {return PFILE_ERR_MAP;}
+  const size_t len   = std::min(m_map[file].len - start,bytes + (size_t) pos - start);
+  return (madvise(m_map[file].ptr + start,len,MADV_WILLNEED) == 0) ? 0 : PFILE_ERR_MAP;
 }
 
 //-----------------------------------------------------------------------
@@ -683,6 +906,7 @@ int Pfile::recover(const Pworld& pworld)
 
     //resize vectors to 
     m_fio.resize(m_nfiles);
+    m_map.resize(m_nfiles,{NULL,0,false});
     m_isopen.resize(m_nfiles);
     m_fname.resize(m_nfiles);
     m_fstat.resize(m_nfiles);
@@ -690,6 +914,7 @@ int Pfile::recover(const Pworld& pworld)
     //read the vector data
     read(m_rootid,get_pos(m_rootid),m_fname[0],
          sizeof(char)*m_fname.maxlen(),m_nfiles); 
+    m_reindex();
 
     //Close file
     if (xclose(m_rootid) != 0) {return PFILE_ERR_CLOSE;}
@@ -1,6 +1,12 @@
 /*------------------------------------------------------------------------
  * pfile.hpp
  *  JHT, Febuary 8, 2022: created
+ *  JHT, October 19, 2026: asynchronous awrite and aread (see pio.hpp)
+ *  JHT, October 19, 2026: memory mapped block access
+ *  JHT, October 19, 2026: hash index of file names
+ *  JHT, October 19, 2026: asynchronous errors reported by the waits
+ *  JHT, October 19, 2026: write only files are not mapped
+ *  JHT, October 19, 2026: write and read return a status
  *
    .hpp file for Pfile, which handles a (possibly parallel) filesystem
    Also contains the PFIO struct, which 
@@ -25,6 +31,41 @@
     called by any MPI task (as can the "s" subroutines).
   The "unsafe" subroutines, those that begin with "x", and write,read,
     seek, get_pos, should only be called by a task which does the IO. 
+
+  Asynchronous IO
+    async_init must be called (by all tasks) before awrite and aread.
+    These return right away with a Pio_handle, and the IO is done by a
+    pool of IO threads, which coalesce adjacent requests on a file.
+    Synchronous write, read, and close wait on the outstanding requests
+    of that file first, so the two can be mixed on one file. wait_file
+    and wait_all report the first failed request they cover (close
+    reports those of its file). Removing or erasing a file renumbers
+    the files after it, so it fails with PFILE_ERR_ASYNC while requests
+    are outstanding or have unreported errors. Call wait_all first.
+
+  pfile.async_init(pworld,4);
+  Pio_handle h = pfile.awrite(fid,pos,data,sizeof(double),n);
+  ... compute ...
+  pfile.wait(h);
+  pfile.wait_file(fid);
+  pfile.wait_all();
+
+  Memory mapped IO
+    An open file can be mapped, after which map_block returns pointers
+    directly into the file (no copy, no extra buffer). Files opened read
+    only ("r","rb") are mapped read only, and "+" modes are mapped shared
+    and writable. Write only files ("w","a") cannot be mapped, map
+    returns PFILE_ERR_WONLY, so open them with "w+" or "a+" instead. The
+    mapping covers the file as it was when mapped, so blocks past that
+    end return NULL, and remap picks up a file that has grown. Pointers
+    are valid until unmap, remap, or close. Synchronous writes to a
+    mapped file are seen through the mapping once the file is flushed.
+
+  pfile.map(fid,PFILE_MAP_SEQUENTIAL,false);	//advice, huge pages
+  const double* x = (const double*) pfile.map_block(fid,pos,bytes);
+  pfile.prefetch(fid,next_pos,bytes);		//start reading the next block
+  pfile.advise(fid,pos,bytes,PFILE_MAP_RANDOM);
+  pfile.unmap(fid);				//also done by close
  
 ------------------------------------------------------------------------*/
 #ifndef LIBJ_PFILE_HPP
@@ -32,6 +73,8 @@
 #include "strvec.hpp"
 #include "pprint.hpp"
 #include "pworld.hpp"
+#include "pio.hpp"
+#include "phash.hpp"
 #include <vector>
 #include <stdio.h>
 /*
@@ -46,6 +89,19 @@ struct Pfio
 };
 #endif
 
+/*
+ * Plain old data for a memory mapping of a file
+*/
+#ifndef PMAP_HPP
+#define PMAP_HPP
+struct Pmap
+{
+  char*  ptr;   //start of mapping, NULL if not mapped
+  size_t len;   //length of mapping
+  bool   write; //mapped writable
+};
+#endif
+
 /*
  * Pbool plain old data to ``cheat'' std::vector<bool>
 */
@@ -66,6 +122,14 @@ struct Pbool
 #define PFILE_ERR_ERASE -4 //for if file erase failed
 #define PFILE_ERR_FLUSH -5 //could not flush file io buffer
 #define PFILE_ERR_SLEN -6 //input string is too long
+#define PFILE_ERR_ASYNC -7 //asynchronous IO failed
+#define PFILE_ERR_MAP -8 //memory mapping failed
+#define PFILE_ERR_WONLY -9 //file is write only, and cannot be mapped
+#define PFILE_ERR_IO -10 //a write or read failed
+#define PFILE_ERR_EOF -11 //a read reached the end of the file, the rest is zero
+#define PFILE_MAP_NORMAL 0 //no access pattern advice
+#define PFILE_MAP_SEQUENTIAL 1 //blocks are read in order, read ahead
+#define PFILE_MAP_RANDOM 2 //blocks are read in any order, no read ahead
 #define PFILE_RES 50
 #define PFILE_LEN 32 //pfile max length of strvec
 
@@ -75,11 +139,16 @@ class Pfile
   //Data
   std::vector<Pfio>        m_fio;	//file io struct list
   std::vector<Pbool>       m_isopen;	//bools for tracking if file is open
+  std::vector<Pmap>        m_map;	//memory mappings
   Strvec<PFILE_LEN>        m_fname;	//file names
+  Phash                    m_index;	//hash index of m_fname
   Strvec<PFILE_LEN>        m_fstat;	//file status
   char                     m_buf[PFILE_LEN];
   int                      m_nfiles;  //number of files
   int                      m_rootid;  //root file id
+  Pio                      m_pio;     //asynchronous IO engine
+
+  void m_reindex();
 
   public:
   //Constructor/destructor
@@ -144,12 +213,13 @@ class Pfile
   //info
   void info(const Pworld& pworld, Pprint& pprint) const;
 
-  //write : needs internal file id!!
-  void write(const int fid, const long pos, const void* data,
+  //write : needs internal file id!! returns 0 or PFILE_ERR_IO
+  int write(const int fid, const long pos, const void* data,
              const size_t size, const size_t num);
 
-  //read : needs internal file id!!
-  void read(const int fid, const long pos, void* data,
+  //read : needs internal file id!! returns 0, PFILE_ERR_IO, or
+  //  PFILE_ERR_EOF, where the part past the end of the file is zero
+  int read(const int fid, const long pos, void* data,
             const size_t size, const size_t num);
 
   //seek : needs internal file id!!
@@ -158,6 +228,31 @@ class Pfile
   //get_pos : get file position
   long get_pos(const int fid) const {return m_fio[fid].fpos;}
 
+  //asynchronous IO : start nthreads IO threads on tasks that do IO
+  int async_init(const Pworld& pworld, const int nthreads);
+
+  //awrite, aread : needs internal file id!! data must not be touched
+  //  until the request is complete
+  Pio_handle awrite(const int fid, const long pos, const void* data,
+                    const size_t size, const size_t num);
+  Pio_handle aread(const int fid, const long pos, void* data,
+                   const size_t size, const size_t num);
+
+  //completion of asynchronous IO, return 0 or PFILE_ERR_ASYNC
+  bool test(const Pio_handle& handle) const {return m_pio.test(handle);}
+  int wait(const Pio_handle& handle);
+  int wait_file(const int fid);
+  int wait_all();
+
+  //memory mapping : needs internal file id!!
+  int map(const int fid, const int advice, const bool huge);
+  int remap(const int fid);
+  int unmap(const int fid);
+  bool ismapped(const int fid) const {return m_map[fid].ptr != NULL;}
+  void* map_block(const int fid, const long pos, const size_t bytes);
+  int advise(const int fid, const long pos, const size_t bytes, const int advice);
+  int prefetch(const int fid, const long pos, const size_t bytes);
+
   //save filesystem info
   int save(const Pworld& pworld);
    
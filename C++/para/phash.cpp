@@ -0,0 +1,88 @@
+/*------------------------------------------------------------------------
+ * phash.cpp
+ *  JHT, October 19, 2026 : created
+ *
+ *  .cpp file for Phash, an open addressing hash index
+------------------------------------------------------------------------*/
+#include "phash.hpp"
+
+//-----------------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------------
+Phash::Phash()
+{
+  m_key.assign(PHASH_MIN,0);
+  m_id.assign(PHASH_MIN,-1);
+  m_mask = PHASH_MIN-1;
+  m_num = 0;
+}
+
+//-----------------------------------------------------------------------
+// hash -- FNV-1a of a string, and a 64 bit mix of an integer tag
+//-----------------------------------------------------------------------
+uint64_t Phash::hash(const char* key)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (const unsigned char* c=(const unsigned char*) key;*c!='\0';c++)
+  {
+    h ^= (uint64_t) *c;
+    h *= 1099511628211ULL;
+  }
+  return h ^ (h >> 32);
+}
+
+uint64_t Phash::hash(const long key)
+{
+  uint64_t h = (uint64_t) key;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+//-----------------------------------------------------------------------
+// insert -- add an id to the first free slot of its probe sequence
+//-----------------------------------------------------------------------
+void Phash::insert(const uint64_t key, const long id)
+{
+  if (2*(m_num+1) > (long) m_id.size()) {m_grow();}
+  uint64_t slot = key & m_mask;
+  while (m_id[slot] != -1) {slot = (slot+1) & m_mask;}
+  m_key[slot] = key;
+  m_id[slot] = id;
+  m_num++;
+}
+
+//-----------------------------------------------------------------------
+// clear
+//-----------------------------------------------------------------------
+void Phash::clear()
+{
+  m_key.assign(PHASH_MIN,0);
+  m_id.assign(PHASH_MIN,-1);
+  m_mask = PHASH_MIN-1;
+  m_num = 0;
+}
+
+//-----------------------------------------------------------------------
+// m_grow -- double the table, and reinsert
+//-----------------------------------------------------------------------
+void Phash::m_grow()
+{
+  std::vector<uint64_t> key;
+  std::vector<long>     id;
+  key.swap(m_key);
+  id.swap(m_id);
+
+  const size_t len = 2*id.size();
+  m_key.assign(len,0);
+  m_id.assign(len,-1);
+  m_mask = len-1;
+  m_num = 0;
+  for (size_t slot=0;slot<id.size();slot++)
+  {
+    if (id[slot] != -1) {insert(key[slot],id[slot]);}
+  }
+}
@@ -0,0 +1,77 @@
+/*------------------------------------------------------------------------
+ * phash.hpp
+ *  JHT, October 19, 2026 : created
+ *
+   .hpp file for Phash, an open addressing (linear probing) hash index
+   from 64 bit keys to ids, kept alongside the vectors that hold the
+   names or tags themselves.
+
+   Phash only stores the hash of each key and its id. A lookup walks the
+   probe sequence of a hash, and hands each candidate id to a compare
+   function, which checks the real key in the owner's vector (e.g.
+   strcmp against a file name). Removing an element shifts the ids of
+   those after it, so owners rebuild the index when they remove one.
+
+   The table is kept at most half full, and lookups only read it, so any
+   number of OpenMP threads may look up at once. Adding, removing, and
+   rebuilding must not run at the same time as lookups.
+
+  General usage
+
+  Phash index;
+  index.insert(Phash::hash(name),id);
+  long id = index.find(Phash::hash(name),
+                       [&](const long i){return strcmp(name,names[i]) == 0;});
+  index.clear();
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PHASH_HPP
+#define LIBJ_PHASH_HPP
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define PHASH_MIN 64 //smallest table
+
+class Phash
+{
+  private:
+  std::vector<uint64_t> m_key;	//hash of each slot's key
+  std::vector<long>     m_id;	//id of each slot, -1 if empty
+  uint64_t              m_mask;	//table size - 1
+  long                  m_num;	//number of ids
+
+  void m_grow();
+
+  public:
+  Phash();
+
+  //hashes of names and tags
+  static uint64_t hash(const char* key);
+  static uint64_t hash(const long key);
+
+  //add an id for a hash, the key must not already be in the index
+  void insert(const uint64_t key, const long id);
+
+  //remove everything
+  void clear();
+
+  //number of ids
+  long size() const {return m_num;}
+
+  //find the id of a key, or -1. same(id) checks the key of id
+  template<typename SAME>
+  long find(const uint64_t key, const SAME& same) const
+  {
+    if (m_num == 0) {return -1;}
+    for (uint64_t slot=key&m_mask;;slot=(slot+1)&m_mask)
+    {
+      const long id = m_id[slot];
+      if (id == -1) {return -1;}
+      if (m_key[slot] == key && same(id)) {return id;}
+    }
+  }
+
+};
+
+#endif
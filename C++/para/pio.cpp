@@ -0,0 +1,337 @@
+/*------------------------------------------------------------------------
+ * pio.cpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : wait_file and wait_all report errors
+ *  JHT, October 19, 2026 : errors returned by wait are not reported again
+ *
+ *  .cpp file for Pio, the asynchronous IO engine behind Pfile
+------------------------------------------------------------------------*/
+#include "pio.hpp"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------------
+Pio::Pio()
+{
+  m_npending = 0;
+  m_stop = false;
+}
+
+//-----------------------------------------------------------------------
+// Destructor -- finish outstanding requests and stop the threads
+//-----------------------------------------------------------------------
+Pio::~Pio()
+{
+  destroy();
+}
+
+//-----------------------------------------------------------------------
+// init -- start nthreads IO threads
+//-----------------------------------------------------------------------
+int Pio::init(const int nthreads)
+{
+  if (isinit()) {return 0;}
+  if (nthreads <= 0) {return PIO_ERR_INIT;}
+  m_stop = false;
+  for (int i=0;i<nthreads;i++)
+  {
+    m_threads.push_back(std::thread(&Pio::m_worker,this));
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// destroy -- wait on all requests, then stop the threads
+//-----------------------------------------------------------------------
+int Pio::destroy()
+{
+  if (!isinit()) {return 0;}
+  const int stat = wait_all();
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_stop = true;
+  }
+  m_work.notify_all();
+  for (size_t i=0;i<m_threads.size();i++) {m_threads[i].join();}
+  m_threads.clear();
+  return stat;
+}
+
+//-----------------------------------------------------------------------
+// m_submit -- queue a request
+//-----------------------------------------------------------------------
+Pio_handle Pio::m_submit(const int fid, const int fd, const long pos,
+                         char* buf, const size_t bytes, const bool write)
+{
+  Pio_handle handle;
+  handle.stat = std::make_shared<Pio_status>();
+
+  if (!isinit())
+  {
+    handle.stat->err = PIO_ERR_INIT;
+    handle.stat->done = 1;
+    return handle;
+  }
+
+  if (bytes == 0)
+  {
+    handle.stat->done = 1;
+    return handle;
+  }
+
+  Pio_op op;
+  op.fid   = fid;
+  op.fd    = fd;
+  op.pos   = (off_t) pos;
+  op.buf   = buf;
+  op.bytes = bytes;
+  op.write = write;
+  op.stat  = handle.stat;
+
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_queue.push_back(op);
+    m_pending[fid]++;
+    m_npending++;
+  }
+  m_work.notify_one();
+  return handle;
+}
+
+//-----------------------------------------------------------------------
+// write -- queue a write of bytes from data to position pos of fd
+//-----------------------------------------------------------------------
+Pio_handle Pio::write(const int fid, const int fd, const long pos,
+                      const void* data, const size_t bytes)
+{
+  return m_submit(fid,fd,pos,(char*) const_cast<void*>(data),bytes,true);
+}
+
+//-----------------------------------------------------------------------
+// read -- queue a read of bytes from position pos of fd into data
+//-----------------------------------------------------------------------
+Pio_handle Pio::read(const int fid, const int fd, const long pos,
+                     void* data, const size_t bytes)
+{
+  return m_submit(fid,fd,pos,(char*) data,bytes,false);
+}
+
+//-----------------------------------------------------------------------
+// m_take -- take the front request, and every queued request that is
+//   contiguous with it in the same file and direction. Called with
+//   m_lock held. ops is returned sorted by position
+//-----------------------------------------------------------------------
+void Pio::m_take(std::vector<Pio_op>& ops)
+{
+  ops.clear();
+  ops.push_back(m_queue.front());
+  m_queue.pop_front();
+
+  off_t  start = ops[0].pos;
+  off_t  end   = ops[0].pos + (off_t) ops[0].bytes;
+  size_t bytes = ops[0].bytes;
+  const int  fd    = ops[0].fd;
+  const bool write = ops[0].write;
+
+  bool found = true;
+  while (found && ops.size() < PIO_MAX_IOV)
+  {
+    found = false;
+    for (std::deque<Pio_op>::iterator it=m_queue.begin();it!=m_queue.end();++it)
+    {
+      if (it->fd != fd || it->write != write) {continue;}
+      if (bytes + it->bytes > PIO_MAX_BYTES) {continue;}
+
+      if (it->pos == end)
+      {
+        end += (off_t) it->bytes;
+        ops.push_back(*it);
+      } else if (it->pos + (off_t) it->bytes == start) {
+        start = it->pos;
+        ops.insert(ops.begin(),*it);
+      } else {
+        continue;
+      }
+      bytes += it->bytes;
+      m_queue.erase(it);
+      found = true;
+      break;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// m_perform -- do a set of contiguous requests with one vectored call,
+//   continuing after partial transfers
+//-----------------------------------------------------------------------
+int Pio::m_perform(std::vector<Pio_op>& ops)
+{
+  struct iovec iov[PIO_MAX_IOV];
+  const int niov = (int) ops.size();
+  for (int i=0;i<niov;i++)
+  {
+    iov[i].iov_base = ops[i].buf;
+    iov[i].iov_len  = ops[i].bytes;
+  }
+
+  off_t pos = ops[0].pos;
+  const int fd = ops[0].fd;
+  const bool write = ops[0].write;
+  int first = 0;
+  while (first < niov)
+  {
+    const ssize_t n = write ? pwritev(fd,iov+first,niov-first,pos)
+                            : preadv(fd,iov+first,niov-first,pos);
+    if (n < 0)
+    {
+      if (errno == EINTR) {continue;}
+      return PIO_ERR_IO;
+    }
+    if (n == 0) {return write ? PIO_ERR_IO : PIO_ERR_SHORT;}
+
+    //advance past what was transfered
+    pos += (off_t) n;
+    size_t left = (size_t) n;
+    while (first < niov && left >= iov[first].iov_len)
+    {
+      left -= iov[first].iov_len;
+      first++;
+    }
+    if (first < niov)
+    {
+      iov[first].iov_base = (char*) iov[first].iov_base + left;
+      iov[first].iov_len -= left;
+    }
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// m_complete -- mark requests as complete, and wake the waiters
+//-----------------------------------------------------------------------
+void Pio::m_complete(std::vector<Pio_op>& ops, const int err)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (size_t i=0;i<ops.size();i++)
+    {
+      ops[i].stat->err = err;
+      ops[i].stat->done = 1;
+      m_pending[ops[i].fid]--;
+      m_npending--;
+      if (err != 0) {m_errs.push_back(std::make_pair(ops[i].fid,ops[i].stat));}
+    }
+  }
+  m_done.notify_all();
+}
+
+//-----------------------------------------------------------------------
+// m_worker -- IO thread loop
+//-----------------------------------------------------------------------
+void Pio::m_worker()
+{
+  std::vector<Pio_op> ops;
+  ops.reserve(PIO_MAX_IOV);
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> guard(m_lock);
+      while (!m_stop && m_queue.empty()) {m_work.wait(guard);}
+      if (m_queue.empty()) {return;}
+      m_take(ops);
+    }
+    const int err = m_perform(ops);
+    m_complete(ops,err);
+  }
+}
+
+//-----------------------------------------------------------------------
+// test -- true if the request is complete
+//-----------------------------------------------------------------------
+bool Pio::test(const Pio_handle& handle) const
+{
+  return !handle.valid() || handle.stat->done.load() == 1;
+}
+
+//-----------------------------------------------------------------------
+// wait -- wait on a request, returns its error code, which is then no
+//   longer reported by wait_file or wait_all
+//-----------------------------------------------------------------------
+int Pio::wait(const Pio_handle& handle)
+{
+  if (!handle.valid()) {return 0;}
+  std::unique_lock<std::mutex> guard(m_lock);
+  while (handle.stat->done.load() != 1) {m_done.wait(guard);}
+  if (handle.stat->err != 0)
+  {
+    for (std::deque<std::pair<int,std::shared_ptr<Pio_status>>>::iterator it=m_errs.begin();
+         it!=m_errs.end();++it)
+    {
+      if (it->second == handle.stat) {m_errs.erase(it); break;}
+    }
+  }
+  return handle.stat->err;
+}
+
+//-----------------------------------------------------------------------
+// wait_file -- wait on all requests of a file, returns the first
+//   unreported error of the file
+//-----------------------------------------------------------------------
+int Pio::wait_file(const int fid)
+{
+  std::unique_lock<std::mutex> guard(m_lock);
+  while (m_pending[fid] > 0) {m_done.wait(guard);}
+  int err = 0;
+  for (std::deque<std::pair<int,std::shared_ptr<Pio_status>>>::iterator it=m_errs.begin();
+       it!=m_errs.end();)
+  {
+    if (it->first != fid) {++it; continue;}
+    if (err == 0) {err = it->second->err;}
+    it = m_errs.erase(it);
+  }
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// wait_all -- wait on all requests, returns the first unreported error
+//-----------------------------------------------------------------------
+int Pio::wait_all()
+{
+  std::unique_lock<std::mutex> guard(m_lock);
+  while (m_npending > 0) {m_done.wait(guard);}
+  const int err = m_errs.empty() ? 0 : m_errs.front().second->err;
+  m_errs.clear();
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// wait_idle -- wait on all requests of a file, keeping the errors
+//-----------------------------------------------------------------------
+void Pio::wait_idle(const int fid)
+{
+  std::unique_lock<std::mutex> guard(m_lock);
+  while (m_pending[fid] > 0) {m_done.wait(guard);}
+}
+
+//-----------------------------------------------------------------------
+// pending -- true if the file has outstanding requests
+//-----------------------------------------------------------------------
+bool Pio::pending(const int fid)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  std::map<int,long>::const_iterator it = m_pending.find(fid);
+  return it != m_pending.end() && it->second > 0;
+}
+
+//-----------------------------------------------------------------------
+// idle -- true if no requests are outstanding and no errors unreported
+//-----------------------------------------------------------------------
+bool Pio::idle()
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  return m_npending == 0 && m_errs.empty();
+}
@@ -0,0 +1,153 @@
+/*------------------------------------------------------------------------
+ * pio.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : wait_file and wait_all report errors
+ *  JHT, October 19, 2026 : errors returned by wait are not reported again
+ *
+   .hpp file for Pio, the asynchronous IO engine behind the Pfile
+   awrite and aread functions.
+
+   Requests are queued and performed by a pool of IO threads with
+   positional pread/pwrite calls, so the calling thread returns right
+   away with a Pio_handle, which can be tested or waited on later. Many
+   requests can be outstanding per file.
+
+   When an IO thread takes a request, it also takes every queued request
+   on the same file, in the same direction, that continues where the
+   request ends (in either order of submission), and does them all with
+   a single preadv/pwritev.
+
+   NOTE : files opened for append ("a") are not supported, as pwrite
+          ignores the position on them.
+   NOTE : requests are not ordered with respect to each other. Requests
+          on overlapping parts of a file must be separated by a wait. The
+          buffers must not be touched until the request is complete.
+
+  General usage
+
+  Pio pio;
+  pio.init(4);			//4 IO threads
+  Pio_handle h = pio.write(fid,fd,pos,data,bytes);
+  Pio_handle g = pio.read(fid,fd,pos,data,bytes);
+  pio.wait(h);			//returns 0, or PIO_ERR_*
+  pio.test(g);			//true if complete
+  pio.wait_file(fid);		//wait on all requests of file fid
+  pio.wait_all();
+  pio.destroy();
+
+  wait_file and wait_all return the first error of the requests they
+  cover that has not been returned by an earlier wait, wait_file or
+  wait_all.
+  wait_idle(fid) waits like wait_file, but keeps the errors for later.
+  idle() is true when there are no outstanding requests and no errors
+  left to report, which is needed before file ids are renumbered.
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PIO_HPP
+#define LIBJ_PIO_HPP
+#include <stdio.h>
+#include <sys/types.h>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "libjdef.h"
+
+//Error message integers
+#define PIO_ERR_INIT -1 //IO threads are not running
+#define PIO_ERR_IO   -2 //a read or write failed
+#define PIO_ERR_SHORT -3 //a read reached the end of the file
+
+//Limits on a single coalesced request
+#define PIO_MAX_IOV 64
+#define PIO_MAX_BYTES 67108864
+
+/*
+ * Completion state of a request, shared by the handle and the engine
+*/
+struct Pio_status
+{
+  std::atomic<int> done;  //1 when complete
+  int              err;   //0 or PIO_ERR_*
+  Pio_status() : done(0), err(0) {}
+};
+
+/*
+ * Handle to an outstanding request
+*/
+struct Pio_handle
+{
+  std::shared_ptr<Pio_status> stat;
+  bool valid() const {return (bool) stat;}
+};
+
+/*
+ * A queued request
+*/
+struct Pio_op
+{
+  int    fid;    //file id (for wait_file)
+  int    fd;     //file descriptor
+  off_t  pos;    //byte position in file
+  char*  buf;    //data
+  size_t bytes;  //number of bytes
+  bool   write;  //true for write
+  std::shared_ptr<Pio_status> stat;
+};
+
+class Pio
+{
+  private:
+  //Data
+  std::vector<std::thread>  m_threads;    //IO threads
+  std::deque<Pio_op>        m_queue;      //queued requests
+  std::map<int,long>        m_pending;    //outstanding requests per file
+  std::deque<std::pair<int,std::shared_ptr<Pio_status>>> m_errs; //unreported (fid,request), in order
+  long                      m_npending;   //total outstanding requests
+  std::mutex                m_lock;
+  std::condition_variable   m_work;       //signals the IO threads
+  std::condition_variable   m_done;       //signals the waiting threads
+  bool                      m_stop;
+
+  //internal functions
+  void m_worker();
+  void m_take(std::vector<Pio_op>& ops);
+  int  m_perform(std::vector<Pio_op>& ops);
+  void m_complete(std::vector<Pio_op>& ops, const int err);
+  Pio_handle m_submit(const int fid, const int fd, const long pos,
+                      char* buf, const size_t bytes, const bool write);
+
+  public:
+  //Constructor/destructor
+  Pio();
+  ~Pio();
+
+  //start and stop the IO threads
+  int init(const int nthreads);
+  int destroy();
+  bool isinit() const {return !m_threads.empty();}
+
+  //submit requests
+  Pio_handle write(const int fid, const int fd, const long pos,
+                   const void* data, const size_t bytes);
+  Pio_handle read(const int fid, const int fd, const long pos,
+                  void* data, const size_t bytes);
+
+  //completion
+  bool test(const Pio_handle& handle) const;
+  int  wait(const Pio_handle& handle);
+  int  wait_file(const int fid);
+  int  wait_all();
+  void wait_idle(const int fid);
+  bool pending(const int fid);
+  bool idle();
+
+};
+
+#endif
@@ -0,0 +1,372 @@
+/*------------------------------------------------------------------------
+ * pmpio.cpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : transfers over INT_MAX bytes use a derived type
+ *  JHT, October 19, 2026 : short transfers are errors
+ *
+ *  .cpp file for Pmpio, files shared by all tasks through MPI-IO
+ *
+ *  NOTE : MPI counts are ints, so transfers of more than INT_MAX bytes
+ *         are described by a derived type of PMPIO_CHUNK byte blocks
+ *         and a remainder, rather than a count of bytes
+------------------------------------------------------------------------*/
+#include "pmpio.hpp"
+#include <limits.h>
+#include <string.h>
+#include <algorithm>
+
+//bytes per block of the derived type of large transfers
+#define PMPIO_CHUNK 1048576
+
+//-----------------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------------
+Pmpio::Pmpio()
+{
+  m_nfiles = 0;
+  m_init = false;
+  m_isopen.reserve(PMPIO_RES);
+  m_fname.reserve(PMPIO_RES);
+}
+
+//-----------------------------------------------------------------------
+// Destructor -- files must be closed with destroy, as closing is
+//   collective
+//-----------------------------------------------------------------------
+Pmpio::~Pmpio()
+{
+}
+
+#if defined LIBJ_MPI
+
+//-----------------------------------------------------------------------
+// bytes_type -- the datatype and count of a transfer of bytes. Returns
+//   true if type is a derived type, which the caller must free
+//-----------------------------------------------------------------------
+static bool bytes_type(const size_t bytes, MPI_Datatype& type, int& count)
+{
+  if (bytes <= (size_t) INT_MAX)
+  {
+    type = MPI_BYTE;
+    count = (int) bytes;
+    return false;
+  }
+
+  MPI_Datatype chunk;
+  MPI_Type_contiguous(PMPIO_CHUNK,MPI_BYTE,&chunk);
+  int          blen[2]  = {(int) (bytes/PMPIO_CHUNK),(int) (bytes%PMPIO_CHUNK)};
+  MPI_Aint     bdisp[2] = {0,(MPI_Aint) (bytes - bytes%PMPIO_CHUNK)};
+  MPI_Datatype btype[2] = {chunk,MPI_BYTE};
+  MPI_Type_create_struct(2,blen,bdisp,btype,&type);
+  MPI_Type_commit(&type);
+  MPI_Type_free(&chunk);
+  count = 1;
+  return true;
+}
+
+//-----------------------------------------------------------------------
+// transfer_err -- the error of a transfer of count elements of type,
+//   which is PMPIO_ERR_SHORT if fewer were moved (a read past the end of
+//   the file)
+//-----------------------------------------------------------------------
+static int transfer_err(const int stat, MPI_Status& status, const MPI_Datatype type,
+                        const int count)
+{
+  if (stat != MPI_SUCCESS) {return PMPIO_ERR_IO;}
+  int moved;
+  MPI_Get_count(&status,type,&moved);
+  return (moved == count) ? 0 : PMPIO_ERR_SHORT;
+}
+
+//-----------------------------------------------------------------------
+// init -- set the communicator and default collective buffering hints
+//-----------------------------------------------------------------------
+int Pmpio::init(const Pworld& pworld)
+{
+  if (m_init) {return 0;}
+  m_comm = pworld.comm_world;
+  MPI_Info_create(&m_info);
+
+  //collective buffering on, one aggregator per node
+  int nnodes = 0;
+  int isroot = pworld.mpi_shared_ismaster ? 1 : 0;
+  MPI_Allreduce(&isroot,&nnodes,1,MPI_INT,MPI_SUM,m_comm);
+  char buf[32];
+  snprintf(buf,32,"%d",nnodes);
+  MPI_Info_set(m_info,"romio_cb_write","enable");
+  MPI_Info_set(m_info,"romio_cb_read","enable");
+  MPI_Info_set(m_info,"cb_nodes",buf);
+
+  m_init = true;
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// destroy -- close all files, free the hints
+//-----------------------------------------------------------------------
+int Pmpio::destroy(const Pworld& pworld)
+{
+  if (!m_init) {return 0;}
+  const int stat = close_all(pworld);
+  MPI_Info_free(&m_info);
+  m_init = false;
+  return stat;
+}
+
+//-----------------------------------------------------------------------
+// set_hint
+//-----------------------------------------------------------------------
+int Pmpio::set_hint(const char* key, const char* value)
+{
+  if (!m_init) {return PMPIO_ERR_OPEN;}
+  MPI_Info_set(m_info,key,value);
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// add -- add a file, or return the id of a file with this name
+//-----------------------------------------------------------------------
+int Pmpio::add(const Pworld&, const char* fname)
+{
+  if (strlen(fname) >= PMPIO_LEN) {return PMPIO_ERR_SLEN;}
+  const int loc = file_loc(fname);
+  if (loc != -1) {return loc;}
+
+  m_nfiles++;
+  m_fh.push_back(MPI_FILE_NULL);
+  m_isopen.push_back(0);
+  m_fname.push_back(fname);
+  m_index.insert(Phash::hash(fname),m_nfiles-1);
+  return m_nfiles-1;
+}
+
+//-----------------------------------------------------------------------
+// open -- collective open
+//-----------------------------------------------------------------------
+int Pmpio::open(const Pworld& pworld, const int fid, const char* fstat)
+{
+  if (!m_init) {return PMPIO_ERR_OPEN;}
+  if (fid < 0 || fid >= m_nfiles || isopen(fid)) {return PMPIO_ERR_OPEN;}
+
+  int amode;
+  if      (strcmp(fstat,"r") == 0)  {amode = MPI_MODE_RDONLY;}
+  else if (strcmp(fstat,"r+") == 0) {amode = MPI_MODE_RDWR;}
+  else if (strcmp(fstat,"w") == 0)  {amode = MPI_MODE_WRONLY | MPI_MODE_CREATE;}
+  else if (strcmp(fstat,"w+") == 0) {amode = MPI_MODE_RDWR | MPI_MODE_CREATE;}
+  else {return PMPIO_ERR_MODE;}
+
+  //"w" truncates, as in fopen
+  if (fstat[0] == 'w')
+  {
+    if (pworld.mpi_world_ismaster) {MPI_File_delete(m_fname[fid],MPI_INFO_NULL);}
+    MPI_Barrier(m_comm);
+  }
+
+  if (MPI_File_open(m_comm,m_fname[fid],amode,m_info,&m_fh[fid]) != MPI_SUCCESS)
+  {
+    return PMPIO_ERR_OPEN;
+  }
+  m_isopen[fid] = 1;
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// close -- collective close
+//-----------------------------------------------------------------------
+int Pmpio::close(const Pworld&, const int fid)
+{
+  if (fid < 0 || fid >= m_nfiles || !isopen(fid)) {return PMPIO_ERR_CLOSE;}
+  const int stat = MPI_File_close(&m_fh[fid]);
+  m_isopen[fid] = 0;
+  return (stat == MPI_SUCCESS) ? 0 : PMPIO_ERR_CLOSE;
+}
+
+//-----------------------------------------------------------------------
+// close_all
+//-----------------------------------------------------------------------
+int Pmpio::close_all(const Pworld& pworld)
+{
+  int stat = 0;
+  for (int fid=0;fid<m_nfiles;fid++)
+  {
+    if (isopen(fid)) {stat += close(pworld,fid);}
+  }
+  return (stat == 0) ? 0 : PMPIO_ERR_CLOSE;
+}
+
+//-----------------------------------------------------------------------
+// set_blocks -- set the view of this task to nblock blocks of bytes,
+//   at byte positions pos (relative to disp) with lengths len. Blocks
+//   are sorted by position, as MPI requires, and must not overlap
+//-----------------------------------------------------------------------
+int Pmpio::set_blocks(const int fid, const long disp, const int nblock,
+                      const long* pos, const long* len)
+{
+  if (!isopen(fid)) {return PMPIO_ERR_VIEW;}
+
+  std::vector<int> order(nblock);
+  for (int i=0;i<nblock;i++) {order[i] = i;}
+  std::sort(order.begin(),order.end(),
+            [pos](const int a, const int b) {return pos[a] < pos[b];});
+
+  //blocks over INT_MAX bytes are derived types
+  std::vector<int>          blen(nblock);
+  std::vector<MPI_Aint>     bpos(nblock);
+  std::vector<MPI_Datatype> btype(nblock);
+  std::vector<char>         derived(nblock);
+  for (int i=0;i<nblock;i++)
+  {
+    derived[i] = bytes_type((size_t) len[order[i]],btype[i],blen[i]);
+    bpos[i] = (MPI_Aint) pos[order[i]];
+  }
+
+  MPI_Datatype ftype;
+  MPI_Type_create_struct(nblock,blen.data(),bpos.data(),btype.data(),&ftype);
+  MPI_Type_commit(&ftype);
+  for (int i=0;i<nblock;i++) {if (derived[i]) {MPI_Type_free(&btype[i]);}}
+  const int stat = MPI_File_set_view(m_fh[fid],(MPI_Offset) disp,MPI_BYTE,ftype,
+                                     "native",m_info);
+  MPI_Type_free(&ftype);
+  return (stat == MPI_SUCCESS) ? 0 : PMPIO_ERR_VIEW;
+}
+
+//-----------------------------------------------------------------------
+// reset_view -- whole file, byte positions
+//-----------------------------------------------------------------------
+int Pmpio::reset_view(const int fid)
+{
+  if (!isopen(fid)) {return PMPIO_ERR_VIEW;}
+  const int stat = MPI_File_set_view(m_fh[fid],0,MPI_BYTE,MPI_BYTE,"native",m_info);
+  return (stat == MPI_SUCCESS) ? 0 : PMPIO_ERR_VIEW;
+}
+
+//-----------------------------------------------------------------------
+// write_at_all -- collective write at byte position pos
+//-----------------------------------------------------------------------
+int Pmpio::write_at_all(const int fid, const long pos, const void* data,
+                        const size_t size, const size_t num)
+{
+  MPI_Datatype type;
+  int count;
+  const bool derived = bytes_type(size*num,type,count);
+  MPI_Status status;
+  const int stat = MPI_File_write_at_all(m_fh[fid],(MPI_Offset) pos,data,
+                                         count,type,&status);
+  const int err = transfer_err(stat,status,type,count);
+  if (derived) {MPI_Type_free(&type);}
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// read_at_all -- collective read at byte position pos
+//-----------------------------------------------------------------------
+int Pmpio::read_at_all(const int fid, const long pos, void* data,
+                       const size_t size, const size_t num)
+{
+  MPI_Datatype type;
+  int count;
+  const bool derived = bytes_type(size*num,type,count);
+  MPI_Status status;
+  const int stat = MPI_File_read_at_all(m_fh[fid],(MPI_Offset) pos,data,
+                                        count,type,&status);
+  const int err = transfer_err(stat,status,type,count);
+  if (derived) {MPI_Type_free(&type);}
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// write_all -- collective write of the view of this task
+//-----------------------------------------------------------------------
+int Pmpio::write_all(const int fid, const void* data, const size_t bytes)
+{
+  return write_at_all(fid,0,data,1,bytes);
+}
+
+//-----------------------------------------------------------------------
+// read_all -- collective read of the view of this task
+//-----------------------------------------------------------------------
+int Pmpio::read_all(const int fid, void* data, const size_t bytes)
+{
+  return read_at_all(fid,0,data,1,bytes);
+}
+
+//-----------------------------------------------------------------------
+// xwrite_at -- independent write
+//-----------------------------------------------------------------------
+int Pmpio::xwrite_at(const int fid, const long pos, const void* data,
+                     const size_t size, const size_t num)
+{
+  MPI_Datatype type;
+  int count;
+  const bool derived = bytes_type(size*num,type,count);
+  MPI_Status status;
+  const int stat = MPI_File_write_at(m_fh[fid],(MPI_Offset) pos,data,
+                                     count,type,&status);
+  const int err = transfer_err(stat,status,type,count);
+  if (derived) {MPI_Type_free(&type);}
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// xread_at -- independent read
+//-----------------------------------------------------------------------
+int Pmpio::xread_at(const int fid, const long pos, void* data,
+                    const size_t size, const size_t num)
+{
+  MPI_Datatype type;
+  int count;
+  const bool derived = bytes_type(size*num,type,count);
+  MPI_Status status;
+  const int stat = MPI_File_read_at(m_fh[fid],(MPI_Offset) pos,data,
+                                    count,type,&status);
+  const int err = transfer_err(stat,status,type,count);
+  if (derived) {MPI_Type_free(&type);}
+  return err;
+}
+
+//-----------------------------------------------------------------------
+// sync
+//-----------------------------------------------------------------------
+int Pmpio::sync(const int fid)
+{
+  return (MPI_File_sync(m_fh[fid]) == MPI_SUCCESS) ? 0 : PMPIO_ERR_IO;
+}
+
+#else
+
+//-----------------------------------------------------------------------
+// Without MPI there are no shared files
+//-----------------------------------------------------------------------
+int Pmpio::init(const Pworld&) {return PMPIO_ERR_NOMPI;}
+int Pmpio::destroy(const Pworld&) {return 0;}
+int Pmpio::set_hint(const char*, const char*) {return PMPIO_ERR_NOMPI;}
+int Pmpio::add(const Pworld&, const char*) {return PMPIO_ERR_NOMPI;}
+int Pmpio::open(const Pworld&, const int, const char*) {return PMPIO_ERR_NOMPI;}
+int Pmpio::close(const Pworld&, const int) {return PMPIO_ERR_NOMPI;}
+int Pmpio::close_all(const Pworld&) {return 0;}
+int Pmpio::set_blocks(const int, const long, const int, const long*, const long*)
+  {return PMPIO_ERR_NOMPI;}
+int Pmpio::reset_view(const int) {return PMPIO_ERR_NOMPI;}
+int Pmpio::write_at_all(const int, const long, const void*, const size_t, const size_t)
+  {return PMPIO_ERR_NOMPI;}
+int Pmpio::read_at_all(const int, const long, void*, const size_t, const size_t)
+  {return PMPIO_ERR_NOMPI;}
+int Pmpio::write_all(const int, const void*, const size_t) {return PMPIO_ERR_NOMPI;}
+int Pmpio::read_all(const int, void*, const size_t) {return PMPIO_ERR_NOMPI;}
+int Pmpio::xwrite_at(const int, const long, const void*, const size_t, const size_t)
+  {return PMPIO_ERR_NOMPI;}
+int Pmpio::xread_at(const int, const long, void*, const size_t, const size_t)
+  {return PMPIO_ERR_NOMPI;}
+int Pmpio::sync(const int) {return PMPIO_ERR_NOMPI;}
+
+#endif
+
+//-----------------------------------------------------------------------
+// file_loc -- find location of file by name
+//-----------------------------------------------------------------------
+int Pmpio::file_loc(const char* fname) const
+{
+  return (int) m_index.find(Phash::hash(fname),
+                           [&](const long file)
+                           {return strcmp(fname,m_fname[file]) == 0;});
+}
@@ -0,0 +1,133 @@
+/*------------------------------------------------------------------------
+ * pmpio.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : short transfers are errors
+ *
+   .hpp file for Pmpio, which handles files shared by all tasks through
+   MPI-IO. Where Pfile funnels the IO of a node through its shared root
+   task, every task opens a Pmpio file and reads or writes its own parts
+   of it, with collective calls that let the MPI library aggregate the
+   requests (collective buffering) over the nodes.
+
+   Unlike Pfile, the file names are not tagged with the task id, as the
+   file is shared by all of comm_world. All functions except the "x"
+   (independent) reads and writes are collective over comm_world, and
+   must be called by every task with the same file id.
+
+   File views
+     By default a task sees the whole file, and positions are bytes
+     from the start of the file. set_blocks sets the view of a task to a
+     list of (byte position, byte length) blocks, after which write_all
+     and read_all transfer a packed buffer of those blocks, in order of
+     position. reset_view returns to the whole file.
+
+  General usage
+
+  Pmpio pmpio;
+  pmpio.init(pworld);
+  const int fid = pmpio.add(pworld,"amps");
+  pmpio.open(pworld,fid,"w+");
+  pmpio.write_at_all(fid,pos,data,sizeof(double),n);
+  pmpio.set_blocks(fid,0,nblock,block_pos,block_len);
+  pmpio.write_all(fid,packed,bytes);
+  pmpio.close(pworld,fid);
+
+  Reads and writes return 0, PMPIO_ERR_IO if the call failed, or
+  PMPIO_ERR_SHORT if fewer bytes were moved than asked for.
+
+  Collective buffering hints (set before open)
+  pmpio.set_hint("cb_buffer_size","16777216");
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PMPIO_HPP
+#define LIBJ_PMPIO_HPP
+#include <stdio.h>
+#include <vector>
+
+#include "libjdef.h"
+#include "strvec.hpp"
+#include "pworld.hpp"
+#include "phash.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+//Error message integers
+#define PMPIO_ERR_NOMPI -1 //built without MPI
+#define PMPIO_ERR_OPEN -2 //open failed, or file was already open
+#define PMPIO_ERR_CLOSE -3 //close failed, or file was not open
+#define PMPIO_ERR_IO -4 //read or write failed
+#define PMPIO_ERR_VIEW -5 //setting the file view failed
+#define PMPIO_ERR_SLEN -6 //input string is too long
+#define PMPIO_ERR_MODE -7 //unknown open mode
+#define PMPIO_ERR_SHORT -8 //fewer bytes moved than asked, e.g. past the end of the file
+#define PMPIO_RES 16
+#define PMPIO_LEN 128 //pmpio max length of file names
+
+class Pmpio
+{
+  private:
+  //Data
+  #if defined LIBJ_MPI
+  std::vector<MPI_File>    m_fh;	//file handles
+  MPI_Comm                 m_comm;	//communicator of the files
+  MPI_Info                 m_info;	//hints used at open
+  #endif
+  std::vector<int>         m_isopen;	//1 if file is open
+  Strvec<PMPIO_LEN>        m_fname;	//file names
+  Phash                    m_index;	//hash index of m_fname
+  int                      m_nfiles;	//number of files
+  bool                     m_init;
+
+  public:
+  //Constructor/destructor
+  Pmpio();
+  ~Pmpio();
+
+  //Init and destroy, collective
+  int init(const Pworld& pworld);
+  int destroy(const Pworld& pworld);
+
+  //set an MPI-IO hint for files opened after this
+  int set_hint(const char* key, const char* value);
+
+  //Add a file, returns the file id or error
+  int add(const Pworld& pworld, const char* fname);
+
+  //Open and close, collective. fstat is as in fopen ("r","w","r+","w+")
+  int open(const Pworld& pworld, const int fid, const char* fstat);
+  int close(const Pworld& pworld, const int fid);
+  int close_all(const Pworld& pworld);
+  bool isopen(const int fid) const {return m_isopen[fid] == 1;}
+
+  //Views, collective
+  int set_blocks(const int fid, const long disp, const int nblock,
+                 const long* pos, const long* len);
+  int reset_view(const int fid);
+
+  //Collective IO at byte position pos (of the view)
+  int write_at_all(const int fid, const long pos, const void* data,
+                   const size_t size, const size_t num);
+  int read_at_all(const int fid, const long pos, void* data,
+                  const size_t size, const size_t num);
+
+  //Collective IO of the whole view of this task
+  int write_all(const int fid, const void* data, const size_t bytes);
+  int read_all(const int fid, void* data, const size_t bytes);
+
+  //Independent IO at byte position pos, no collective call
+  int xwrite_at(const int fid, const long pos, const void* data,
+                const size_t size, const size_t num);
+  int xread_at(const int fid, const long pos, void* data,
+               const size_t size, const size_t num);
+
+  //flush to disk, collective
+  int sync(const int fid);
+
+  //locate file id from name
+  int file_loc(const char* fname) const;
+
+};
+
+#endif
@@ -1,6 +1,9 @@
 /*--------------------------------------------------------
   pprint.cpp
 	JHT, Febuary 7, 2022 : created
+	JHT, October 19, 2026 : packed log, gatherv printing
+	JHT, October 19, 2026 : print_all_begin sends the logs point to point,
+	                        so no task waits in it
 
 
   .cpp file for pprint, which stores (potentially parallel)
@@ -15,7 +18,14 @@ Pprint::Pprint()
   idx = 0;
   memset(buffer,(char)0,sizeof(char)*PPRINT_LEN);
   memset(stemp,(char)0,sizeof(char)*PPRINT_LEN);
-  pbuffer = NULL;
+  sendinfo[0] = 0;
+  sendinfo[1] = 0;
+  pending = false;
+  #if defined LIBJ_MPI
+  req_info = MPI_REQUEST_NULL;
+  req_log = MPI_REQUEST_NULL;
+  comm_print = MPI_COMM_NULL;
+  #endif
 }
 
 //--------------------------------------------------------
@@ -23,7 +33,6 @@ Pprint::Pprint()
 //--------------------------------------------------------
 Pprint::~Pprint()
 {
-  if (pbuffer != NULL) free(pbuffer);
 }
 
 //--------------------------------------------------------
@@ -31,21 +40,17 @@ Pprint::~Pprint()
 //--------------------------------------------------------
 int Pprint::init(const Pworld& pworld)
 {
-  int stat = 0;
+  const int ntask = pworld.mpi_world_num_tasks;
+  #if defined LIBJ_MPI
+  MPI_Comm_dup(pworld.comm_world,&comm_print);
+  #endif
   if (pworld.mpi_world_ismaster)
   {
-    pbuffer = (char*) malloc(sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
-    if (pbuffer != NULL)
-    {
-      stat = 0;
-    } else {
-      printf("\nERROR ERROR ERORR\n");
-      printf("Pprint::init could not malloc %ld bytes\n",
-             sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
-      stat = 1;
-    } 
-  }          
-  return stat;
+    counts.assign(2*ntask,0);
+    bytes.assign(ntask,0);
+    displs.assign(ntask,0);
+  } 
+  return 0;
 }
 
 //--------------------------------------------------------
@@ -53,13 +58,14 @@ int Pprint::init(const Pworld& pworld)
 //--------------------------------------------------------
 int Pprint::destroy(const Pworld& pworld)
 {
-  int stat = 0;
-  if (pworld.mpi_world_ismaster)
-  {
-    if (pbuffer != NULL) free(pbuffer);
-    pbuffer = NULL;
-  } 
-  return stat;
+  if (pending) {print_all_end(pworld);}
+  reset();
+  std::vector<char>().swap(sendlog);
+  std::vector<char>().swap(recvlog);
+  #if defined LIBJ_MPI
+  if (comm_print != MPI_COMM_NULL) {MPI_Comm_free(&comm_print);}
+  #endif
+  return 0;
 }
 
 //--------------------------------------------------------
@@ -132,7 +138,8 @@ int Pprint::vadd(const char* fstring, va_list arg)
 //--------------------------------------------------------
 void Pprint::store()
 {
-  vec.push_back(buffer);
+  offs.push_back((int) log.size());
+  log.insert(log.end(),buffer,buffer+idx+1); //keep the '\0'
   clear();
 }
 
@@ -162,85 +169,217 @@ void Pprint::clear()
 //--------------------------------------------------------
 void Pprint::reset()
 {
-  vec.clear();
+  log.clear();
+  offs.clear();
   clear();
 }
 
+//--------------------------------------------------------
+// print_gathered -- print the packed logs of all tasks, 
+//   message major. counts holds (messages,bytes) of each 
+//   task
+//--------------------------------------------------------
+static void print_gathered(const int ntask, const int* counts,
+                           const int* displs, const char* logs)
+{
+  int max_messages = 0;
+  for (int task=0;task<ntask;task++) 
+  {
+    if (counts[2*task] > max_messages) {max_messages = counts[2*task];}
+  }
+
+  //walk through each task's log, one message at a time
+  std::vector<const char*> next(ntask);
+  for (int task=0;task<ntask;task++) {next[task] = logs + displs[task];}
+
+  for (int message=0;message<max_messages;message++)
+  {
+    for (int task=0;task<ntask;task++)
+    {
+      if (message >= counts[2*task]) {continue;}
+      printf("%s",next[task]);
+      next[task] += strlen(next[task]) + 1;
+    }
+  }
+}
+
+#if defined LIBJ_MPI
+//--------------------------------------------------------
+// gather_displs -- log bytes and displacements from counts
+//--------------------------------------------------------
+static int gather_displs(const int ntask, const std::vector<int>& counts,
+                         std::vector<int>& bytes, std::vector<int>& displs)
+{
+  bytes.resize(ntask);
+  displs.resize(ntask);
+  int total = 0;
+  for (int task=0;task<ntask;task++)
+  {
+    bytes[task] = counts[2*task+1];
+    displs[task] = total;
+    total += bytes[task];
+  }
+  return total;
+}
+#endif
+
 //--------------------------------------------------------
 // print_all 
+//   One gather of the message counts and one gatherv of the
+//   packed logs. The master prints the n'th message of every 
+//   task before the n+1'th
 //--------------------------------------------------------
-void Pprint::print_all(const Pworld& pworld) const
+void Pprint::print_all(const Pworld& pworld)
 {
+  if (pending) {print_all_end(pworld);}
+
   //MPI code
   #if defined LIBJ_MPI
-  for (int message=0;message<vec.size;message++)
+  const int ntask = pworld.mpi_world_num_tasks;
+  sendinfo[0] = (int) offs.size();
+  sendinfo[1] = (int) log.size();
+  if (pworld.mpi_world_ismaster) {counts.resize(2*ntask);}
+  MPI_Gather(sendinfo,2,MPI_INT,
+             counts.data(),2,MPI_INT,
+             0,pworld.comm_world);
+
+  int total = 0;
+  if (pworld.mpi_world_ismaster)
   {
-    //gather messages
-    MPI_Barrier(pworld.comm_world);
-
-    MPI_Gather(vec[message],
-               PPRINT_LEN,MPI_CHAR,
-               pbuffer+PPRINT_LEN*pworld.mpi_world_task_id,
-               PPRINT_LEN,MPI_CHAR,
-               0,
-               pworld.comm_world);
-
-    //Print each message
-    if (pworld.mpi_world_ismaster)
-    {
-      for (int task=0;task<pworld.mpi_world_num_tasks;task++)
-      {
-        printf("%s",pbuffer+PPRINT_LEN*task);
-      }
+    total = gather_displs(ntask,counts,bytes,displs);
+    recvlog.resize(total > 0 ? total : 1);
+  }
+  MPI_Gatherv(log.data(),sendinfo[1],MPI_CHAR,
+              recvlog.data(),bytes.data(),displs.data(),MPI_CHAR,
+              0,pworld.comm_world);
 
-      //clean the message buffer
-      memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
-    }
+  if (pworld.mpi_world_ismaster && total > 0)
+  {
+    print_gathered(ntask,counts.data(),displs.data(),recvlog.data());
+  }
 
-  } 
+  //Non-MPI code
+  #else
+  const int info[2] = {(int) offs.size(),(int) log.size()};
+  const int displ = 0;
+  if (!log.empty()) {print_gathered(1,info,&displ,log.data());}
+  #endif
+}
+
+//--------------------------------------------------------
+// print_all_begin 
+//   Start printing all stored messages, and reset. The log
+//   is moved to sendlog, and the tasks other than the master
+//   post sends of their counts and logs, on comm_print. No 
+//   task waits, and as these are not collectives, others 
+//   may run before print_all_end
+//--------------------------------------------------------
+void Pprint::print_all_begin(const Pworld& pworld)
+{
+  if (pending) {print_all_end(pworld);}
+
+  //MPI code
+  #if defined LIBJ_MPI
+  sendlog.swap(log);
+  sendinfo[0] = (int) offs.size();
+  sendinfo[1] = (int) sendlog.size();
+  reset();
+
+  if (!pworld.mpi_world_ismaster)
+  {
+    MPI_Isend(sendinfo,2,MPI_INT,0,PPRINT_TAG_INFO,comm_print,&req_info);
+    MPI_Isend(sendlog.data(),sendinfo[1],MPI_CHAR,0,PPRINT_TAG_LOG,
+              comm_print,&req_log);
+  }
+  pending = true;
 
   //Non-MPI code
   #else
-  for (int message=0;message<vec.size;message++)
+  print_all(pworld);
+  reset();
+  #endif
+}
+
+//--------------------------------------------------------
+// print_all_end 
+//   Finish the print started by print_all_begin. The master
+//   receives the counts and logs of every task, and prints
+//--------------------------------------------------------
+void Pprint::print_all_end(const Pworld& pworld)
+{
+  if (!pending) {return;}
+
+  #if defined LIBJ_MPI
+  if (pworld.mpi_world_ismaster)
   {
-    printf("%s",vec[message]);
-    memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
+    const int ntask = pworld.mpi_world_num_tasks;
+    counts.resize(2*ntask);
+    counts[0] = sendinfo[0];
+    counts[1] = sendinfo[1];
+    for (int task=1;task<ntask;task++)
+    {
+      MPI_Recv(&counts[2*task],2,MPI_INT,task,PPRINT_TAG_INFO,comm_print,
+               MPI_STATUS_IGNORE);
+    }
+    const int total = gather_displs(ntask,counts,bytes,displs);
+    recvlog.resize(total > 0 ? total : 1);
+    if (sendinfo[1] > 0) {memcpy(recvlog.data(),sendlog.data(),sendinfo[1]);}
+
+    std::vector<MPI_Request> reqs(ntask,MPI_REQUEST_NULL);
+    for (int task=1;task<ntask;task++)
+    {
+      MPI_Irecv(recvlog.data()+displs[task],bytes[task],MPI_CHAR,task,
+                PPRINT_TAG_LOG,comm_print,&reqs[task]);
+    }
+    MPI_Waitall(ntask,reqs.data(),MPI_STATUSES_IGNORE);
+    if (total > 0) {print_gathered(ntask,counts.data(),displs.data(),recvlog.data());}
+  } else {
+    MPI_Request reqs[2] = {req_info,req_log};
+    MPI_Waitall(2,reqs,MPI_STATUSES_IGNORE);
+    req_info = MPI_REQUEST_NULL;
+    req_log = MPI_REQUEST_NULL;
   }
+  sendlog.clear();
   #endif
 
+  pending = false;
 }
 
 //-------------------------------------------------------------------
 // Print specific message
 void Pprint::print(const Pworld& pworld, const int message) const
 {
+  const char* msg = (message >= 0 && message < size()) ? this->message(message) : "";
 
   //MPI code
   #if defined LIBJ_MPI
-  //gather messages
-  MPI_Barrier(pworld.comm_world);
-  MPI_Gather(vec[message],
-             PPRINT_LEN,MPI_CHAR,
-             pbuffer+PPRINT_LEN*pworld.mpi_world_task_id,
-             PPRINT_LEN,MPI_CHAR,
-             0,
-             pworld.comm_world);
+  const int ntask = pworld.mpi_world_num_tasks;
+  const int len = (int) strlen(msg) + 1;
+  std::vector<int> lens, displ;
+  std::vector<char> buf;
+  if (pworld.mpi_world_ismaster) {lens.resize(ntask); displ.resize(ntask);}
+  MPI_Gather(&len,1,MPI_INT,
+             lens.data(),1,MPI_INT,
+             0,pworld.comm_world);
 
-  //Print each message
   if (pworld.mpi_world_ismaster)
   {
-    for (int task=0;task<pworld.mpi_world_num_tasks;task++)
-    {
-      printf("%s",pbuffer+PPRINT_LEN*task);
-    }
+    int total = 0;
+    for (int task=0;task<ntask;task++) {displ[task] = total; total += lens[task];}
+    buf.resize(total);
+  }
+  MPI_Gatherv(msg,len,MPI_CHAR,
+              buf.data(),lens.data(),displ.data(),MPI_CHAR,
+              0,pworld.comm_world);
 
-    //clean the message buffer
-    memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
+  //Print each message
+  if (pworld.mpi_world_ismaster)
+  {
+    for (int task=0;task<ntask;task++) {printf("%s",buf.data()+displ[task]);}
   }
 
   //Non-MPI code
   #else
-  printf("%s",vec[message]);
-  memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
+  printf("%s",msg);
   #endif
 }
@@ -1,6 +1,10 @@
 /*------------------------------------------------------------------------
   pprint.h
 	JHT, Feburary 4, 2022 : created
+	JHT, October 19, 2026 : packed log, one gather per flush, nonblocking
+	                        flushes
+	JHT, October 19, 2026 : print_all_begin sends the logs point to point,
+	                        so no task waits in it
 
   .h file for Prprint and Stringvec
 
@@ -29,6 +33,21 @@ buf.addstore("testing testing"); //add and store buffer in one step
 buf.print_all();		 //print all messages
 buf.print(2);                    //prints the n'th message, index from zero
 
+//Nonblocking printing
+buf.print_all_begin(pworld);	 //start gathering all messages, and reset
+buf.print_all_end(pworld);	 //finish the gather, the master prints
+
+  Stored messages are packed, one after another, into a variable length
+  log on each task. Printing gathers the message counts and then the
+  packed logs to the master with one gatherv, and the master prints the
+  n'th message of every task (in task order) before the n+1'th. There is
+  no barrier. print_all_begin only posts nonblocking sends of the counts
+  and logs to the master, on comm_print (a duplicate of comm_world), and
+  no task waits in it, the master included. They are not collectives,
+  so others may run before print_all_end, where the master receives and
+  prints. At most one nonblocking print is outstanding, and a new one
+  (or print_all) first finishes the last.
+
 //Clearing
 buf.clear();			 //clears an unstored buffer
 buf.reset();			 //reset buffer and stored messages
@@ -41,12 +60,15 @@ buf.reset();			 //reset buffer and stored messages
 #include <stdlib.h>
 #include <stdarg.h>
 
+#include <vector>
+
 #include "libjdef.h"
 #include "pworld.hpp"
-#include "strvec.hpp"
 
 #define PPRINT_RES 10
 #define PPRINT_LEN 1024 
+#define PPRINT_TAG_INFO 1 //message count and log bytes of a task
+#define PPRINT_TAG_LOG 2 //packed log of a task
 
 #if defined LIBJ_MPI
   #include <mpi.h> 
@@ -66,8 +88,22 @@ struct Pprint
   int                idx;
   char               stemp[PPRINT_LEN];
   char               buffer[PPRINT_LEN];
-  char*              pbuffer;
-  Strvec<PPRINT_LEN> vec;
+  std::vector<char>  log;		//stored messages, packed
+  std::vector<int>   offs;		//offset of each message in log
+
+  //nonblocking print state
+  std::vector<char>  sendlog;		//log being sent
+  std::vector<char>  recvlog;		//gathered logs (master)
+  std::vector<int>   counts;		//message counts and log bytes of each task
+  std::vector<int>   bytes;
+  std::vector<int>   displs;
+  int                sendinfo[2];	//message count and log bytes of this task
+  bool               pending;		//a nonblocking print is outstanding
+  #if defined LIBJ_MPI
+  MPI_Request        req_info;
+  MPI_Request        req_log;
+  MPI_Comm           comm_print;	//duplicate of comm_world for the sends
+  #endif
 
   //Initializer
   Pprint();
@@ -87,7 +123,7 @@ struct Pprint
   //Add a formatted string with variable input data
   int vadd(const char* fstring,va_list arg);
 
-  //Store buffer into vec, clear buffer
+  //Store buffer into the log, clear buffer
   void store();
 
   //Add and store
@@ -100,13 +136,20 @@ struct Pprint
   void reset();
 
   //print all messages
-  void print_all(const Pworld& pworld) const;
+  void print_all(const Pworld& pworld);
+
+  //nonblocking print of all messages, resets the stored messages
+  void print_all_begin(const Pworld& pworld);
+  void print_all_end(const Pworld& pworld);
 
   //print specific messages
   void print(const Pworld& pworld, const int message) const;
 
   //get size
-  int size() const {return vec.size;}
+  int size() const {return (int) offs.size();}
+
+  //get a stored message
+  const char* message(const int m) const {return log.data() + offs[m];}
 
 };
 
@@ -0,0 +1,202 @@
+/*------------------------------------------------------------------------
+ * pprogress.cpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : start may be called from any thread
+ *  JHT, October 19, 2026 : only threads allowed to call MPI poll
+ *
+ *  .cpp file for Pprogress, which drives nonblocking MPI requests
+------------------------------------------------------------------------*/
+#include "pprogress.hpp"
+#include <chrono>
+
+//-----------------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------------
+Pprogress::Pprogress()
+{
+  m_stop = false;
+  m_running = 0;
+  m_threaded = false;
+  m_multiple = false;
+  m_started = false;
+  m_interval = 50;
+}
+
+//-----------------------------------------------------------------------
+// Destructor
+//-----------------------------------------------------------------------
+Pprogress::~Pprogress()
+{
+  stop();
+}
+
+//-----------------------------------------------------------------------
+// start -- start the progress thread, if MPI allows other threads to
+//   call it. Any thread may call it, only the first starts
+//-----------------------------------------------------------------------
+int Pprogress::start(const Pworld& pworld, const int interval)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (m_started) {return 0;}
+  m_interval = (interval > 0) ? interval : 1;
+  m_stop = false;
+  m_started = true;
+  #if defined LIBJ_MPI
+  m_comm = pworld.comm_world;
+  m_multiple = pworld.mpi_thread_multiple;
+  m_threaded = pworld.mpi_thread_multiple;
+  if (m_threaded) {m_thread = std::thread(&Pprogress::m_loop,this);}
+  #endif
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// stop -- finish the outstanding requests, and stop the thread
+//-----------------------------------------------------------------------
+int Pprogress::stop()
+{
+  if (!m_started) {return 0;}
+  const int stat = wait_all();
+  m_stop = true;
+  if (m_thread.joinable()) {m_thread.join();}
+  m_threaded = false;
+  m_started = false;
+  return stat;
+}
+
+#if defined LIBJ_MPI
+
+//-----------------------------------------------------------------------
+// post -- hand a request to Pprogress
+//-----------------------------------------------------------------------
+int Pprogress::post(MPI_Request req)
+{
+  return post(req,callback());
+}
+
+int Pprogress::post(MPI_Request req, const callback& cb)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  m_req.push_back(req);
+  m_cb.push_back(cb);
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// m_may_call -- true if this thread may call MPI, which is any thread
+//   under MPI_THREAD_MULTIPLE, and otherwise only the main thread
+//-----------------------------------------------------------------------
+bool Pprogress::m_may_call() const
+{
+  if (m_multiple) {return true;}
+  int main = 0;
+  MPI_Is_thread_main(&main);
+  return main != 0;
+}
+
+//-----------------------------------------------------------------------
+// poll -- test the posted requests once, run the callbacks of those
+//   that completed. On a thread which may not call MPI nothing is
+//   tested, and the number outstanding is returned
+//-----------------------------------------------------------------------
+long Pprogress::poll()
+{
+  std::vector<callback>   done_cb;
+  std::vector<MPI_Status> done_stat;
+  long left;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_may_call()) {return (long) m_req.size();}
+    const int n = (int) m_req.size();
+    if (n == 0)
+    {
+      //nothing posted, just let MPI progress
+      if (m_threaded)
+      {
+        int flag;
+        MPI_Iprobe(MPI_ANY_SOURCE,MPI_ANY_TAG,m_comm,&flag,MPI_STATUS_IGNORE);
+      }
+      return 0;
+    }
+
+    std::vector<int>        indices(n);
+    std::vector<MPI_Status> stats(n);
+    int outcount = 0;
+    MPI_Testsome(n,m_req.data(),&outcount,indices.data(),stats.data());
+    if (outcount == MPI_UNDEFINED) {outcount = 0;}
+
+    for (int i=0;i<outcount;i++)
+    {
+      done_cb.push_back(m_cb[indices[i]]);
+      done_stat.push_back(stats[i]);
+    }
+
+    //completed requests are now MPI_REQUEST_NULL, compact
+    size_t keep = 0;
+    for (size_t i=0;i<m_req.size();i++)
+    {
+      if (m_req[i] != MPI_REQUEST_NULL)
+      {
+        m_req[keep] = m_req[i];
+        m_cb[keep] = m_cb[i];
+        keep++;
+      }
+    }
+    m_req.resize(keep);
+    m_cb.resize(keep);
+    left = (long) keep;
+    m_running += (long) done_cb.size();
+  }
+
+  if (!done_cb.empty())
+  {
+    for (size_t i=0;i<done_cb.size();i++)
+    {
+      if (done_cb[i]) {done_cb[i](done_stat[i]);}
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      m_running -= (long) done_cb.size();
+    }
+    m_done.notify_all();
+  }
+  return left;
+}
+
+//-----------------------------------------------------------------------
+// wait_all -- wait on all posted requests. Without a progress thread
+//   only a thread which may call MPI can wait, others get
+//   PPROGRESS_ERR_THREAD
+//-----------------------------------------------------------------------
+int Pprogress::wait_all()
+{
+  if (m_threaded)
+  {
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (!m_req.empty() || m_running > 0) {m_done.wait(guard);}
+  } else {
+    if (!m_may_call()) {return PPROGRESS_ERR_THREAD;}
+    while (poll() > 0) {}
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// m_loop -- the progress thread
+//-----------------------------------------------------------------------
+void Pprogress::m_loop()
+{
+  while (!m_stop)
+  {
+    poll();
+    std::this_thread::sleep_for(std::chrono::microseconds(m_interval));
+  }
+}
+
+#else
+
+long Pprogress::poll() {return 0;}
+int Pprogress::wait_all() {return 0;}
+void Pprogress::m_loop() {}
+
+#endif
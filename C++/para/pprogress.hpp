@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------
+ * pprogress.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : start may be called from any thread
+ *  JHT, October 19, 2026 : only threads allowed to call MPI poll
+ *
+   .hpp file for Pprogress, which drives nonblocking MPI requests to
+   completion while the OpenMP threads of a task compute.
+
+   Requests are posted with an optional callback, which is run (on the
+   progress thread) with the MPI_Status of the request once it
+   completes. When MPI provides MPI_THREAD_MULTIPLE, a progress thread
+   tests the posted requests, and otherwise pokes the MPI progress
+   engine, every interval microseconds. Without MPI_THREAD_MULTIPLE no
+   thread is started, and the requests are progressed by poll, which is
+   called from wait_all and by Para::taskwait. poll only calls MPI on a
+   thread the MPI thread level allows to, which without
+   MPI_THREAD_MULTIPLE is the main thread (MPI_Is_thread_main), and on
+   other threads does nothing.
+
+  General usage
+
+  Pprogress pprogress;
+  pprogress.start(pworld,50);		//50 us polling interval
+  MPI_Request req;
+  MPI_Irecv(buf,n,MPI_DOUBLE,src,tag,comm,&req);
+  pprogress.post(req,[&](const MPI_Status& s){ ... });
+  ... compute ...
+  pprogress.wait_all();
+  pprogress.stop();
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PPROGRESS_HPP
+#define LIBJ_PPROGRESS_HPP
+#include <stdio.h>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+//Error message integers
+#define PPROGRESS_ERR_THREAD -1 //this thread may not call MPI to wait
+
+class Pprogress
+{
+  private:
+  #if defined LIBJ_MPI
+  typedef std::function<void(const MPI_Status&)> callback;
+
+  std::vector<MPI_Request>  m_req;	//posted requests
+  std::vector<callback>     m_cb;	//their callbacks
+  MPI_Comm                  m_comm;	//communicator to poke progress on
+  #endif
+  std::thread               m_thread;	//progress thread
+  std::mutex                m_lock;
+  std::condition_variable   m_done;	//signals completions
+  std::atomic<bool>         m_stop;
+  long                      m_running;	//callbacks being run
+  std::atomic<bool>         m_threaded;
+  bool                      m_multiple;	//any thread may call MPI
+  std::atomic<bool>         m_started;
+  int                       m_interval;	//microseconds between polls
+
+  void m_loop();
+  #if defined LIBJ_MPI
+  bool m_may_call() const;
+  #endif
+
+  public:
+  Pprogress();
+  ~Pprogress();
+
+  //start and stop progress
+  int start(const Pworld& pworld, const int interval);
+  int stop();
+  bool threaded() const {return m_threaded;}
+
+  #if defined LIBJ_MPI
+  //post a request, which Pprogress now owns
+  int post(MPI_Request req);
+  int post(MPI_Request req, const std::function<void(const MPI_Status&)>& cb);
+  #endif
+
+  //test the posted requests once, returns the number still outstanding
+  long poll();
+
+  //wait on all posted requests
+  int wait_all();
+
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*------------------------------------------------------------------------
+ * psched.cpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : finish drops the items
+ *
+ *  .cpp file for Psched, a distributed work queue over Pdata indexes
+------------------------------------------------------------------------*/
+#include "psched.hpp"
+#include <algorithm>
+
+//-----------------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------------
+Psched::Psched()
+{
+  m_policy = PSCHED_COUNTER;
+  m_task_id = 0;
+  m_num_stolen = 0;
+  m_started = false;
+  m_local = 0;
+  #if defined LIBJ_MPI
+  m_win = MPI_WIN_NULL;
+  m_counter = NULL;
+  #endif
+}
+
+//-----------------------------------------------------------------------
+// add_list -- add the indexes of a list as work items
+//-----------------------------------------------------------------------
+int Psched::add_list(const Pdata& pdata, const long list_id)
+{
+  if (m_started) {return PSCHED_ERR_STARTED;}
+  for (long index=0;index<pdata.num_index(list_id);index++)
+  {
+    const Pindex_info& info = pdata.index_info(list_id,index);
+    m_items.push_back({list_id,index,info.m_size,info.m_storage_task});
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// start -- sort the items, build the queues and the counters
+//-----------------------------------------------------------------------
+int Psched::start(const Pworld& pworld, const int policy)
+{
+  if (m_started) {return PSCHED_ERR_STARTED;}
+  m_policy = policy;
+  m_task_id = pworld.mpi_world_task_id;
+  m_num_stolen = 0;
+  const int ntask = pworld.mpi_world_num_tasks;
+
+  //heaviest first, ties in the order they were added
+  std::stable_sort(m_items.begin(),m_items.end(),
+                   [](const Psched_item& a, const Psched_item& b)
+                   {return a.m_weight > b.m_weight;});
+
+  //queues and the order we take from them
+  m_victims.clear();
+  if (m_policy == PSCHED_STEAL && ntask > 1)
+  {
+    m_queue.assign(ntask,std::vector<long>());
+    for (long item=0;item<(long) m_items.size();item++)
+    {
+      int owner = m_items[item].m_owner;
+      if (owner < 0 || owner >= ntask) {owner = (int) (item % ntask);}
+      m_queue[owner].push_back(item);
+    }
+
+    //self, then the node, then everyone else, each starting after self
+    std::vector<int> node(ntask,0);
+    #if defined LIBJ_MPI
+    int root = m_task_id;
+    MPI_Bcast(&root,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+    MPI_Allgather(&root,1,MPI_INT,node.data(),1,MPI_INT,pworld.comm_world);
+    #endif
+    m_victims.push_back(m_task_id);
+    for (int i=1;i<ntask;i++)
+    {
+      const int task = (m_task_id+i) % ntask;
+      if (node[task] == node[m_task_id]) {m_victims.push_back(task);}
+    }
+    for (int i=1;i<ntask;i++)
+    {
+      const int task = (m_task_id+i) % ntask;
+      if (node[task] != node[m_task_id]) {m_victims.push_back(task);}
+    }
+
+  } else {
+    m_policy = PSCHED_COUNTER;
+    m_queue.assign(1,std::vector<long>());
+    for (long item=0;item<(long) m_items.size();item++) {m_queue[0].push_back(item);}
+    m_victims.push_back(0);
+  }
+  m_empty.assign(m_queue.size(),0);
+
+  //counters
+  m_local = 0;
+  #if defined LIBJ_MPI
+  if (MPI_Win_allocate(sizeof(long),sizeof(long),MPI_INFO_NULL,pworld.comm_world,
+                       &m_counter,&m_win) != MPI_SUCCESS) {return PSCHED_ERR_WIN;}
+  *m_counter = 0;
+  MPI_Barrier(pworld.comm_world);
+  MPI_Win_lock_all(0,m_win);
+  #endif
+
+  m_started = true;
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// finish -- free the counters and drop the items, collective
+//-----------------------------------------------------------------------
+int Psched::finish(const Pworld&)
+{
+  if (!m_started) {return 0;}
+  #if defined LIBJ_MPI
+  MPI_Win_unlock_all(m_win);
+  MPI_Win_free(&m_win);
+  m_counter = NULL;
+  #endif
+  m_items.clear();
+  m_queue.clear();
+  m_victims.clear();
+  m_empty.clear();
+  m_local = 0;
+  m_started = false;
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// m_fetch -- take the next position of a queue
+//-----------------------------------------------------------------------
+long Psched::m_fetch(const int queue)
+{
+  #if defined LIBJ_MPI
+  const long one = 1;
+  long pos = 0;
+  MPI_Fetch_and_op(&one,&pos,MPI_LONG,queue,0,MPI_SUM,m_win);
+  MPI_Win_flush(queue,m_win);
+  return pos;
+  #else
+  return m_local++;
+  #endif
+}
+
+//-----------------------------------------------------------------------
+// next -- the next item, from our own queue first and then the others
+//-----------------------------------------------------------------------
+bool Psched::next(long& list_id, long& index)
+{
+  if (!m_started) {return false;}
+  for (size_t v=0;v<m_victims.size();v++)
+  {
+    const int queue = m_victims[v];
+    if (m_empty[queue]) {continue;}
+
+    const long pos = m_fetch(queue);
+    if (pos < (long) m_queue[queue].size())
+    {
+      const Psched_item& item = m_items[m_queue[queue][pos]];
+      list_id = item.m_list;
+      index = item.m_index;
+      if (m_policy == PSCHED_STEAL && queue != m_task_id) {m_num_stolen++;}
+      return true;
+    }
+    m_empty[queue] = 1;
+  }
+  return false;
+}
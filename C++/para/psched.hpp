@@ -0,0 +1,117 @@
+/*------------------------------------------------------------------------
+ * psched.hpp
+ *  JHT, October 19, 2026 : created
+ *  JHT, October 19, 2026 : finish drops the items
+ *
+   .hpp file for Psched, a distributed work queue which hands out the
+   (list, index) pairs of Pdata lists to the tasks of comm_world as they
+   ask for them.
+
+   Every task builds the same list of work items from the lists it was
+   given, weighted by the number of elements of each index (m_size), and
+   sorted heaviest first, so the expensive items start early and the
+   cheap ones fill in at the end.
+
+   There are two policies
+     PSCHED_COUNTER	: one queue of all items, with a shared counter on
+			  task 0 incremented with MPI_Fetch_and_op
+     PSCHED_STEAL	: each task has a queue of the items whose data it
+			  stores (m_storage_task), with a counter in its own
+			  window. A task works through its own queue first,
+			  and then steals from the queues of the other tasks
+			  of its node (comm_shared), and then from the rest
+			  of comm_world. Items are taken with MPI_Fetch_and_op
+			  on the counter of the owning queue, so owner and
+			  thieves never hand out the same item twice
+
+   start and finish are collective. finish drops the items, so each
+   round of work adds its lists again before start. Without MPI every
+   item goes to the one task, in order of weight.
+
+  General usage
+
+  Psched sched;
+  sched.add_list(pdata,list_id);
+  sched.start(pworld,PSCHED_STEAL);
+  long list, index;
+  while (sched.next(list,index))
+  {
+    ... work on index of list ...
+  }
+  sched.finish(pworld);
+  sched.num_stolen();		//items this task took from other queues
+
+------------------------------------------------------------------------*/
+#ifndef LIBJ_PSCHED_HPP
+#define LIBJ_PSCHED_HPP
+#include <stdio.h>
+#include <vector>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "pdata.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+//Policies
+#define PSCHED_COUNTER 0
+#define PSCHED_STEAL 1
+
+//Error message integers
+#define PSCHED_ERR_WIN -1 //counter windows could not be made
+#define PSCHED_ERR_STARTED -2 //start called twice, or add_list after start
+
+/*
+ * A work item
+*/
+struct Psched_item
+{
+  long m_list;
+  long m_index;
+  long m_weight;
+  int  m_owner;
+};
+
+class Psched
+{
+  private:
+  //Data
+  std::vector<Psched_item>        m_items;    //all items, heaviest first
+  std::vector<std::vector<long>>  m_queue;    //item ids of each queue
+  std::vector<int>                m_victims;  //queues to take from, in order
+  std::vector<int>                m_empty;    //1 if queue is known empty
+  int                             m_policy;
+  int                             m_task_id;
+  long                            m_num_stolen;
+  bool                            m_started;
+  #if defined LIBJ_MPI
+  MPI_Win                         m_win;      //queue counters
+  long*                           m_counter;
+  #endif
+  long                            m_local;    //counter without MPI
+
+  long m_fetch(const int queue);
+
+  public:
+  //Constructor/destructor
+  Psched();
+
+  //add the indexes of a list as work items, same order on all tasks
+  int add_list(const Pdata& pdata, const long list_id);
+
+  //start and finish handing out work, collective
+  int start(const Pworld& pworld, const int policy);
+  int finish(const Pworld& pworld);
+
+  //next item, returns false when there is no work left
+  bool next(long& list_id, long& index);
+
+  //info
+  long num_items() const {return (long) m_items.size();}
+  long num_stolen() const {return m_num_stolen;}
+
+};
+
+#endif
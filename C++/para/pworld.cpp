@@ -1,21 +1,51 @@
 /*-----------------------------------------------------------------
   pworld.cpp
 	JHT, Febuary 9, 2022 : created
+	JHT, October 19, 2026 : MPI is initialized with MPI_Init_thread
+	JHT, October 19, 2026 : init keeps the thread support of MPI_Init
 
   .cpp file for pworld
 -----------------------------------------------------------------*/
 #include "pworld.hpp"
 
 //-----------------------------------------------------------------
-// initialize
+// initialize, with the default thread support of MPI_Init
 //-----------------------------------------------------------------
 int Pworld::init()
+{
+  #if defined LIBJ_MPI
+    MPI_Init(NULL,NULL);
+    MPI_Query_thread(&mpi_thread_level);
+  #endif
+  return m_init_rest();
+}
+
+//-----------------------------------------------------------------
+// initialize, requesting thread_level support from MPI
+//-----------------------------------------------------------------
+#if defined LIBJ_MPI
+int Pworld::init(const int thread_level)
+{
+  MPI_Init_thread(NULL,NULL,thread_level,&mpi_thread_level);
+  return m_init_rest();
+}
+#else
+int Pworld::init(const int)
+{
+  return m_init_rest();
+}
+#endif
+
+//-----------------------------------------------------------------
+// m_init_rest -- initialization after MPI is started
+//-----------------------------------------------------------------
+int Pworld::m_init_rest()
 {
   #if defined LIBJ_MPI
     ismpi = true;
 
     //initial setup
-    MPI_Init(NULL,NULL);
+    mpi_thread_multiple = (mpi_thread_level == MPI_THREAD_MULTIPLE);
     MPI_Info_create(&mpi_info);
 
     //MPI world setup
@@ -35,6 +65,8 @@ int Pworld::init()
     
   #else
     ismpi = false;
+    mpi_thread_level = 0;
+    mpi_thread_multiple = true;
 
     mpi_world_num_tasks=1;
     mpi_world_task_id=0;
@@ -1,13 +1,19 @@
 /*-----------------------------------------------------------------
   pworld.hpp
 	JHT, Febuary 7, 2022 : created
+	JHT, October 19, 2026 : MPI is initialized with MPI_Init_thread
+	JHT, October 19, 2026 : init keeps the thread support of MPI_Init
 
   .hpp file for Pworld, which manages the initialization and 
   finalization of MPI parameters if they are required. This struct
   also carries most of the general MPI information
 
 //Usage
-init()		: initializes variables and structures
+init()		: initializes variables and structures, with the
+		  thread support MPI_Init gives
+init(level)	: as init, requesting thread support level (for
+		  example MPI_THREAD_MULTIPLE, for the progress thread
+		  of Para)
 destroy()	: finalizes variables and structures
 
 //Communicators
@@ -46,6 +52,8 @@ struct Pworld
   bool mpi_world_ismaster;	//is world master 
   bool mpi_shared_ismaster;	//is shared master 
   bool mpi_doesIO;		//if true, this task does file IO
+  int mpi_thread_level;		//thread support provided by MPI
+  bool mpi_thread_multiple;	//any thread may call MPI
 
   //MPI communicators
   #if defined LIBJ_MPI
@@ -56,10 +64,14 @@ struct Pworld
 
   //Initialize
   int init();
+  int init(const int thread_level);
   
   //Destruction
   int destroy();
 
+  private:
+  int m_init_rest();
+
 };
 
 #endif
@@ -0,0 +1,68 @@
+#include "pio.hpp"
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+//checks the error paths of Pio : each error is reported by exactly one
+//  wait, wait_file or wait_all, and idle() only once it is reported
+
+const char* FNAME = "test3.bin";
+
+int check(const char* name, const bool ok)
+{
+  printf("%-40s %s\n",name,ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+int main()
+{
+  int bad = 0;
+  Pio pio;
+  if (pio.init(2) != 0) {printf("Pio init failed\n"); return 1;}
+
+  //a file of 1024 bytes
+  std::vector<char> buf(4096,'a');
+  const int fd = open(FNAME,O_RDWR | O_CREAT | O_TRUNC,0644);
+  Pio_handle h = pio.write(0,fd,0,buf.data(),1024);
+  bad += check("write",pio.wait(h) == 0);
+  bad += check("idle after write",pio.idle());
+
+  //reading past the end, reported by wait only
+  h = pio.read(0,fd,4096,buf.data(),1024);
+  bad += check("short read, wait",pio.wait(h) == PIO_ERR_SHORT);
+  bad += check("short read, idle after wait",pio.idle());
+  bad += check("short read, wait_file after wait",pio.wait_file(0) == 0);
+  bad += check("short read, wait_all after wait",pio.wait_all() == 0);
+
+  //reported by wait_file once, and not by another file
+  h = pio.read(0,fd,4096,buf.data(),1024);
+  pio.wait_idle(0);
+  bad += check("short read, not idle before wait_file",!pio.idle());
+  bad += check("short read, wait_file of another file",pio.wait_file(1) == 0);
+  bad += check("short read, wait_file",pio.wait_file(0) == PIO_ERR_SHORT);
+  bad += check("short read, wait_file again",pio.wait_file(0) == 0);
+  bad += check("short read, idle after wait_file",pio.idle());
+
+  //a write to a read only descriptor, reported by wait_all once
+  const int rfd = open(FNAME,O_RDONLY);
+  h = pio.write(1,rfd,0,buf.data(),1024);
+  bad += check("bad write, wait_all",pio.wait_all() == PIO_ERR_IO);
+  bad += check("bad write, wait_all again",pio.wait_all() == 0);
+  bad += check("bad write, idle after wait_all",pio.idle());
+
+  //only the error of the waited request is dropped
+  Pio_handle g = pio.read(0,fd,8192,buf.data(),16);
+  h = pio.write(1,rfd,2048,buf.data(),16);
+  bad += check("two errors, wait",pio.wait(g) == PIO_ERR_SHORT);
+  pio.wait_idle(1);
+  bad += check("two errors, not idle",!pio.idle());
+  bad += check("two errors, wait_all",pio.wait_all() == PIO_ERR_IO);
+  bad += check("two errors, idle",pio.idle());
+
+  close(rfd);
+  close(fd);
+  remove(FNAME);
+  pio.destroy();
+  return bad != 0;
+}
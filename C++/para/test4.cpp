@@ -0,0 +1,72 @@
+#include "pcodec.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+//checks Pcodec round trips : lossless for LZ, within the tolerance for
+//  lossy, and that corrupt or wrongly sized data is refused
+
+int check(const char* name, const bool ok)
+{
+  printf("%-40s %s\n",name,ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+int main()
+{
+  int bad = 0;
+
+  //several blocks of doubles, smooth with a few exact special values
+  const long n = 3*PCODEC_BLOCK/sizeof(double) + 123;
+  std::vector<double> x(n);
+  for (long i=0;i<n;i++) {x[i] = 1.e-3*sin(1.e-3*i) + ((i % 97 == 0) ? 1.e300 : 0.0);}
+  x[5] = NAN;
+  x[6] = -INFINITY;
+  const long bytes = n*(long) sizeof(double);
+
+  //lossless
+  std::vector<char> cbuf;
+  std::vector<double> y(n);
+  long cbytes = Pcodec::compress(PCODEC_LZ,0.0,x.data(),bytes,cbuf);
+  bad += check("LZ compress",cbytes > 0);
+  bad += check("LZ decompress",Pcodec::decompress(cbuf.data(),cbytes,y.data(),bytes) == 0);
+  bad += check("LZ round trip",memcmp(x.data(),y.data(),bytes) == 0);
+
+  //lossy, within tol, with the special values exact
+  const double tol = 1.e-8;
+  cbytes = Pcodec::compress(PCODEC_LOSSY,tol,x.data(),bytes,cbuf);
+  bad += check("lossy compress",cbytes > 0 && cbytes < bytes);
+  bad += check("lossy decompress",Pcodec::decompress(cbuf.data(),cbytes,y.data(),bytes) == 0);
+  long far = 0;
+  for (long i=0;i<n;i++)
+  {
+    if (i == 5) {continue;}
+    if (x[i] >= 1.e300 || i == 6) {if (x[i] != y[i]) {far++;} continue;}
+    if (fabs(x[i]-y[i]) > tol) {far++;}
+  }
+  bad += check("lossy within tol",far == 0);
+  bad += check("lossy keeps NaN",y[5] != y[5]);
+
+  //random bytes do not shrink, and come back as they were
+  std::vector<unsigned char> r(PCODEC_BLOCK+7);
+  unsigned int seed = 12345;
+  for (size_t i=0;i<r.size();i++) {seed = seed*1103515245u + 12345u; r[i] = seed >> 24;}
+  std::vector<unsigned char> rr(r.size());
+  cbytes = Pcodec::compress(PCODEC_LZ,0.0,r.data(),(long) r.size(),cbuf);
+  bad += check("LZ incompressible",cbytes > 0 &&
+               Pcodec::decompress(cbuf.data(),cbytes,rr.data(),(long) rr.size()) == 0 &&
+               r == rr);
+
+  //errors
+  bad += check("unknown codec",Pcodec::compress(7,0.0,x.data(),bytes,cbuf) == PCODEC_ERR_CODEC);
+  bad += check("lossy on odd bytes",
+               Pcodec::compress(PCODEC_LOSSY,tol,x.data(),bytes-1,cbuf) == PCODEC_ERR_CODEC);
+  cbytes = Pcodec::compress(PCODEC_LZ,0.0,x.data(),bytes,cbuf);
+  bad += check("wrong size",
+               Pcodec::decompress(cbuf.data(),cbytes,y.data(),bytes-8) == PCODEC_ERR_DATA);
+  bad += check("truncated",
+               Pcodec::decompress(cbuf.data(),cbytes/2,y.data(),bytes) == PCODEC_ERR_DATA);
+
+  return bad != 0;
+}
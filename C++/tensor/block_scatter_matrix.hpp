@@ -1,20 +1,29 @@
 /*----------------------------------------------------------------------------
   block_scatter_matrix.hpp
 	JHT, April 29, 2022 : created
+	JHT, October 19, 2026 : merged with block_scatter_matrix2, metadata storage
+	                        is a policy
 
-  .hpp file for the block_scatter_matrix class, which is used to access a 
-  tensor_matrix in an out-of-order fashion. This is the blocked 
-  version of this   
+  .hpp file for the block_scatter_matrix class, which is used to access a
+  tensor_matrix in an out-of-order fashion. This is the blocked
+  version of this
 
   This is constructed from a tensor_matrix, which has already performed the
-  matrixification proccess. 
+  matrixification proccess.
 
   NOTE : we const_cast the buffer pointer from the references tensor_matrix,
          be super careful that you are calling const when you need to be...
 
+  The scatter vector storage is set by a policy (see meta_policy.hpp)
+    libj::block_scatter_matrix<T>			//std::vector scatter vectors,
+							//  sizes set at runtime
+    libj::block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>	//std::array scatter vectors of
+							//  at most NROW x NCOL, blocked
+							//  by RBL x CBL. No allocations.
+
   Useful functions
   ------------------------
-  
+
   Blocking information:
   T.block_num(dim); 		//number of blocks in dimension "dim"
   T.block_size(dim);		//size of blocks in dimension "dim"
@@ -22,11 +31,20 @@
   T.block_stride(dim,block);	//stride of block "block" in dimension "dim"
   T.next_block_index(dim,index);//returns the starting index of the next block
 
+  Scatter information (read only):
+  T.row_scatter(); T.col_scatter();		//scatter vectors
+  T.row_block_strides(); T.col_block_strides();	//block stride vectors
+
   Assigning to a block of a tensor_matrix
   T.assign_to_block(MATRIX,row_start,col_start,
                    row_len,col_len,
                    row_block_len,col_block_len);
 
+  For the fixed version, the lengths default to the template parameters
+  T.assign_to_block(MATRIX,row_start,col_start);
+
+  In both cases the block is clipped to the end of the tensor_matrix
+
 ----------------------------------------------------------------------------*/
 #ifndef BLOCK_SCATTER_MATRIX_HPP
 #define BLOCK_SCATTER_MATRIX_HPP
@@ -34,114 +52,140 @@
 #include "tensor.hpp"
 #include "tensor_matrix.hpp"
 #include "index_bundle.hpp"
+#include "meta_policy.hpp"
 #include "alignment.hpp"
 #include <stdlib.h>
 #include <string>
 #include <vector>
 #include <array>
+#include <algorithm>
 
 namespace libj
 {
 
 //------------------------------------------------------------------------
-// block_scatter_matrix class
+// block_scatter_matrix_base class
+//	RP and CP are the metadata policies of the rows and cols
 //------------------------------------------------------------------------
-template <typename T>
-class block_scatter_matrix
+template <typename T, class RP, class CP>
+class block_scatter_matrix_base
 {
   private:
   //data
-  T*                     M_BUFFER;	//base pointer
-  std::vector<size_t>    M_RSCAT;       //row scatter vector
-  std::vector<size_t>    M_CSCAT;       //col scatter vector
-  std::vector<size_t>    M_RBS;		//row block scatter vector
-  std::vector<size_t>    M_CBS;         //column block scatter vector
-  size_t                 M_NELM;        //number of total elements
-  size_t                 M_NROW;        //number of rows 
-  size_t                 M_NCOL;        //number of cols 
-  size_t                 M_NRB;         //number of row blocks
-  size_t                 M_NCB;         //number of col blocks
-  size_t                 M_RBL;		//size of row blocks
-  size_t                 M_CBL;		//size of col blocks
-  bool                   M_SEQ;         //bool tracking if is sequential
+  T*                                       M_BUFFER;	//base pointer
+  typename RP::template array<size_t>       M_RSCAT;   //row scatter vector
+  typename CP::template array<size_t>       M_CSCAT;   //col scatter vector
+  typename RP::template block_array<size_t> M_RBS;	//row block scatter vector
+  typename CP::template block_array<size_t> M_CBS;     //column block scatter vector
+  size_t                                   M_NELM;    //number of total elements
+  size_t                                   M_NROW;    //number of rows
+  size_t                                   M_NCOL;    //number of cols
+  size_t                                   M_NRB;     //number of row blocks
+  size_t                                   M_NCB;     //number of col blocks
+  size_t                                   M_RBL;	//size of row blocks
+  size_t                                   M_CBL;	//size of col blocks
 
   //internal functions
   void m_set_default();
-  void m_set_scatter(const libj::tensor_matrix<T>& TMAT, 
+  template <class LP, class RP2>
+  void m_set_scatter(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
                      const size_t RBL, const size_t CBL);
   void m_set_block(const size_t RBL, const size_t CBL);
 
-  //test
-  void m_rscat(const libj::tensor_matrix<T>& TMAT);
-  void m_cscat(const libj::tensor_matrix<T>& TMAT);
-  
   public:
 
   //initialization
-  block_scatter_matrix();
+  block_scatter_matrix_base();
 
   //copy constructor
-  block_scatter_matrix(const libj::tensor_matrix<T>& TMAT, const size_t RBL, 
-                       const size_t CBL);
+  template <class LP, class RP2>
+  block_scatter_matrix_base(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                            const size_t RBL, const size_t CBL);
 
   //assignment constructor
-  void assign(const libj::tensor_matrix<T>& TMAT, 
+  template <class LP, class RP2>
+  void assign(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
               const size_t RBL, const size_t CBL);
 
-  void assign_to_block(const libj::tensor_matrix<T>& TMAT,
+  template <class LP, class RP2>
+  void assign_to_block(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
                        const size_t ROW, const size_t COL,
                        const size_t NROW, const size_t NCOL,
                        const size_t RBL, const size_t CBL);
 
+  //fixed policies only, sizes from the policies
+  template <class LP, class RP2>
+  void assign_to_block(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                       const size_t ROW, const size_t COL)
+  {
+    assign_to_block(TMAT,ROW,COL,RP::LENGTH,CP::LENGTH,RP::BLOCK,CP::BLOCK);
+  }
+
   //Access operator
-   T& operator() (const size_t I, const size_t J) 
+  T& operator() (const size_t I, const size_t J)
   {
-//    return *(M_BUFFER + M_RSCAT[I] + M_CSCAT[J]);
-    return *(M_BUFFER + M_RSCAT.at(I) + M_CSCAT.at(J));
+    return *(M_BUFFER + M_RSCAT[I] + M_CSCAT[J]);
   }
-   const T& operator() (const size_t I, const size_t J) const
+  const T& operator() (const size_t I, const size_t J) const
   {
-    return *(M_BUFFER + M_RSCAT[I] + M_CSCAT[J]); 
+    return *(M_BUFFER + M_RSCAT[I] + M_CSCAT[J]);
   }
 
   //size
-   size_t size() const {return M_NELM;}
-   size_t size(const size_t dim) const {return dim == 0 ? M_NROW : M_NCOL;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t dim) const {return dim == 0 ? M_NROW : M_NCOL;}
 
   //block information
-   size_t block_num(const size_t dim) const {return dim == 0 ? M_NRB : M_NCB;}
-   size_t block_size(const size_t dim) const {return dim == 0 ? M_RBL : M_CBL;}
-   size_t block_size(const size_t dim, const size_t block) const 
+  size_t block_num(const size_t dim) const {return dim == 0 ? M_NRB : M_NCB;}
+  size_t block_size(const size_t dim) const {return dim == 0 ? M_RBL : M_CBL;}
+  size_t block_size(const size_t dim, const size_t block) const
   {
-    return dim == 0 ? std::min(M_RBL,M_NROW - (M_RBL*block)) 
+    return dim == 0 ? std::min(M_RBL,M_NROW - (M_RBL*block))
                     : std::min(M_CBL,M_NCOL - (M_CBL*block));}
-   size_t block_stride(const size_t dim, const size_t block) const
+  size_t block_stride(const size_t dim, const size_t block) const
   {
     return dim == 0 ? M_RBS[block] : M_CBS[block];
   }
-   size_t block_id(const size_t dim, const size_t index)
+  size_t block_id(const size_t dim, const size_t index) const
   {
     return dim == 0 ? std::min(index,M_NROW) / M_RBL
-                    : std::min(index,M_NCOL) / M_CBL; 
+                    : std::min(index,M_NCOL) / M_CBL;
   }
-   size_t next_block_index(const size_t dim, const size_t index)
+  size_t next_block_index(const size_t dim, const size_t index) const
   {
     return dim == 0 ? M_RBL*(block_id(0,index)+1)
                     : M_CBL*(block_id(1,index)+1);
   }
 
   //Data operator
-   T* data() {return M_BUFFER;}
-   const T* data() const {return M_BUFFER;}
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //scatter and block stride vectors, read only (see scatter_cache.hpp)
+  const size_t* row_scatter() const {return M_RSCAT.data();}
+  const size_t* col_scatter() const {return M_CSCAT.data();}
+  const size_t* row_block_strides() const {return M_RBS.data();}
+  const size_t* col_block_strides() const {return M_CBS.data();}
 
 };//end of class
 
+//------------------------------------------------------------------------
+// the dynamic and fixed block scatter matrices
+//------------------------------------------------------------------------
+template <typename T>
+using block_scatter_matrix = block_scatter_matrix_base<T,libj::dynamic_meta,
+                                                       libj::dynamic_meta>;
+
+template <typename T, size_t NROW, size_t NCOL, size_t RBL, size_t CBL>
+using block_scatter_matrix2 = block_scatter_matrix_base<T,libj::fixed_block<NROW,RBL>,
+                                                        libj::fixed_block<NCOL,CBL>>;
+
 //------------------------------------------------------------------------
 // m_set_default
 //	sets the default data
 //------------------------------------------------------------------------
-template <typename T>
-void block_scatter_matrix<T>::m_set_default()
+template <typename T, class RP, class CP>
+void block_scatter_matrix_base<T,RP,CP>::m_set_default()
 {
   M_BUFFER = NULL;
   M_RSCAT.clear();
@@ -160,19 +204,22 @@ void block_scatter_matrix<T>::m_set_default()
 //------------------------------------------------------------------------
 // empty initialization
 //------------------------------------------------------------------------
-template <typename T>
-block_scatter_matrix<T>::block_scatter_matrix()
+template <typename T, class RP, class CP>
+block_scatter_matrix_base<T,RP,CP>::block_scatter_matrix_base()
 {
   m_set_default();
 }
 
 //------------------------------------------------------------------------
-// copy constructor 
+// copy constructor
 //------------------------------------------------------------------------
-template <typename T>
-block_scatter_matrix<T>::block_scatter_matrix(const libj::tensor_matrix<T>& TMAT,
-                                              const size_t RBL, const size_t CBL)
+template <typename T, class RP, class CP> template <class LP, class RP2>
+block_scatter_matrix_base<T,RP,CP>::block_scatter_matrix_base(
+                        const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                        const size_t RBL, const size_t CBL)
 {
+  m_set_default();
+
   //set the buffer
   M_BUFFER = const_cast<T*>(TMAT.data());
 
@@ -183,11 +230,11 @@ block_scatter_matrix<T>::block_scatter_matrix(const libj::tensor_matrix<T>& TMAT
 //------------------------------------------------------------------------
 // Copy assignment
 //------------------------------------------------------------------------
-template <typename T>
-void block_scatter_matrix<T>::assign(const libj::tensor_matrix<T>& TMAT,
-                                     const size_t RBL, const size_t CBL)
+template <typename T, class RP, class CP> template <class LP, class RP2>
+void block_scatter_matrix_base<T,RP,CP>::assign(const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                                                const size_t RBL, const size_t CBL)
 {
-  M_BUFFER = const_cast<T*>(TMAT.data()); 
+  M_BUFFER = const_cast<T*>(TMAT.data());
 
   //set the scatter matrices
   m_set_scatter(TMAT,RBL,CBL);
@@ -199,15 +246,16 @@ void block_scatter_matrix<T>::assign(const libj::tensor_matrix<T>& TMAT,
 //	given some tensor matrix TMAT, sets the scatter row and col vectors
 //	for this scatter matrix
 //------------------------------------------------------------------------
-template <typename T>
-void block_scatter_matrix<T>::m_set_scatter(const libj::tensor_matrix<T>& TMAT, 
-                                            const size_t RBL, const size_t CBL)
+template <typename T, class RP, class CP> template <class LP, class RP2>
+void block_scatter_matrix_base<T,RP,CP>::m_set_scatter(
+                        const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                        const size_t RBL, const size_t CBL)
 {
   M_NROW = TMAT.size(0);
   M_NCOL = TMAT.size(1);
   M_NELM = M_NROW * M_NCOL;
 
-  if (M_NELM <= 0) 
+  if (M_NELM <= 0)
   {
     printf("ERROR libj::block_scatter_matrix::m_set_scatter \n");
     printf("There are <= 0 elements in input tensor matrix\n");
@@ -217,7 +265,7 @@ void block_scatter_matrix<T>::m_set_scatter(const libj::tensor_matrix<T>& TMAT,
   //set the row and scatter matrices
   if (M_RSCAT.size() < M_NROW) {M_RSCAT.resize(std::max((size_t)1,M_NROW));}
   if (M_CSCAT.size() < M_NCOL) {M_CSCAT.resize(std::max((size_t)1,M_NCOL));}
-  
+
   //set the row scatter vector
   const size_t off00 = TMAT.offset(0,0);
   for (size_t I=0;I<M_NROW;I++)
@@ -240,8 +288,9 @@ void block_scatter_matrix<T>::m_set_scatter(const libj::tensor_matrix<T>& TMAT,
 // m_set_block
 //	sets the blocking sizes based on the scatter vectors
 //------------------------------------------------------------------------
-template <typename T>
-inline void block_scatter_matrix<T>::m_set_block(const size_t RBL,const size_t CBL)
+template <typename T, class RP, class CP>
+inline void block_scatter_matrix_base<T,RP,CP>::m_set_block(const size_t RBL,
+                                                            const size_t CBL)
 {
   //set the block lengths
   M_RBL = RBL;
@@ -249,7 +298,7 @@ inline void block_scatter_matrix<T>::m_set_block(const size_t RBL,const size_t C
 
   //set block number
   M_NRB = (M_NROW + M_RBL - 1) / M_RBL;
-  M_NCB = (M_NCOL + M_CBL - 1) / M_CBL; 
+  M_NCB = (M_NCOL + M_CBL - 1) / M_CBL;
 
   //resize the vectors if needed
   if (M_RBS.size() < M_NRB) {M_RBS.resize(std::max((size_t)1,M_NRB));}
@@ -268,16 +317,16 @@ inline void block_scatter_matrix<T>::m_set_block(const size_t RBL,const size_t C
       stride = M_RSCAT[start+1] - M_RSCAT[start];
       for (size_t I = start + 2; I < end ; I++)
       {
-        if (M_RSCAT[I] - M_RSCAT[I-1] != stride) 
+        if (M_RSCAT[I] - M_RSCAT[I-1] != stride)
         {
-          stride = 0; 
+          stride = 0;
           break;
         }
       }
 
-    //only one element 
+    //only one element
     } else {
-      stride = 1; 
+      stride = 1;
     }
 
     M_RBS[block] = stride;
@@ -296,16 +345,16 @@ inline void block_scatter_matrix<T>::m_set_block(const size_t RBL,const size_t C
       stride = M_CSCAT[start+1] - M_CSCAT[start];
       for (size_t J = start + 2; J < end ; J++)
       {
-        if (M_CSCAT[J] - M_CSCAT[J-1] != stride) 
+        if (M_CSCAT[J] - M_CSCAT[J-1] != stride)
         {
-          stride = 0; 
+          stride = 0;
           break;
         }
       }
 
-    //only one element 
+    //only one element
     } else {
-      stride = 1; 
+      stride = 1;
     }
 
     M_CBS[block] = stride;
@@ -316,26 +365,27 @@ inline void block_scatter_matrix<T>::m_set_block(const size_t RBL,const size_t C
 //------------------------------------------------------------------------
 // assign_to_block
 //   assigns the block scatter matrix to a block of a tensor
-//   
-//   this is intended to be a high-speed interface to minimize overhead 
+//
+//   this is intended to be a high-speed interface to minimize overhead
 //------------------------------------------------------------------------
-template <typename T>
-inline void block_scatter_matrix<T>::assign_to_block(const libj::tensor_matrix<T>& TMAT,
-                                                     const size_t ROW, const size_t COL,
-                                                     const size_t NROW, const size_t NCOL,
-                                                     const size_t RBL, const size_t CBL)
+template <typename T, class RP, class CP> template <class LP, class RP2>
+inline void block_scatter_matrix_base<T,RP,CP>::assign_to_block(
+                        const libj::tensor_matrix_base<T,LP,RP2>& TMAT,
+                        const size_t ROW, const size_t COL,
+                        const size_t NROW, const size_t NCOL,
+                        const size_t RBL, const size_t CBL)
 {
   //assign the buffer
-  M_BUFFER = const_cast<T*>(&TMAT(ROW,COL)); 
+  M_BUFFER = const_cast<T*>(&TMAT(ROW,COL));
 
-  //set the dimensions and block lengths
-  M_NROW = std::min(NROW,TMAT.size(0)-ROW+1);
-  M_NCOL = std::min(NCOL,TMAT.size(1)-COL+1);
+  //set the dimensions and block lengths, clipped to the matrix
+  M_NROW = (ROW < TMAT.size(0)) ? std::min(NROW,TMAT.size(0)-ROW) : 0;
+  M_NCOL = (COL < TMAT.size(1)) ? std::min(NCOL,TMAT.size(1)-COL) : 0;
   M_NELM = M_NROW*M_NCOL;
 
-  if (M_NELM <= 0) 
+  if (M_NELM <= 0)
   {
-    printf("ERROR libj::block_scatter_matrix::m_set_scatter \n");
+    printf("ERROR libj::block_scatter_matrix::assign_to_block \n");
     printf("There are <= 0 elements in input tensor matrix\n");
     exit(1);
   }
@@ -0,0 +1,503 @@
+/*----------------------------------------------------------------------------
+  block_sparse_tensor.hpp
+	JHT, October 19, 2026 : created
+
+  .hpp file for the block_sparse_tensor class, which stores a tensor with
+  (abelian) symmetry blocking as a set of dense tiles.
+
+  Each dimension of the tensor is split into irrep blocks, and a tile is
+  labeled by the irreps of each of its dimensions. Irreps are combined via
+  the direct product of the abelian point groups (D2h and subgroups), which
+  for the usual labeling is just a bitwise XOR. Only tiles whose direct
+  product equals the symmetry of the tensor are stored, the rest are
+  symmetry-forbidden and are taken to be zero.
+
+  All of the allowed tiles are stored contiguously in one buffer, ordered
+  column major in their irrep labels, and each tile is a column major
+  libj::tensor assigned to its section of that buffer.
+
+  INITIALIZATION
+  -------------------
+  Irrep block lengths of each dimension, here a 4 index tensor with
+  2 irreps per dimension
+    std::vector<std::vector<size_t>> irreps = {{3,2},{3,2},{5,1},{5,1}};
+
+  Create and allocate, with a totally symmetric tensor (irrep 0)
+    libj::block_sparse_tensor<double> A(irreps);
+
+  Create and allocate, with a tensor of irrep 1
+    libj::block_sparse_tensor<double> A(irreps,1);
+
+  Allocate an existing tensor
+    A.allocate(irreps,0);
+    A.aligned_allocate(64,irreps,0); //where 64 is the byte alignment
+    A.deallocate();
+
+  TILE ACCESS
+  ------------------
+    A.num_tiles();			//number of allowed tiles
+    A.tile(t);				//returns the libj::tensor of tile t
+    A.tile_key(t);			//returns the irrep labels of tile t
+    A.tile_id({0,1,1,0});		//returns the tile id of a set of irrep
+					//  labels, or -1 if forbidden
+    A.is_allowed({0,1,1,0});		//true if the irrep labels are allowed
+
+  ELEMENT ACCESS
+  ------------------
+  Elements are indexed by their position in the dense tensor. Accessing
+  a symmetry-forbidden element through get returns zero.
+    A.get({1,2,3,4});
+    A.offset({1,2,3,4});		//offset into data(), or -1 if forbidden
+
+  USEFUL FUNCTIONS
+  --------------------
+    A.dim();			//returns number of dimensions
+    A.size();			//returns number of stored elements
+    A.dense_size();		//returns number of elements of the dense tensor
+    A.dense_size(2);		//returns dense length of dimension 2
+    A.num_irreps(2);		//returns number of irreps of dimension 2
+    A.irrep_size(2,1);		//returns length of irrep 1 of dimension 2
+    A.symmetry();		//returns the irrep of the tensor
+    A.data();			//returns data buffer pointer
+
+----------------------------------------------------------------------------*/
+#ifndef BLOCK_SPARSE_TENSOR_HPP
+#define BLOCK_SPARSE_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+#include "libjdef.h"
+#include "alignment.hpp"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// irrep_product
+//	direct product of two irreps of an abelian point group
+//------------------------------------------------------------------------
+inline size_t irrep_product(const size_t a, const size_t b)
+{
+  return a ^ b;
+}
+
+template <typename T>
+class block_sparse_tensor
+{
+  private:
+  T*                               M_BUFFER;        //start of data
+  T*                               M_POINTER;       //pointer to malloc
+  std::vector<std::vector<size_t>> M_IRREP_LENGTHS; //[dim][irrep] irrep block lengths
+  std::vector<std::vector<size_t>> M_IRREP_STARTS;  //[dim][irrep] start in dense dimension
+  std::vector<std::vector<size_t>> M_DENSE_IRREP;   //[dim][index] irrep of dense index
+  std::vector<size_t>              M_DENSE_LENGTHS; //dense length of each dimension
+  std::vector<size_t>              M_KEY_STRIDE;    //strides of the tile id table
+  std::vector<long>                M_TILE_ID;       //tile id of each key, -1 if forbidden
+  std::vector<std::vector<size_t>> M_TILE_KEY;      //irrep labels of each tile
+  std::vector<size_t>              M_TILE_OFFSET;   //offset of each tile in buffer
+  std::vector<libj::tensor<T>>     M_TILES;         //tiles, assigned to M_BUFFER
+  size_t                           M_NDIM;          //number of dimensions
+  size_t                           M_NELM;          //number of stored elements
+  size_t                           M_NDENSE;        //number of dense elements
+  size_t                           M_SYMMETRY;      //irrep of the tensor
+  size_t                           M_ALIGNMENT;     //alignment in bytes
+  bool                             M_IS_ALLOCATED;  //tensor is allocated
+
+  //internal functions
+  void m_set_default();
+  void m_set_tiles(const std::vector<std::vector<size_t>>& irrep_lengths,
+                   const size_t symmetry);
+  void m_assign_tiles();
+  bool m_next_key(std::vector<size_t>& key) const;
+
+  public:
+
+  //Constructors and destructors
+  block_sparse_tensor();
+  block_sparse_tensor(const std::vector<std::vector<size_t>>& irrep_lengths,
+                      const size_t symmetry=0);
+  ~block_sparse_tensor();
+
+  //allocate, deallocate
+  void allocate(const std::vector<std::vector<size_t>>& irrep_lengths,
+                const size_t symmetry=0);
+  void aligned_allocate(const size_t BYTES,
+                        const std::vector<std::vector<size_t>>& irrep_lengths,
+                        const size_t symmetry=0);
+  void deallocate();
+
+  //Getters
+  size_t size() const {return M_NELM;}
+  size_t dense_size() const {return M_NDENSE;}
+  size_t dense_size(const size_t dim) const {return M_DENSE_LENGTHS[dim];}
+  size_t dim() const {return M_NDIM;}
+  size_t num_irreps(const size_t dim) const {return M_IRREP_LENGTHS[dim].size();}
+  size_t irrep_size(const size_t dim, const size_t irrep) const
+  {
+    return M_IRREP_LENGTHS[dim][irrep];
+  }
+  size_t irrep_start(const size_t dim, const size_t irrep) const
+  {
+    return M_IRREP_STARTS[dim][irrep];
+  }
+  size_t symmetry() const {return M_SYMMETRY;}
+  size_t alignment() const {return M_ALIGNMENT;}
+  bool   is_allocated() const {return M_IS_ALLOCATED;}
+
+  //Tile access
+  size_t num_tiles() const {return M_TILES.size();}
+  libj::tensor<T>& tile(const size_t t) {return M_TILES[t];}
+  const libj::tensor<T>& tile(const size_t t) const {return M_TILES[t];}
+  const std::vector<size_t>& tile_key(const size_t t) const {return M_TILE_KEY[t];}
+  size_t tile_offset(const size_t t) const {return M_TILE_OFFSET[t];}
+  long tile_id(const std::vector<size_t>& key) const
+  {
+    size_t loc = 0;
+    for (size_t dim=0;dim<M_NDIM;dim++) {loc += M_KEY_STRIDE[dim]*key[dim];}
+    return M_TILE_ID[loc];
+  }
+  bool is_allowed(const std::vector<size_t>& key) const {return tile_id(key) >= 0;}
+
+  //Element access
+  long offset(const std::vector<size_t>& idx) const;
+  T get(const std::vector<size_t>& idx) const
+  {
+    const long off = offset(idx);
+    return (off >= 0) ? M_BUFFER[off] : (T) 0;
+  }
+
+  //Data function
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //prevent copies, the tiles point into this tensor's buffer
+  block_sparse_tensor(const block_sparse_tensor<T>& other) = delete;
+  block_sparse_tensor<T>& operator= (const block_sparse_tensor<T>& other) = delete;
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// returns true if two block sparse tensors have the same blocking,
+// symmetry and tiles, so that their buffers can be operated on directly
+//-----------------------------------------------------------------------
+template <typename T>
+bool same_blocking(const block_sparse_tensor<T>& A, const block_sparse_tensor<T>& B)
+{
+  if (A.dim() != B.dim()) {return false;}
+  if (A.symmetry() != B.symmetry()) {return false;}
+  for (size_t dim=0;dim<A.dim();dim++)
+  {
+    if (A.num_irreps(dim) != B.num_irreps(dim)) {return false;}
+    for (size_t irrep=0;irrep<A.num_irreps(dim);irrep++)
+    {
+      if (A.irrep_size(dim,irrep) != B.irrep_size(dim,irrep)) {return false;}
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------
+// set default values
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::m_set_default()
+{
+  M_BUFFER = NULL;
+  M_POINTER = NULL;
+  M_IRREP_LENGTHS.clear();
+  M_IRREP_STARTS.clear();
+  M_DENSE_IRREP.clear();
+  M_DENSE_LENGTHS.clear();
+  M_KEY_STRIDE.clear();
+  M_TILE_ID.clear();
+  M_TILE_KEY.clear();
+  M_TILE_OFFSET.clear();
+  M_TILES.clear();
+  M_NDIM = 0;
+  M_NELM = 0;
+  M_NDENSE = 0;
+  M_SYMMETRY = 0;
+  M_ALIGNMENT = 0;
+  M_IS_ALLOCATED = false;
+}
+
+//-----------------------------------------------------------------------
+// blank constructor
+//-----------------------------------------------------------------------
+template <typename T>
+block_sparse_tensor<T>::block_sparse_tensor()
+{
+  m_set_default();
+}
+
+//-----------------------------------------------------------------------
+// allocate constructor
+//-----------------------------------------------------------------------
+template <typename T>
+block_sparse_tensor<T>::block_sparse_tensor(
+                        const std::vector<std::vector<size_t>>& irrep_lengths,
+                        const size_t symmetry)
+{
+  m_set_default();
+  allocate(irrep_lengths,symmetry);
+}
+
+//-----------------------------------------------------------------------
+// destructor
+//-----------------------------------------------------------------------
+template <typename T>
+block_sparse_tensor<T>::~block_sparse_tensor()
+{
+  if (M_IS_ALLOCATED) {deallocate();}
+}
+
+//-----------------------------------------------------------------------
+// m_next_key
+//	increments a set of irrep labels in column major order, returns
+//	false once all keys have been visited
+//-----------------------------------------------------------------------
+template <typename T>
+bool block_sparse_tensor<T>::m_next_key(std::vector<size_t>& key) const
+{
+  for (size_t dim=0;dim<M_NDIM;dim++)
+  {
+    key[dim]++;
+    if (key[dim] < M_IRREP_LENGTHS[dim].size()) {return true;}
+    key[dim] = 0;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------
+// m_set_tiles
+//	determines the allowed tiles, their sizes, and their offsets
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::m_set_tiles(
+                        const std::vector<std::vector<size_t>>& irrep_lengths,
+                        const size_t symmetry)
+{
+  M_NDIM = irrep_lengths.size();
+  M_SYMMETRY = symmetry;
+  M_IRREP_LENGTHS = irrep_lengths;
+
+  if (M_NDIM == 0)
+  {
+    printf("ERROR libj::block_sparse_tensor::m_set_tiles\n");
+    printf("tensor has no dimensions\n");
+    exit(1);
+  }
+
+  //irrep starts and the dense lengths of each dimension
+  M_IRREP_STARTS.resize(M_NDIM);
+  M_DENSE_IRREP.resize(M_NDIM);
+  M_DENSE_LENGTHS.resize(M_NDIM);
+  M_KEY_STRIDE.resize(M_NDIM);
+  size_t NKEY = 1;
+  M_NDENSE = 1;
+  for (size_t dim=0;dim<M_NDIM;dim++)
+  {
+    const size_t NIRREP = M_IRREP_LENGTHS[dim].size();
+    if (NIRREP == 0)
+    {
+      printf("ERROR libj::block_sparse_tensor::m_set_tiles\n");
+      printf("dimension %zu has no irreps\n",dim);
+      exit(1);
+    }
+
+    M_IRREP_STARTS[dim].resize(NIRREP);
+    size_t start = 0;
+    for (size_t irrep=0;irrep<NIRREP;irrep++)
+    {
+      M_IRREP_STARTS[dim][irrep] = start;
+      start += M_IRREP_LENGTHS[dim][irrep];
+    }
+    M_DENSE_LENGTHS[dim] = start;
+    M_NDENSE *= start;
+
+    M_DENSE_IRREP[dim].resize(start);
+    for (size_t irrep=0;irrep<NIRREP;irrep++)
+    {
+      for (size_t i=0;i<M_IRREP_LENGTHS[dim][irrep];i++)
+      {
+        M_DENSE_IRREP[dim][M_IRREP_STARTS[dim][irrep]+i] = irrep;
+      }
+    }
+
+    M_KEY_STRIDE[dim] = NKEY;
+    NKEY *= NIRREP;
+  }
+
+  //go through every key, keep those that are allowed and non-empty
+  M_TILE_ID.assign(NKEY,-1);
+  std::vector<size_t> key(M_NDIM,0);
+  M_NELM = 0;
+  do
+  {
+    size_t irrep = 0;
+    size_t nelm = 1;
+    size_t loc = 0;
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      irrep = irrep_product(irrep,key[dim]);
+      nelm *= M_IRREP_LENGTHS[dim][key[dim]];
+      loc += M_KEY_STRIDE[dim]*key[dim];
+    }
+
+    if (irrep == M_SYMMETRY && nelm > 0)
+    {
+      M_TILE_ID[loc] = (long) M_TILE_KEY.size();
+      M_TILE_KEY.push_back(key);
+      M_TILE_OFFSET.push_back(M_NELM);
+      M_NELM += nelm;
+    }
+  } while (m_next_key(key));
+
+  if (M_NELM == 0)
+  {
+    printf("ERROR libj::block_sparse_tensor::m_set_tiles\n");
+    printf("no tiles are allowed by symmetry %zu \n",M_SYMMETRY);
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// m_assign_tiles
+//	assigns the tile tensors to their sections of the buffer
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::m_assign_tiles()
+{
+  const size_t NTILE = M_TILE_KEY.size();
+  M_TILES.clear();
+  M_TILES.resize(NTILE); //default constructed in place, unset tensors can't be copied
+  std::vector<size_t> lengths(M_NDIM);
+  for (size_t t=0;t<NTILE;t++)
+  {
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      lengths[dim] = M_IRREP_LENGTHS[dim][M_TILE_KEY[t][dim]];
+    }
+    M_TILES[t].assign(M_BUFFER+M_TILE_OFFSET[t],lengths);
+  }
+}
+
+//-----------------------------------------------------------------------
+// allocate
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::allocate(
+                        const std::vector<std::vector<size_t>>& irrep_lengths,
+                        const size_t symmetry)
+{
+  if (M_IS_ALLOCATED)
+  {
+    printf("ERROR libj::block_sparse_tensor::allocate\n");
+    printf("attempted to allocate an already allocated tensor\n");
+    exit(1);
+  }
+
+  m_set_default();
+  m_set_tiles(irrep_lengths,symmetry);
+
+  M_POINTER = (T*) mem_alloc(sizeof(T)*M_NELM,MEM_KIND_BLOCK_SPARSE_TENSOR);
+  M_BUFFER = M_POINTER;
+  if (M_BUFFER == NULL)
+  {
+    printf("ERROR libj::block_sparse_tensor::allocate could not allocate M_BUFFER \n");
+    exit(1);
+  }
+  M_IS_ALLOCATED = true;
+  M_ALIGNMENT = libj::calc_alignment((void*) M_BUFFER);
+
+  m_assign_tiles();
+}
+
+//-----------------------------------------------------------------------
+// aligned_allocate
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::aligned_allocate(const size_t ALIGN,
+                        const std::vector<std::vector<size_t>>& irrep_lengths,
+                        const size_t symmetry)
+{
+  if (M_IS_ALLOCATED)
+  {
+    printf("ERROR libj::block_sparse_tensor::aligned_allocate\n");
+    printf("attempted to allocate an already allocated tensor\n");
+    exit(1);
+  }
+  if (ALIGN%2 != 0)
+  {
+    printf("ERROR libj::block_sparse_tensor::aligned_allocate\n");
+    printf("input BYTE ALIGN was not divisible by 2 \n");
+    exit(1);
+  }
+
+  m_set_default();
+  m_set_tiles(irrep_lengths,symmetry);
+
+  M_POINTER = (T*) mem_alloc(ALIGN+sizeof(T)*M_NELM,MEM_KIND_BLOCK_SPARSE_TENSOR);
+  if (M_POINTER == NULL)
+  {
+    printf("ERROR libj::block_sparse_tensor::aligned_allocate\n");
+    printf("could not allocate M_BUFFER \n");
+    exit(1);
+  }
+  const size_t M = (size_t) M_POINTER % ALIGN; //number of bytes off
+  M_BUFFER = (M != 0) ? (T*) ((char*) M_POINTER + (ALIGN-M)) : M_POINTER;
+  M_IS_ALLOCATED = true;
+  M_ALIGNMENT = libj::calc_alignment((void*) M_BUFFER);
+
+  m_assign_tiles();
+}
+
+//-----------------------------------------------------------------------
+// deallocate
+//-----------------------------------------------------------------------
+template <typename T>
+void block_sparse_tensor<T>::deallocate()
+{
+  if (M_IS_ALLOCATED)
+  {
+    if (M_POINTER != NULL) {mem_free(M_POINTER);}
+    m_set_default();
+  } else {
+    printf("ERROR libj::block_sparse_tensor::deallocate \n");
+    printf("attempted to deallocate an unallocated tensor \n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// offset
+//	returns the offset of a dense index into the buffer, or -1 if the
+//	element is symmetry-forbidden
+//-----------------------------------------------------------------------
+template <typename T>
+long block_sparse_tensor<T>::offset(const std::vector<size_t>& idx) const
+{
+  size_t loc = 0;
+  for (size_t dim=0;dim<M_NDIM;dim++)
+  {
+    loc += M_KEY_STRIDE[dim]*M_DENSE_IRREP[dim][idx[dim]];
+  }
+  const long t = M_TILE_ID[loc];
+  if (t < 0) {return -1;}
+
+  const libj::tensor<T>& TILE = M_TILES[t];
+  size_t off = M_TILE_OFFSET[t];
+  for (size_t dim=0;dim<M_NDIM;dim++)
+  {
+    const size_t irrep = M_TILE_KEY[t][dim];
+    off += TILE.stride(dim)*(idx[dim] - M_IRREP_STARTS[dim][irrep]);
+  }
+  return (long) off;
+}
+
+}//end of namespace
+
+#endif
@@ -1,9 +1,14 @@
 /*---------------------------------------------------------------------------------------
   index_bundle.hpp
 	JHT, April 27, 2022 : created
+	JHT, October 19, 2026 : merged with index_bundle2, metadata storage is a policy
 
   class which contains information about index bundles
 
+  The storage of the bundle metadata is set by a policy (see meta_policy.hpp)
+    libj::index_bundle		//std::vector metadata, any bundle rank
+    libj::index_bundle2<N>	//std::array metadata, bundle rank of at most N
+
   Functionality
   ------------------
   bunde.offset(index);  //returns the offset of this element in the original tensor
@@ -14,13 +19,16 @@
 
 #include <vector>
 #include <string>
-#include <algorithm> 
+#include <algorithm>
+#include <cctype>
 #include <stdlib.h>
+#include "tensor.hpp"
+#include "meta_policy.hpp"
 
 namespace libj
 {
 //------------------------------------------------------------------------
-// index struct 
+// index struct
 //------------------------------------------------------------------------
 struct index
 {
@@ -28,46 +36,25 @@ struct index
   size_t STRIDE;
   size_t LDA;
 };
+
 //------------------------------------------------------------------------
 // index bundle class
 //------------------------------------------------------------------------
-struct index_bundle
+template <class P>
+struct index_bundle_t
 {
-  size_t              NDIM;   //number of dimensions in bundle
-  size_t              NELM;   //number of elements
-  size_t              START;  //starting index (for blocking)
-  std::vector<size_t> DIM;    //dimension list that maps between bundle and original
-  std::vector<index>  IDX;    //vector of structs to help with locality  
+  size_t                                  NDIM;   //number of dimensions in bundle
+  size_t                                  NELM;   //number of elements
+  size_t                                  START;  //starting index (for blocking)
+  typename P::template array<size_t>      DIM;    //dimension list that maps between bundle and original
+  typename P::template array<libj::index> IDX;    //vector of structs to help with locality
 
   //initialize the bundle to nothing
-  index_bundle()
+  index_bundle_t()
   {
     clear();
   }
 
-  //copy constructor
-  index_bundle(const index_bundle& other)
-  {
-    NDIM = other.NDIM;
-    NELM = other.NELM;
-    START = other.START;
-    DIM = other.DIM;
-    IDX = other.IDX;
-  }
-
-  //copy assignment
-  index_bundle& operator= (const index_bundle& other)
-  {
-    NDIM = other.NDIM;
-    NELM = other.NELM;
-    START = other.START;
-    if (DIM.size() < NDIM) {DIM.resize(NDIM);}
-    if (IDX.size() < NDIM) {DIM.resize(NDIM);}
-    DIM = other.DIM;
-    IDX = other.IDX;
-    return *this;
-  }
-
   //clear the data in the bundle
   void clear()
   {
@@ -76,6 +63,9 @@ struct index_bundle
     START = 0;
   }
 
+  size_t dim() const {return NDIM;}
+  size_t dim(const size_t idx) const {return DIM[idx];}
+
   size_t size() const {return NELM;}
 
   //given cumulative index I, return the value for sub-index idx
@@ -95,7 +85,7 @@ struct index_bundle
   void make_bundle(const libj::tensor<T>& tens, const std::string& str)
   {
     NDIM = str.length();
-
+    START = 0;
 
     if (DIM.size() < NDIM) {DIM.resize(NDIM);}
     if (IDX.size() < NDIM) {IDX.resize(NDIM);}
@@ -105,7 +95,7 @@ struct index_bundle
     {
       const size_t d = c2dim(str[0]);
       DIM[0] = d;
-      IDX[0].LENGTH = tens.size(d); 
+      IDX[0].LENGTH = tens.size(d);
       IDX[0].STRIDE = 1;
       IDX[0].LDA = tens.stride(d);
       NELM *= IDX[0].LENGTH;
@@ -114,7 +104,7 @@ struct index_bundle
       {
         const size_t dim = c2dim(str[idx]);
         DIM[idx] = dim;
-        IDX[idx].LENGTH = tens.size(dim); 
+        IDX[idx].LENGTH = tens.size(dim);
         IDX[idx].STRIDE = IDX[idx-1].STRIDE * IDX[idx-1].LENGTH;
         IDX[idx].LDA = tens.stride(dim);
         NELM *= IDX[idx].LENGTH;
@@ -124,31 +114,28 @@ struct index_bundle
 
   //return a new index bundle as a block of the current index bundle
   //  starting at bundled index I and going to bundled index I+(MIN:MAX - I,LEN)
-  index_bundle block(const size_t I, const size_t LEN) const
+  index_bundle_t block(const size_t I, const size_t LEN) const
   {
-    index_bundle block;
-    block.NDIM = NDIM;
-    block.START = I; //here is the big trick
+    index_bundle_t block(*this);
+    block.START = START + I; //here is the big trick
     block.NELM = std::min(LEN,NELM - I);
-    block.DIM = DIM;
-    block.IDX = IDX;
     return block;
   }
 
-  //returns the offset of an index of this particular bundle in the 
+  //returns the offset of an index of this particular bundle in the
   //  original tensor
   size_t offset(const size_t I) const
   {
     size_t off=0;
     for (size_t dim=0;dim<NDIM;dim++)
     {
-      off += IDX[dim].LDA*get_index(I,dim); 
-    }  
+      off += IDX[dim].LDA*get_index(I,dim);
+    }
     return off;
   }
 
   //calculates offsets for a block of numbers
-  void offset_block(const size_t N, const size_t* I, size_t* off)
+  void offset_block(const size_t N, const size_t* I, size_t* off) const
   {
     for (size_t i=0;i<N;i++)
     {
@@ -158,6 +145,12 @@ struct index_bundle
 
 }; //end class
 
+//------------------------------------------------------------------------
+// the dynamic and fixed bundles
+//------------------------------------------------------------------------
+typedef index_bundle_t<libj::dynamic_meta> index_bundle;
+template <size_t NDIM> using index_bundle2 = index_bundle_t<libj::fixed_meta<NDIM>>;
+
 }//end namespace
 
 #endif
@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------
+  meta_policy.hpp
+	JHT, October 19, 2026 : created
+
+  .hpp file for the metadata storage policies used by the index_bundle,
+  tensor_matrix, and block_scatter_matrix classes.
+
+  A policy decides where the small metadata arrays of these classes (bundle
+  dimensions, scatter vectors, block strides) live
+
+    libj::dynamic_meta		heap std::vectors, any rank or size known
+				  at runtime
+    libj::fixed_meta<N>		std::array of N elements, for ranks known at
+				  compile time. No allocations.
+    libj::fixed_block<N,BL>	std::array of N elements, with blocks of BL,
+				  for scatter matrices of compile time size
+
+  The policies give the array type through the nested alias template
+    typename P::template array<size_t>	  //metadata array
+    typename P::template block_array<size_t> //per block array
+
+  fixed_array<U,N> behaves like the subset of std::vector used by these
+  classes, resize() only checks that the requested size fits.
+
+----------------------------------------------------------------------------*/
+#ifndef META_POLICY_HPP
+#define META_POLICY_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <array>
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// fixed_array
+//	std::array with the std::vector interface used for metadata
+//------------------------------------------------------------------------
+template <typename U, size_t N>
+struct fixed_array
+{
+  std::array<U,(N > 0) ? N : 1> M_DATA; //never zero length, for data()
+
+  void resize(const size_t n)
+  {
+    if (n > N)
+    {
+      printf("ERROR libj::fixed_array::resize\n");
+      printf("requested size %zu is larger than fixed size %zu \n",n,N);
+      exit(1);
+    }
+  }
+  void clear() {}
+  constexpr size_t size() const {return N;}
+  U& operator[] (const size_t i) {return M_DATA[i];}
+  const U& operator[] (const size_t i) const {return M_DATA[i];}
+  U& at(const size_t i) {return M_DATA.at(i);}
+  const U& at(const size_t i) const {return M_DATA.at(i);}
+  U* data() {return M_DATA.data();}
+  const U* data() const {return M_DATA.data();}
+};
+
+//------------------------------------------------------------------------
+// dynamic_meta
+//	metadata in std::vectors
+//------------------------------------------------------------------------
+struct dynamic_meta
+{
+  static constexpr bool FIXED = false;
+  template <typename U> using array = std::vector<U>;
+  template <typename U> using block_array = std::vector<U>;
+};
+
+//------------------------------------------------------------------------
+// fixed_meta
+//	metadata in arrays of N elements
+//------------------------------------------------------------------------
+template <size_t N>
+struct fixed_meta
+{
+  static constexpr bool   FIXED = true;
+  static constexpr size_t LENGTH = N;
+  template <typename U> using array = libj::fixed_array<U,N>;
+  template <typename U> using block_array = libj::fixed_array<U,N>;
+};
+
+//------------------------------------------------------------------------
+// fixed_block
+//	metadata in arrays of N elements, split into blocks of BL
+//------------------------------------------------------------------------
+template <size_t N, size_t BL>
+struct fixed_block
+{
+  static_assert(BL > 0,"libj::fixed_block must have a block length > 0");
+  static constexpr bool   FIXED = true;
+  static constexpr size_t LENGTH = N;
+  static constexpr size_t BLOCK = BL;
+  template <typename U> using array = libj::fixed_array<U,N>;
+  template <typename U> using block_array = libj::fixed_array<U,(N+BL-1)/BL>;
+};
+
+}//end of namespace
+
+#endif
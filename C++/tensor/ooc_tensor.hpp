@@ -0,0 +1,607 @@
+/*----------------------------------------------------------------------------
+  ooc_tensor.hpp
+	JHT, October 19, 2026 : created
+
+  .hpp file for the ooc_tensor class, an out of core tensor which keeps
+  at most a memory budget of its elements in RAM, and the rest in a
+  scratch file.
+
+  The tensor is column major, and is cut into tiles along its last (slowest)
+  dimension, so each tile is itself a dense, column major libj::tensor of
+  TILE_LEN slices of the last index (the last tile may have fewer). Tiles
+  are held in an LRU cache of budget/tile_bytes slots. A tile is read from
+  the scratch file the first time it is used, and written back only if it
+  was opened for writing when it is evicted. Tiles never written read as
+  zero.
+
+  The scratch file is made in $LIBJ_SCRATCH (or /tmp) and unlinked at once,
+  so it goes away with the tensor (or the process).
+
+  Tiles are used through ooc_tile handles, which pin the tile in memory
+  for as long as they live, and act as an ordinary libj::tensor view of it,
+  so the tensor and jblis routines work on them unchanged. Any number of
+  threads may hold tiles at once, as long as the budget has room for the
+  tiles pinned at the same time.
+
+  for_each_tile walks the tiles in order of the last index, which is the
+  order the column major loops of jblis walk a tensor, and reads the next
+  tiles on a background thread while the current one is being used.
+
+  INITIALIZATION
+  -------------------
+  A 3 index tensor, tiles of 8 slices, with 1 GiB of RAM
+    libj::ooc_tensor<double> T({nv,nv,no*nv},8,1L << 30);
+    T.open({nv,nv,no*nv},8,1L << 30,"/scratch");	//same, later
+
+  TILE ACCESS
+  ------------------
+    {
+      libj::ooc_tile<double> tile = T.tile(t,OOC_RW);	//OOC_READ, OOC_WRITE
+      libj::tensor<double>& view = tile.view();		//dense view of tile t
+      ... use view like any tensor ...
+    }							//released
+    T.for_each_tile(OOC_RW,
+      [&](const size_t t, libj::tensor<double>& view)
+      {
+        ... view holds slices T.tile_first(t) ... of the last index
+      });
+    T.prefetch(t);		//start reading tile t in the background
+    T.flush();			//write all modified tiles to the file
+
+  ELEMENT ACCESS (slow, one tile at a time)
+  ------------------
+    T.get({i,j,k});
+    T.set({i,j,k},value);
+
+  USEFUL FUNCTIONS
+  --------------------
+    T.dim(); T.size(); T.size(2);
+    T.num_tiles(); T.tile_len(); T.tile_first(t); T.tile_slices(t);
+    T.num_slots();		//tiles that fit in the budget
+    T.num_reads(); T.num_writes();
+
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_OOC_TENSOR_HPP
+#define LIBJ_OOC_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "libjdef.h"
+#include "tensor.hpp"
+#include "mem.hpp"
+
+//tile access modes
+#define OOC_READ 1	//read, not modified
+#define OOC_WRITE 2	//fully overwritten, not read from the file
+#define OOC_RW 3	//read and modified
+
+#define OOC_PREFETCH_DEPTH 2 //tiles read ahead by for_each_tile
+
+namespace libj
+{
+
+template<typename T> class ooc_tensor;
+
+//-----------------------------------------------------------------------
+// ooc_tile, a pinned tile. Moves, but does not copy
+//-----------------------------------------------------------------------
+template<typename T>
+class ooc_tile
+{
+  private:
+  ooc_tensor<T>*  M_OWNER;
+  size_t          M_TILE;
+  libj::tensor<T> M_VIEW;
+
+  public:
+  ooc_tile() : M_OWNER(NULL), M_TILE(0) {}
+  ooc_tile(ooc_tensor<T>* owner, const size_t tile, T* buffer,
+           const std::vector<size_t>& lengths) : M_OWNER(owner), M_TILE(tile)
+  {
+    M_VIEW.assign(buffer,lengths);
+  }
+  ooc_tile(ooc_tile<T>&& other) : M_OWNER(other.M_OWNER), M_TILE(other.M_TILE)
+  {
+    if (other.M_VIEW.is_set()) {M_VIEW = other.M_VIEW;}
+    other.M_OWNER = NULL;
+  }
+  ooc_tile(const ooc_tile<T>&) = delete;
+  ooc_tile<T>& operator=(const ooc_tile<T>&) = delete;
+  ~ooc_tile() {release();}
+
+  void release()
+  {
+    if (M_OWNER != NULL) {M_OWNER->m_unpin(M_TILE);}
+    M_OWNER = NULL;
+  }
+
+  libj::tensor<T>& view() {return M_VIEW;}
+  T* data() {return M_VIEW.data();}
+  size_t tile() const {return M_TILE;}
+};
+
+//-----------------------------------------------------------------------
+// ooc_tensor
+//-----------------------------------------------------------------------
+template<typename T>
+class ooc_tensor
+{
+  friend class ooc_tile<T>;
+
+  private:
+  //one tile sized buffer of the cache
+  struct Slot
+  {
+    T*       buffer;
+    long     tile;	//tile held, -1 if none
+    int      pins;
+    bool     dirty;
+    bool     busy;	//being read or written
+    bool     ahead;	//prefetched, and not used yet
+    uint64_t last_use;
+  };
+
+  std::vector<size_t>  M_LENGTHS;
+  std::vector<size_t>  M_TILE_LENGTHS;
+  size_t               M_NDIM;
+  size_t               M_NELM;
+  size_t               M_SLICE;		//elements of one slice of the last index
+  size_t               M_TILE_LEN;	//slices per tile
+  size_t               M_NTILE;
+  int                  M_FD;
+  std::vector<Slot>    M_SLOT;
+  std::vector<long>    M_WHERE;		//slot of each tile, -1 if not in RAM
+  uint64_t             M_CLOCK;
+  long                 M_READS;
+  long                 M_WRITES;
+  std::mutex               M_LOCK;
+  std::condition_variable  M_DONE;	//a slot stopped being busy
+
+  //prefetch thread
+  std::thread          M_THREAD;
+  std::deque<size_t>   M_QUEUE;
+  std::condition_variable M_WORK;
+  bool                 M_STOP;
+
+  size_t m_elems(const size_t tile) const {return M_SLICE*tile_slices(tile);}
+  long m_acquire(std::unique_lock<std::mutex>& guard, const size_t tile,
+                 const int mode, const bool pin);
+  void m_unpin(const size_t tile);
+  void m_write_back(const long slot, std::unique_lock<std::mutex>& guard);
+  void m_loop();
+  void m_close();
+
+  public:
+  ooc_tensor();
+  ooc_tensor(const std::vector<size_t>& lengths, const size_t tile_len,
+             const size_t budget_bytes, const char* dir = NULL);
+  ~ooc_tensor() {m_close();}
+  ooc_tensor(const ooc_tensor<T>&) = delete;
+  ooc_tensor<T>& operator=(const ooc_tensor<T>&) = delete;
+
+  void open(const std::vector<size_t>& lengths, const size_t tile_len,
+            const size_t budget_bytes, const char* dir = NULL);
+
+  //tiles
+  ooc_tile<T> tile(const size_t tile, const int mode);
+  void prefetch(const size_t tile);
+  void flush();
+  template<typename F> void for_each_tile(const int mode, F fn);
+
+  //elements
+  T get(const std::vector<size_t>& idx);
+  void set(const std::vector<size_t>& idx, const T value);
+
+  //info
+  size_t dim() const {return M_NDIM;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t dim) const {return M_LENGTHS[dim];}
+  size_t num_tiles() const {return M_NTILE;}
+  size_t tile_len() const {return M_TILE_LEN;}
+  size_t tile_first(const size_t tile) const {return tile*M_TILE_LEN;}
+  size_t tile_slices(const size_t tile) const
+  {
+    const size_t first = tile*M_TILE_LEN;
+    const size_t last = M_LENGTHS[M_NDIM-1];
+    return (last-first < M_TILE_LEN) ? last-first : M_TILE_LEN;
+  }
+  size_t num_slots() const {return M_SLOT.size();}
+  long num_reads() const {return M_READS;}
+  long num_writes() const {return M_WRITES;}
+};
+
+//-----------------------------------------------------------------------
+// constructors
+//-----------------------------------------------------------------------
+template<typename T>
+ooc_tensor<T>::ooc_tensor()
+{
+  M_NDIM = 0;
+  M_NELM = 0;
+  M_SLICE = 0;
+  M_TILE_LEN = 0;
+  M_NTILE = 0;
+  M_FD = -1;
+  M_CLOCK = 0;
+  M_READS = 0;
+  M_WRITES = 0;
+  M_STOP = false;
+}
+
+template<typename T>
+ooc_tensor<T>::ooc_tensor(const std::vector<size_t>& lengths, const size_t tile_len,
+                          const size_t budget_bytes, const char* dir) : ooc_tensor()
+{
+  open(lengths,tile_len,budget_bytes,dir);
+}
+
+//-----------------------------------------------------------------------
+// open -- set the shape, make the scratch file and the cache
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::open(const std::vector<size_t>& lengths, const size_t tile_len,
+                         const size_t budget_bytes, const char* dir)
+{
+  if (M_FD != -1)
+  {
+    printf("ERROR libj::ooc_tensor::open\n");
+    printf("tensor is already open\n");
+    exit(1);
+  }
+  if (lengths.empty() || tile_len == 0)
+  {
+    printf("ERROR libj::ooc_tensor::open\n");
+    printf("tensor has no dimensions, or tiles have no slices\n");
+    exit(1);
+  }
+
+  M_LENGTHS = lengths;
+  M_NDIM = lengths.size();
+  M_SLICE = 1;
+  for (size_t dim=0;dim+1<M_NDIM;dim++)
+  {
+    if (lengths[dim] == 0)
+    {
+      printf("ERROR libj::ooc_tensor::open\n");
+      printf("Dimension %zu has length <= 0 \n",dim);
+      exit(1);
+    }
+    M_SLICE *= lengths[dim];
+  }
+  M_NELM = M_SLICE*lengths[M_NDIM-1];
+  M_TILE_LEN = (tile_len < lengths[M_NDIM-1]) ? tile_len : lengths[M_NDIM-1];
+  M_NTILE = (lengths[M_NDIM-1] + M_TILE_LEN - 1)/M_TILE_LEN;
+  M_TILE_LENGTHS = lengths;
+  M_TILE_LENGTHS[M_NDIM-1] = M_TILE_LEN;
+
+  //scratch file, zero filled
+  const char* env = getenv("LIBJ_SCRATCH");
+  const char* base = (dir != NULL) ? dir : ((env != NULL) ? env : "/tmp");
+  std::vector<char> name(strlen(base)+32);
+  snprintf(name.data(),name.size(),"%s/libj_ooc_XXXXXX",base);
+  M_FD = mkstemp(name.data());
+  if (M_FD == -1 || ftruncate(M_FD,(off_t) (M_NELM*sizeof(T))) != 0)
+  {
+    printf("ERROR libj::ooc_tensor::open\n");
+    printf("could not make scratch file %s\n",name.data());
+    exit(1);
+  }
+  unlink(name.data());
+
+  //cache
+  const size_t tile_bytes = M_SLICE*M_TILE_LEN*sizeof(T);
+  size_t nslot = budget_bytes/tile_bytes;
+  if (nslot > M_NTILE) {nslot = M_NTILE;}
+  if (nslot < 1)
+  {
+    printf("ERROR libj::ooc_tensor::open\n");
+    printf("budget of %zu bytes does not hold one tile of %zu bytes\n",
+           budget_bytes,tile_bytes);
+    exit(1);
+  }
+  M_SLOT.resize(nslot);
+  for (size_t s=0;s<nslot;s++)
+  {
+    M_SLOT[s].buffer = (T*) mem_alloc(tile_bytes,MEM_KIND_TENSOR);
+    if (M_SLOT[s].buffer == NULL)
+    {
+      printf("ERROR libj::ooc_tensor::open\n");
+      printf("could not allocate tile buffers\n");
+      exit(1);
+    }
+    M_SLOT[s].tile = -1;
+    M_SLOT[s].pins = 0;
+    M_SLOT[s].dirty = false;
+    M_SLOT[s].busy = false;
+    M_SLOT[s].ahead = false;
+    M_SLOT[s].last_use = 0;
+  }
+  M_WHERE.assign(M_NTILE,-1);
+  M_STOP = false;
+  M_THREAD = std::thread(&ooc_tensor<T>::m_loop,this);
+}
+
+//-----------------------------------------------------------------------
+// m_close -- stop the prefetch thread, free the cache and the file
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::m_close()
+{
+  if (M_FD == -1) {return;}
+  {
+    std::lock_guard<std::mutex> guard(M_LOCK);
+    M_STOP = true;
+    M_QUEUE.clear();
+  }
+  M_WORK.notify_all();
+  if (M_THREAD.joinable()) {M_THREAD.join();}
+  for (size_t s=0;s<M_SLOT.size();s++) {mem_free(M_SLOT[s].buffer);}
+  M_SLOT.clear();
+  M_WHERE.clear();
+  close(M_FD);
+  M_FD = -1;
+}
+
+//-----------------------------------------------------------------------
+// m_write_back -- write a dirty slot to the file. Called, and returns,
+//   with the lock held, and the slot busy
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::m_write_back(const long slot, std::unique_lock<std::mutex>& guard)
+{
+  Slot& s = M_SLOT[slot];
+  const size_t bytes = m_elems(s.tile)*sizeof(T);
+  const off_t pos = (off_t) (s.tile*M_TILE_LEN*M_SLICE*sizeof(T));
+  T* buffer = s.buffer;
+  guard.unlock();
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t n = pwrite(M_FD,(char*) buffer+done,bytes-done,pos+done);
+    if (n <= 0)
+    {
+      printf("ERROR libj::ooc_tensor\n");
+      printf("could not write tile to the scratch file\n");
+      exit(1);
+    }
+    done += n;
+  }
+  guard.lock();
+  s.dirty = false;
+  M_WRITES++;
+}
+
+//-----------------------------------------------------------------------
+// m_acquire -- bring a tile into a slot, returns the slot, or -1 if pin
+//   is false and there was no free slot. Called with the lock held
+//-----------------------------------------------------------------------
+template<typename T>
+long ooc_tensor<T>::m_acquire(std::unique_lock<std::mutex>& guard, const size_t tile,
+                              const int mode, const bool pin)
+{
+  while (true)
+  {
+    //in RAM, or on the way
+    const long where = M_WHERE[tile];
+    if (where != -1)
+    {
+      if (M_SLOT[where].busy) {M_DONE.wait(guard); continue;}
+      Slot& s = M_SLOT[where];
+      if (pin) {s.pins++; s.ahead = false;}
+      if (mode & OOC_WRITE) {s.dirty = true;}
+      s.last_use = ++M_CLOCK;
+      return where;
+    }
+
+    //an empty slot, else the least recently used one that is not pinned
+    //  or busy. Prefetched tiles not yet used go last, and are never
+    //  evicted by another prefetch
+    long victim = -1;
+    int best = 3;
+    for (size_t i=0;i<M_SLOT.size();i++)
+    {
+      const Slot& s = M_SLOT[i];
+      if (s.pins > 0 || s.busy || (s.ahead && !pin)) {continue;}
+      const int rank = (s.tile == -1) ? 0 : (s.ahead ? 2 : 1);
+      if (rank < best || (rank == best && s.last_use < M_SLOT[victim].last_use))
+      {
+        victim = (long) i;
+        best = rank;
+      }
+    }
+    if (victim == -1)
+    {
+      if (!pin) {return -1;}
+      bool busy = false;
+      for (size_t i=0;i<M_SLOT.size();i++) {busy = busy || M_SLOT[i].busy;}
+      if (!busy)
+      {
+        printf("ERROR libj::ooc_tensor::tile\n");
+        printf("all %zu tiles of the budget are pinned\n",M_SLOT.size());
+        exit(1);
+      }
+      M_DONE.wait(guard);
+      continue;
+    }
+
+    //evict, claiming the tile first so no other thread loads it too
+    Slot& s = M_SLOT[victim];
+    s.busy = true;
+    M_WHERE[tile] = victim;
+    if (s.tile != -1)
+    {
+      if (s.dirty) {m_write_back(victim,guard);}
+      M_WHERE[s.tile] = -1;
+    }
+    s.tile = (long) tile;
+
+    //read
+    if (mode & OOC_READ)
+    {
+      const size_t bytes = m_elems(tile)*sizeof(T);
+      const off_t pos = (off_t) (tile*M_TILE_LEN*M_SLICE*sizeof(T));
+      T* buffer = s.buffer;
+      guard.unlock();
+      size_t done = 0;
+      while (done < bytes)
+      {
+        const ssize_t n = pread(M_FD,(char*) buffer+done,bytes-done,pos+done);
+        if (n <= 0)
+        {
+          printf("ERROR libj::ooc_tensor::tile\n");
+          printf("could not read tile from the scratch file\n");
+          exit(1);
+        }
+        done += n;
+      }
+      guard.lock();
+      M_READS++;
+    }
+    s.busy = false;
+    s.dirty = (mode & OOC_WRITE) != 0;
+    s.pins = pin ? 1 : 0;
+    s.ahead = !pin;
+    s.last_use = ++M_CLOCK;
+    M_DONE.notify_all();
+    return victim;
+  }
+}
+
+//-----------------------------------------------------------------------
+// tile -- pin a tile in RAM
+//-----------------------------------------------------------------------
+template<typename T>
+ooc_tile<T> ooc_tensor<T>::tile(const size_t tile, const int mode)
+{
+  if (tile >= M_NTILE)
+  {
+    printf("ERROR libj::ooc_tensor::tile\n");
+    printf("tile %zu is past the last tile %zu\n",tile,M_NTILE);
+    exit(1);
+  }
+  std::unique_lock<std::mutex> guard(M_LOCK);
+  const long slot = m_acquire(guard,tile,mode,true);
+  std::vector<size_t> lengths = M_TILE_LENGTHS;
+  lengths[M_NDIM-1] = tile_slices(tile);
+  return ooc_tile<T>(this,tile,M_SLOT[slot].buffer,lengths);
+}
+
+//-----------------------------------------------------------------------
+// m_unpin
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::m_unpin(const size_t tile)
+{
+  std::lock_guard<std::mutex> guard(M_LOCK);
+  const long where = M_WHERE[tile];
+  if (where != -1 && M_SLOT[where].pins > 0) {M_SLOT[where].pins--;}
+  M_DONE.notify_all();
+}
+
+//-----------------------------------------------------------------------
+// prefetch -- read a tile in the background, if a slot is free
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::prefetch(const size_t tile)
+{
+  if (tile >= M_NTILE) {return;}
+  {
+    std::lock_guard<std::mutex> guard(M_LOCK);
+    if (M_WHERE[tile] != -1) {return;}
+    M_QUEUE.push_back(tile);
+  }
+  M_WORK.notify_one();
+}
+
+template<typename T>
+void ooc_tensor<T>::m_loop()
+{
+  std::unique_lock<std::mutex> guard(M_LOCK);
+  while (true)
+  {
+    while (!M_STOP && M_QUEUE.empty()) {M_WORK.wait(guard);}
+    if (M_STOP) {return;}
+    const size_t tile = M_QUEUE.front();
+    M_QUEUE.pop_front();
+    if (M_WHERE[tile] == -1) {m_acquire(guard,tile,OOC_READ,false);}
+  }
+}
+
+//-----------------------------------------------------------------------
+// flush -- write every modified tile to the file
+//-----------------------------------------------------------------------
+template<typename T>
+void ooc_tensor<T>::flush()
+{
+  std::unique_lock<std::mutex> guard(M_LOCK);
+  for (size_t i=0;i<M_SLOT.size();i++)
+  {
+    while (M_SLOT[i].busy) {M_DONE.wait(guard);}
+    if (M_SLOT[i].tile != -1 && M_SLOT[i].dirty)
+    {
+      M_SLOT[i].busy = true;
+      m_write_back((long) i,guard);
+      M_SLOT[i].busy = false;
+      M_DONE.notify_all();
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// for_each_tile -- fn(t,view) for each tile, in order, reading the next
+//   OOC_PREFETCH_DEPTH tiles in the background
+//-----------------------------------------------------------------------
+template<typename T>
+template<typename F>
+void ooc_tensor<T>::for_each_tile(const int mode, F fn)
+{
+  const size_t depth = (M_SLOT.size() > 1) ?
+                       ((M_SLOT.size()-1 < OOC_PREFETCH_DEPTH) ? M_SLOT.size()-1
+                                                               : OOC_PREFETCH_DEPTH) : 0;
+  for (size_t t=0;t<M_NTILE;t++)
+  {
+    if (mode & OOC_READ)
+    {
+      for (size_t d=1;d<=depth;d++) {prefetch(t+d);}
+    }
+    ooc_tile<T> h = tile(t,mode);
+    fn(t,h.view());
+  }
+}
+
+//-----------------------------------------------------------------------
+// get, set -- single elements
+//-----------------------------------------------------------------------
+template<typename T>
+T ooc_tensor<T>::get(const std::vector<size_t>& idx)
+{
+  const size_t last = idx[M_NDIM-1];
+  ooc_tile<T> h = tile(last/M_TILE_LEN,OOC_READ);
+  std::vector<size_t> local = idx;
+  local[M_NDIM-1] = last % M_TILE_LEN;
+  return h.view()(local);
+}
+
+template<typename T>
+void ooc_tensor<T>::set(const std::vector<size_t>& idx, const T value)
+{
+  const size_t last = idx[M_NDIM-1];
+  ooc_tile<T> h = tile(last/M_TILE_LEN,OOC_RW);
+  std::vector<size_t> local = idx;
+  local[M_NDIM-1] = last % M_TILE_LEN;
+  h.view()(local) = value;
+}
+
+}//end libj namespace
+
+#endif
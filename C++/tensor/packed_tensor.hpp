@@ -0,0 +1,654 @@
+/*----------------------------------------------------------------------------
+  packed_tensor.hpp
+	JHT, October 19, 2026 : created
+
+  .hpp file for the packed_tensor class, which stores only the unique
+  elements of a tensor with permutational symmetry among groups of its
+  indices.
+
+  The dimensions of the tensor are split, in order, into index groups that
+  are described at compile time. All indices of a group share the same
+  length, and a group is either
+
+    libj::sym_group<N>		N indices symmetric under permutation,
+				  stored as i1 <= i2 <= ... <= iN
+    libj::antisym_group<N>	N indices antisymmetric under permutation,
+				  stored as i1 < i2 < ... < iN
+    libj::free_index		a single index with no symmetry
+
+  Within a group, the unique elements are ranked with the combinatorial
+  number system, rank = sum_m C(c_m,m), with c_m = i_m for antisymmetric
+  groups and c_m = i_m + m-1 for symmetric ones. The group ranks are then
+  stored column major, first group fastest.
+
+  INITIALIZATION
+  -------------------
+  A T2 amplitude with a<b and i<j, with nv virtuals and no occupieds
+    libj::packed_tensor<double,libj::antisym_group<2>,libj::antisym_group<2>> T2(nv,no);
+
+  A 3 index tensor symmetric in its first two indices
+    libj::packed_tensor<double,libj::sym_group<2>,libj::free_index> B(n,naux);
+
+  Allocate an existing tensor, one length per group
+    B.allocate(n,naux);
+    B.aligned_allocate(64,n,naux); //where 64 is the byte alignment
+    B.deallocate();
+
+  ELEMENT ACCESS
+  ------------------
+  Packed access, the indices of each group must be in storage order
+    T2(a,b,i,j);		//a<b, i<j
+
+  Unpacked access in any index order, returns sign*value, or zero for
+  repeated antisymmetric indices
+    T2.get(b,a,i,j);		//returns -T2(a,b,i,j)
+    T2.offset(idx,sign);	//offset of idx (size_t*) into data(), sets
+				//  sign, returns -1 if the element is zero
+
+  RANK/UNRANK
+  ------------------
+    T2.rank(g,idx);		//rank of the sorted indices idx within group g
+    T2.unrank(g,r,idx);		//sets the sorted indices of rank r in group g
+
+  PACK/UNPACK
+  ------------------
+    T2.pack(dense);		//packs a dense libj::tensor
+    T2.unpack(dense);		//unpacks into a dense libj::tensor
+    T2.unpack_panel(first,len,buf);	//unpacks dense (column major)
+					//  elements first..first+len-1 into buf
+
+  USEFUL FUNCTIONS
+  --------------------
+    T2.dim();			//returns number of dimensions
+    T2.size();			//returns number of stored elements
+    T2.dense_size();		//returns number of elements of the dense tensor
+    T2.dense_size(2);		//returns length of dimension 2
+    T2.group_size(1);		//returns number of unique elements of group 1
+    T2.data();			//returns data buffer pointer
+
+----------------------------------------------------------------------------*/
+#ifndef PACKED_TENSOR_HPP
+#define PACKED_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <array>
+
+#include "libjdef.h"
+#include "alignment.hpp"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// index group descriptors
+//------------------------------------------------------------------------
+template <size_t N>
+struct sym_group
+{
+  static_assert(N > 0,"libj::sym_group must have at least one index");
+  static constexpr size_t SIZE = N;
+  static constexpr int    SIGN = 1;
+};
+
+template <size_t N>
+struct antisym_group
+{
+  static_assert(N > 0,"libj::antisym_group must have at least one index");
+  static constexpr size_t SIZE = N;
+  static constexpr int    SIGN = -1;
+};
+
+typedef sym_group<1> free_index;
+
+//------------------------------------------------------------------------
+// total number of indices in a list of groups
+//------------------------------------------------------------------------
+template <class... Groups> struct group_dim;
+
+template <> struct group_dim<>
+{
+  static constexpr size_t value = 0;
+};
+
+template <class First, class... Rest> struct group_dim<First,Rest...>
+{
+  static constexpr size_t value = First::SIZE + group_dim<Rest...>::value;
+};
+
+//------------------------------------------------------------------------
+// packed_tensor class
+//------------------------------------------------------------------------
+template <typename T, class... Groups>
+class packed_tensor
+{
+  public:
+  static constexpr size_t NGROUP = sizeof...(Groups);
+  static constexpr size_t NDIM   = group_dim<Groups...>::value;
+
+  private:
+  T*                           M_BUFFER;       //start of data
+  T*                           M_POINTER;      //pointer to malloc
+  std::array<size_t,NGROUP>    M_GDIM;         //number of indices in each group
+  std::array<int,NGROUP>       M_GSIGN;        //sign of each group
+  std::array<size_t,NGROUP>    M_GSTART;       //first dimension of each group
+  std::array<size_t,NGROUP>    M_GLENGTH;      //length of the indices of each group
+  std::array<size_t,NGROUP>    M_GNELM;        //unique elements of each group
+  std::array<size_t,NGROUP>    M_GSTRIDE;      //stride of each group rank
+  std::array<size_t,NDIM>      M_LENGTHS;      //dense lengths
+  std::vector<size_t>          M_BINOM;        //binomial coefficients, C(n,k) at n*M_BINOM_LD+k
+  size_t                       M_BINOM_LD;     //leading dimension of M_BINOM
+  size_t                       M_NELM;         //number of stored elements
+  size_t                       M_NDENSE;       //number of dense elements
+  size_t                       M_ALIGNMENT;    //alignment in bytes
+  bool                         M_IS_ALLOCATED; //tensor is allocated
+
+  //internal functions
+  void m_set_default();
+  void m_set_lengths(const std::array<size_t,NGROUP>& lengths);
+  void m_aligned_allocate(const size_t ALIGN);
+  size_t m_binom(const size_t n, const size_t k) const
+  {
+    return (k > n) ? 0 : M_BINOM[n*M_BINOM_LD+k];
+  }
+  size_t m_packed_offset(const size_t* idx) const
+  {
+    size_t off = 0;
+    for (size_t g=0;g<NGROUP;g++)
+    {
+      off += M_GSTRIDE[g]*rank(g,idx+M_GSTART[g]);
+    }
+    return off;
+  }
+  T m_get(const size_t* idx) const
+  {
+    int sign;
+    const long off = offset(idx,sign);
+    return (off >= 0) ? (T) sign * M_BUFFER[off] : (T) 0;
+  }
+
+  public:
+
+  //Constructors and destructors
+  packed_tensor();
+  template <class... Lengths> packed_tensor(const Lengths... lengths);
+  ~packed_tensor();
+
+  //allocate, deallocate
+  template <class... Lengths> void allocate(const Lengths... lengths);
+  template <class... Lengths> void aligned_allocate(const size_t BYTES,
+                                                    const Lengths... lengths);
+  void deallocate();
+
+  //Getters
+  size_t size() const {return M_NELM;}
+  size_t dense_size() const {return M_NDENSE;}
+  size_t dense_size(const size_t dim) const {return M_LENGTHS[dim];}
+  size_t dim() const {return NDIM;}
+  size_t num_groups() const {return NGROUP;}
+  size_t group_size(const size_t g) const {return M_GNELM[g];}
+  size_t group_indices(const size_t g) const {return M_GDIM[g];}
+  int    group_sign(const size_t g) const {return M_GSIGN[g];}
+  size_t alignment() const {return M_ALIGNMENT;}
+  bool   is_allocated() const {return M_IS_ALLOCATED;}
+
+  //rank and unrank of sorted indices within a group
+  size_t rank(const size_t g, const size_t* idx) const;
+  void unrank(const size_t g, size_t r, size_t* idx) const;
+
+  //offset of (unsorted) dense indices, and the sign of the element
+  long offset(const size_t* idx, int& sign) const;
+
+  //Packed access, indices in storage order
+  template <class... Idx> T& operator() (const Idx... idx)
+  {
+    static_assert(sizeof...(Idx) == NDIM,"wrong number of indices to libj::packed_tensor");
+    const size_t I[NDIM] = {(size_t) idx...};
+    return *(M_BUFFER + m_packed_offset(I));
+  }
+  template <class... Idx> const T& operator() (const Idx... idx) const
+  {
+    static_assert(sizeof...(Idx) == NDIM,"wrong number of indices to libj::packed_tensor");
+    const size_t I[NDIM] = {(size_t) idx...};
+    return *(M_BUFFER + m_packed_offset(I));
+  }
+
+  //Unpacked access, indices in any order
+  template <class... Idx> T get(const Idx... idx) const
+  {
+    static_assert(sizeof...(Idx) == NDIM,"wrong number of indices to libj::packed_tensor");
+    const size_t I[NDIM] = {(size_t) idx...};
+    return m_get(I);
+  }
+
+  //pack and unpack
+  void pack(const libj::tensor<T>& dense);
+  void unpack(libj::tensor<T>& dense) const;
+  void unpack_panel(const size_t first, const size_t len, T* buf) const;
+
+  //Data function
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //prevent copies
+  packed_tensor(const packed_tensor& other) = delete;
+  packed_tensor& operator= (const packed_tensor& other) = delete;
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// set default values
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::m_set_default()
+{
+  const std::array<size_t,NGROUP> gdim = {{Groups::SIZE...}};
+  const std::array<int,NGROUP> gsign = {{Groups::SIGN...}};
+  M_GDIM = gdim;
+  M_GSIGN = gsign;
+  size_t start = 0;
+  for (size_t g=0;g<NGROUP;g++)
+  {
+    M_GSTART[g] = start;
+    start += M_GDIM[g];
+    M_GLENGTH[g] = 0;
+    M_GNELM[g] = 0;
+    M_GSTRIDE[g] = 0;
+  }
+  for (size_t dim=0;dim<NDIM;dim++) {M_LENGTHS[dim] = 0;}
+  M_BUFFER = NULL;
+  M_POINTER = NULL;
+  M_BINOM.clear();
+  M_BINOM_LD = 0;
+  M_NELM = 0;
+  M_NDENSE = 0;
+  M_ALIGNMENT = 0;
+  M_IS_ALLOCATED = false;
+}
+
+//-----------------------------------------------------------------------
+// blank constructor
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+packed_tensor<T,Groups...>::packed_tensor()
+{
+  m_set_default();
+}
+
+//-----------------------------------------------------------------------
+// allocate constructor
+//-----------------------------------------------------------------------
+template <typename T, class... Groups> template <class... Lengths>
+packed_tensor<T,Groups...>::packed_tensor(const Lengths... lengths)
+{
+  m_set_default();
+  allocate(lengths...);
+}
+
+//-----------------------------------------------------------------------
+// destructor
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+packed_tensor<T,Groups...>::~packed_tensor()
+{
+  if (M_IS_ALLOCATED) {deallocate();}
+}
+
+//-----------------------------------------------------------------------
+// m_set_lengths
+//	sets the group lengths, the binomial table, and the group sizes
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::m_set_lengths(const std::array<size_t,NGROUP>& lengths)
+{
+  M_GLENGTH = lengths;
+
+  //largest n and k of the binomial coefficients we will need
+  size_t NMAX = 0;
+  size_t KMAX = 0;
+  for (size_t g=0;g<NGROUP;g++)
+  {
+    if (M_GLENGTH[g] == 0)
+    {
+      printf("ERROR libj::packed_tensor::m_set_lengths\n");
+      printf("group %zu has length 0 \n",g);
+      exit(1);
+    }
+    const size_t n = M_GLENGTH[g] + M_GDIM[g];
+    if (n > NMAX) {NMAX = n;}
+    if (M_GDIM[g] > KMAX) {KMAX = M_GDIM[g];}
+  }
+
+  //Pascal's triangle
+  M_BINOM_LD = KMAX+1;
+  M_BINOM.assign((NMAX+1)*M_BINOM_LD,0);
+  for (size_t n=0;n<=NMAX;n++)
+  {
+    M_BINOM[n*M_BINOM_LD] = 1;
+    for (size_t k=1;k<=KMAX && k<=n;k++)
+    {
+      M_BINOM[n*M_BINOM_LD+k] = M_BINOM[(n-1)*M_BINOM_LD+k-1]
+                              + ((k<n) ? M_BINOM[(n-1)*M_BINOM_LD+k] : 0);
+    }
+  }
+
+  //group sizes and strides
+  M_NELM = 1;
+  M_NDENSE = 1;
+  for (size_t g=0;g<NGROUP;g++)
+  {
+    const size_t n = M_GLENGTH[g];
+    const size_t k = M_GDIM[g];
+    M_GNELM[g] = (M_GSIGN[g] < 0) ? m_binom(n,k) : m_binom(n+k-1,k);
+    M_GSTRIDE[g] = M_NELM;
+    M_NELM *= M_GNELM[g];
+    for (size_t m=0;m<k;m++)
+    {
+      M_LENGTHS[M_GSTART[g]+m] = n;
+      M_NDENSE *= n;
+    }
+  }
+
+  if (M_NELM == 0)
+  {
+    printf("ERROR libj::packed_tensor::m_set_lengths\n");
+    printf("tensor has no unique elements \n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// m_aligned_allocate
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::m_aligned_allocate(const size_t ALIGN)
+{
+  M_POINTER = (T*) mem_alloc(ALIGN+sizeof(T)*M_NELM,MEM_KIND_PACKED_TENSOR);
+  if (M_POINTER == NULL)
+  {
+    printf("ERROR libj::packed_tensor::m_aligned_allocate\n");
+    printf("could not allocate M_BUFFER \n");
+    exit(1);
+  }
+  const size_t M = (ALIGN > 0) ? (size_t) M_POINTER % ALIGN : 0; //number of bytes off
+  M_BUFFER = (M != 0) ? (T*) ((char*) M_POINTER + (ALIGN-M)) : M_POINTER;
+  M_IS_ALLOCATED = true;
+  M_ALIGNMENT = libj::calc_alignment((void*) M_BUFFER);
+}
+
+//-----------------------------------------------------------------------
+// allocate
+//-----------------------------------------------------------------------
+template <typename T, class... Groups> template <class... Lengths>
+void packed_tensor<T,Groups...>::allocate(const Lengths... lengths)
+{
+  static_assert(sizeof...(Lengths) == NGROUP,
+                "libj::packed_tensor needs one length per index group");
+  if (M_IS_ALLOCATED)
+  {
+    printf("ERROR libj::packed_tensor::allocate\n");
+    printf("attempted to allocate an already allocated tensor\n");
+    exit(1);
+  }
+  m_set_default();
+  const std::array<size_t,NGROUP> lens = {{(size_t) lengths...}};
+  m_set_lengths(lens);
+  m_aligned_allocate(0);
+}
+
+//-----------------------------------------------------------------------
+// aligned_allocate
+//-----------------------------------------------------------------------
+template <typename T, class... Groups> template <class... Lengths>
+void packed_tensor<T,Groups...>::aligned_allocate(const size_t ALIGN,
+                                                  const Lengths... lengths)
+{
+  static_assert(sizeof...(Lengths) == NGROUP,
+                "libj::packed_tensor needs one length per index group");
+  if (M_IS_ALLOCATED)
+  {
+    printf("ERROR libj::packed_tensor::aligned_allocate\n");
+    printf("attempted to allocate an already allocated tensor\n");
+    exit(1);
+  }
+  if (ALIGN%2 != 0)
+  {
+    printf("ERROR libj::packed_tensor::aligned_allocate\n");
+    printf("input BYTE ALIGN was not divisible by 2 \n");
+    exit(1);
+  }
+  m_set_default();
+  const std::array<size_t,NGROUP> lens = {{(size_t) lengths...}};
+  m_set_lengths(lens);
+  m_aligned_allocate(ALIGN);
+}
+
+//-----------------------------------------------------------------------
+// deallocate
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::deallocate()
+{
+  if (M_IS_ALLOCATED)
+  {
+    if (M_POINTER != NULL) {mem_free(M_POINTER);}
+    m_set_default();
+  } else {
+    printf("ERROR libj::packed_tensor::deallocate \n");
+    printf("attempted to deallocate an unallocated tensor \n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// rank
+//	rank of sorted group indices, sum_m C(c_m,m)
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+inline size_t packed_tensor<T,Groups...>::rank(const size_t g, const size_t* idx) const
+{
+  const size_t shift = (M_GSIGN[g] < 0) ? 0 : 1;
+  size_t r = 0;
+  for (size_t m=0;m<M_GDIM[g];m++)
+  {
+    r += m_binom(idx[m]+shift*m,m+1);
+  }
+  return r;
+}
+
+//-----------------------------------------------------------------------
+// unrank
+//	sorted group indices of rank r, found greedily from the last index.
+//	C(c,m) is nondecreasing in c, so each c is a binary search over
+//	the binomial table
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::unrank(const size_t g, size_t r, size_t* idx) const
+{
+  const size_t shift = (M_GSIGN[g] < 0) ? 0 : 1;
+  size_t c = M_GLENGTH[g] + shift*(M_GDIM[g]-1);
+  for (size_t m=M_GDIM[g];m>0;m--)
+  {
+    //largest c in [m-1,c) with C(c,m) <= r, C(m-1,m) = 0
+    size_t lo = m-1, hi = c-1;
+    while (lo < hi)
+    {
+      const size_t mid = lo + (hi-lo+1)/2;
+      if (m_binom(mid,m) <= r) {lo = mid;}
+      else {hi = mid-1;}
+    }
+    c = lo;
+    r -= m_binom(c,m);
+    idx[m-1] = c - shift*(m-1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// offset
+//	sorts each group of indices, tracking the sign for antisymmetric
+//	groups. Returns -1 if a repeated antisymmetric index makes the
+//	element zero.
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+long packed_tensor<T,Groups...>::offset(const size_t* idx, int& sign) const
+{
+  size_t S[NDIM];
+  for (size_t dim=0;dim<NDIM;dim++) {S[dim] = idx[dim];}
+
+  sign = 1;
+  size_t off = 0;
+  for (size_t g=0;g<NGROUP;g++)
+  {
+    size_t* s = S + M_GSTART[g];
+    const size_t k = M_GDIM[g];
+
+    //insertion sort, groups are small
+    size_t swaps = 0;
+    for (size_t m=1;m<k;m++)
+    {
+      const size_t v = s[m];
+      size_t n = m;
+      while (n > 0 && s[n-1] > v) {s[n] = s[n-1]; n--; swaps++;}
+      s[n] = v;
+    }
+
+    if (M_GSIGN[g] < 0)
+    {
+      for (size_t m=1;m<k;m++) {if (s[m] == s[m-1]) {sign = 0; return -1;}}
+      if (swaps%2 != 0) {sign = -sign;}
+    }
+
+    off += M_GSTRIDE[g]*rank(g,s);
+  }
+  return (long) off;
+}
+
+//-----------------------------------------------------------------------
+// pack
+//	copies the unique elements of a dense tensor
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::pack(const libj::tensor<T>& dense)
+{
+  if (dense.dim() != NDIM)
+  {
+    printf("ERROR libj::packed_tensor::pack\n");
+    printf("dense tensor has the wrong number of dimensions\n");
+    exit(1);
+  }
+  for (size_t dim=0;dim<NDIM;dim++)
+  {
+    if (dense.size(dim) != M_LENGTHS[dim])
+    {
+      printf("ERROR libj::packed_tensor::pack\n");
+      printf("dense tensor dimension %zu has the wrong length\n",dim);
+      exit(1);
+    }
+  }
+
+  const T* d = dense.data();
+  #if defined (LIBJ_OMP)
+  #pragma omp parallel for
+  #endif
+  for (long P=0;P<(long)M_NELM;P++)
+  {
+    size_t idx[NDIM];
+    size_t rem = (size_t) P;
+    for (size_t g=NGROUP;g>0;g--)
+    {
+      unrank(g-1,rem/M_GSTRIDE[g-1],idx+M_GSTART[g-1]);
+      rem %= M_GSTRIDE[g-1];
+    }
+    size_t off = 0;
+    for (size_t dim=0;dim<NDIM;dim++) {off += dense.stride(dim)*idx[dim];}
+    M_BUFFER[P] = d[off];
+  }
+}
+
+//-----------------------------------------------------------------------
+// unpack
+//	writes the full dense tensor
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::unpack(libj::tensor<T>& dense) const
+{
+  if (dense.dim() != NDIM)
+  {
+    printf("ERROR libj::packed_tensor::unpack\n");
+    printf("dense tensor has the wrong number of dimensions\n");
+    exit(1);
+  }
+  for (size_t dim=0;dim<NDIM;dim++)
+  {
+    if (dense.size(dim) != M_LENGTHS[dim])
+    {
+      printf("ERROR libj::packed_tensor::unpack\n");
+      printf("dense tensor dimension %zu has the wrong length\n",dim);
+      exit(1);
+    }
+  }
+
+  if (dense.is_sequential())
+  {
+    unpack_panel(0,M_NDENSE,dense.data());
+    return;
+  }
+
+  T* d = dense.data();
+  size_t idx[NDIM];
+  for (size_t dim=0;dim<NDIM;dim++) {idx[dim] = 0;}
+  for (size_t I=0;I<M_NDENSE;I++)
+  {
+    size_t off = 0;
+    for (size_t dim=0;dim<NDIM;dim++) {off += dense.stride(dim)*idx[dim];}
+    d[off] = m_get(idx);
+    for (size_t dim=0;dim<NDIM;dim++)
+    {
+      if (++idx[dim] < M_LENGTHS[dim]) {break;}
+      idx[dim] = 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// unpack_panel
+//	unpacks the column major dense elements first...first+len-1 into
+//	buf, which is how the jblis kernels read a packed tensor a panel
+//	at a time
+//-----------------------------------------------------------------------
+template <typename T, class... Groups>
+void packed_tensor<T,Groups...>::unpack_panel(const size_t first, const size_t len,
+                                              T* buf) const
+{
+  if (first + len > M_NDENSE)
+  {
+    printf("ERROR libj::packed_tensor::unpack_panel\n");
+    printf("panel %zu + %zu is past the end of the tensor \n",first,len);
+    exit(1);
+  }
+
+  //dense index of the first element
+  size_t idx[NDIM];
+  size_t rem = first;
+  for (size_t dim=0;dim<NDIM;dim++)
+  {
+    idx[dim] = rem%M_LENGTHS[dim];
+    rem /= M_LENGTHS[dim];
+  }
+
+  for (size_t I=0;I<len;I++)
+  {
+    buf[I] = m_get(idx);
+    for (size_t dim=0;dim<NDIM;dim++)
+    {
+      if (++idx[dim] < M_LENGTHS[dim]) {break;}
+      idx[dim] = 0;
+    }
+  }
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,254 @@
+/*----------------------------------------------------------------------------
+  scatter_cache.hpp
+	JHT, October 19, 2026 : created
+	JHT, October 19, 2026 : only the row stride of each pack is cached,
+	                        the scatter vectors are built per pack again
+
+  .hpp file for the scatter_cache, which remembers the row stride of each
+  pack of the column vector tensor_matrix of a tensor, so that repeated
+  operations on tensors of the same shape can skip scatter generation for
+  every pack whose rows are evenly spaced.
+
+  The scatter vectors themselves are not cached. They are built per pack,
+  inside the parallel region, by a block_scatter_matrix of each thread, and
+  while they are built the first time the stride of each pack is recorded.
+  An entry holds one size_t per pack, so it is far smaller than the tensor.
+
+  Entries are keyed by the lengths and strides of the tensor and the panel
+  and pack sizes of the loop, hashed without allocating. They do not depend
+  on the data buffer, and are never modified once built, so one entry can
+  be shared read only by all of the threads (and all of the tensors) that
+  use that shape. Lookups and inserts are guarded by a mutex, and should be
+  done once per operation, outside of the parallel region.
+
+  The cache holds at most LIBJ_SCATTER_CACHE_BYTES of entries. When this is
+  exceeded the oldest entries are dropped from the cache, though anyone
+  still holding one keeps it alive.
+
+  USAGE
+  ---------------------
+  //one lookup per operation, NULL on a miss
+  auto known = libj::scatter_cache::find(A,PANEL,PACK);
+
+  //pack p (p = panel*packs_per_panel + pack within the panel)
+  known->STRIDE[p];		//row stride of the pack, 0 if uneven
+
+  //after a miss, the strides recorded while building the packs
+  libj::scatter_cache::insert(A,PANEL,PACK,strides);
+
+  //the row stride of a pack built in a block_scatter_matrix
+  libj::scatter_cache::pack_stride(A_BLOCKED);
+
+  //cache management
+  libj::scatter_cache::clear();
+  libj::scatter_cache::bytes();		//bytes currently held by the cache
+  libj::scatter_cache::entries();	//number of entries held
+
+----------------------------------------------------------------------------*/
+#ifndef SCATTER_CACHE_HPP
+#define SCATTER_CACHE_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "libjdef.h"
+#include "tensor.hpp"
+
+#ifndef LIBJ_SCATTER_CACHE_BYTES
+#define LIBJ_SCATTER_CACHE_BYTES 67108864
+#endif
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// scatter_entry
+//	the pack strides of one tensor shape and pack layout
+//------------------------------------------------------------------------
+struct scatter_entry
+{
+  std::vector<size_t> KEY;	//dim, lengths, strides, panel, pack
+  std::vector<size_t> STRIDE;	//row stride of each pack, 0 if uneven
+
+  size_t bytes() const
+  {
+    return sizeof(size_t)*(KEY.size()+STRIDE.size());
+  }
+};
+
+//------------------------------------------------------------------------
+// scatter_cache
+//	process wide cache of scatter entries
+//------------------------------------------------------------------------
+class scatter_cache
+{
+  private:
+  typedef std::shared_ptr<const scatter_entry> entry_ptr;
+
+  struct state
+  {
+    std::mutex                                   LOCK;
+    std::unordered_map<size_t,entry_ptr>         MAP;
+    std::list<size_t>                            ORDER;	//insertion order
+    size_t                                       BYTES;
+    state() : BYTES(0) {}
+  };
+
+  static state& m_state()
+  {
+    static state S;
+    return S;
+  }
+
+  static size_t m_mix(size_t h, const size_t v)
+  {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+  }
+
+  template <typename T>
+  static size_t m_hash(const libj::tensor<T>& A, const size_t PANEL,
+                       const size_t PACK)
+  {
+    size_t h = m_mix(0,A.dim());
+    for (size_t i=0;i<A.dim();i++)
+    {
+      h = m_mix(h,A.size(i));
+      h = m_mix(h,A.stride(i));
+    }
+    h = m_mix(h,PANEL);
+    return m_mix(h,PACK);
+  }
+
+  template <typename T>
+  static bool m_match(const scatter_entry& E, const libj::tensor<T>& A,
+                      const size_t PANEL, const size_t PACK)
+  {
+    const size_t NDIM = A.dim();
+    if (E.KEY.size() != 2*NDIM+3 || E.KEY[0] != NDIM) {return false;}
+    for (size_t i=0;i<NDIM;i++)
+    {
+      if (E.KEY[1+i] != A.size(i) || E.KEY[1+NDIM+i] != A.stride(i)) {return false;}
+    }
+    return E.KEY[2*NDIM+1] == PANEL && E.KEY[2*NDIM+2] == PACK;
+  }
+
+  public:
+  //the entry of this shape and layout, or NULL
+  template <typename T>
+  static entry_ptr find(const libj::tensor<T>& A, const size_t PANEL,
+                        const size_t PACK)
+  {
+    const size_t h = m_hash(A,PANEL,PACK);
+    state& S = m_state();
+    std::lock_guard<std::mutex> guard(S.LOCK);
+    auto it = S.MAP.find(h);
+    if (it != S.MAP.end() && m_match(*it->second,A,PANEL,PACK)) {return it->second;}
+    return entry_ptr();
+  }
+
+  //stores the pack strides of this shape and layout, strides is taken
+  template <typename T>
+  static void insert(const libj::tensor<T>& A, const size_t PANEL,
+                     const size_t PACK, std::vector<size_t>& strides);
+
+  //row stride of the pack held by a block scatter matrix, 0 if uneven
+  template <class BSM>
+  static size_t pack_stride(const BSM& BLOCK)
+  {
+    const size_t NROW = BLOCK.size(0);
+    if (NROW < 2) {return 1;}
+    const size_t* RSCAT = BLOCK.row_scatter();
+    const size_t stride = RSCAT[1] - RSCAT[0];
+    for (size_t I=2;I<NROW;I++)
+    {
+      if (RSCAT[I] - RSCAT[I-1] != stride) {return 0;}
+    }
+    return stride;
+  }
+
+  static void clear()
+  {
+    state& S = m_state();
+    std::lock_guard<std::mutex> guard(S.LOCK);
+    S.MAP.clear();
+    S.ORDER.clear();
+    S.BYTES = 0;
+  }
+
+  static size_t bytes()
+  {
+    state& S = m_state();
+    std::lock_guard<std::mutex> guard(S.LOCK);
+    return S.BYTES;
+  }
+
+  static size_t entries()
+  {
+    state& S = m_state();
+    std::lock_guard<std::mutex> guard(S.LOCK);
+    return S.MAP.size();
+  }
+
+};//end of class
+
+//------------------------------------------------------------------------
+// insert
+//	a colliding entry of another shape is replaced
+//------------------------------------------------------------------------
+template <typename T>
+inline void scatter_cache::insert(const libj::tensor<T>& A, const size_t PANEL,
+                                  const size_t PACK, std::vector<size_t>& strides)
+{
+  std::shared_ptr<scatter_entry> entry = std::make_shared<scatter_entry>();
+  const size_t NDIM = A.dim();
+  entry->KEY.resize(2*NDIM+3);
+  entry->KEY[0] = NDIM;
+  for (size_t i=0;i<NDIM;i++)
+  {
+    entry->KEY[1+i] = A.size(i);
+    entry->KEY[1+NDIM+i] = A.stride(i);
+  }
+  entry->KEY[2*NDIM+1] = PANEL;
+  entry->KEY[2*NDIM+2] = PACK;
+  entry->STRIDE.swap(strides);
+
+  const size_t entry_bytes = entry->bytes();
+  if (entry_bytes > LIBJ_SCATTER_CACHE_BYTES) {return;}
+  const size_t h = m_hash(A,PANEL,PACK);
+
+  state& S = m_state();
+  std::lock_guard<std::mutex> guard(S.LOCK);
+  auto it = S.MAP.find(h);
+  if (it != S.MAP.end())
+  {
+    S.BYTES -= it->second->bytes();
+    S.MAP.erase(it);
+    for (auto o=S.ORDER.begin();o!=S.ORDER.end();o++)
+    {
+      if (*o == h) {S.ORDER.erase(o); break;}
+    }
+  }
+
+  //drop the oldest entries until this one fits
+  while (S.BYTES + entry_bytes > LIBJ_SCATTER_CACHE_BYTES && !S.ORDER.empty())
+  {
+    auto old = S.MAP.find(S.ORDER.front());
+    S.BYTES -= old->second->bytes();
+    S.MAP.erase(old);
+    S.ORDER.pop_front();
+  }
+
+  S.MAP[h] = entry;
+  S.ORDER.push_back(h);
+  S.BYTES += entry_bytes;
+}
+
+}//end of namespace
+
+#endif
@@ -44,7 +44,8 @@ class scatter_matrix
 
   //internal functions
   void m_set_default();
-  void m_set_scatter(const libj::tensor_matrix<T>& TMAT);
+  template <class LP, class RP>
+  void m_set_scatter(const libj::tensor_matrix_base<T,LP,RP>& TMAT);
   
   public:
 
@@ -52,10 +53,12 @@ class scatter_matrix
   scatter_matrix();
   
   //copy constructor
-  scatter_matrix(const libj::tensor_matrix<T>& TMAT);
+  template <class LP, class RP>
+  scatter_matrix(const libj::tensor_matrix_base<T,LP,RP>& TMAT);
 
   //copy assignment constructor
-  scatter_matrix& operator= (const libj::tensor_matrix<T>& TMAT);
+  template <class LP, class RP>
+  scatter_matrix& operator= (const libj::tensor_matrix_base<T,LP,RP>& TMAT);
 
   //Access operator
   T& operator() (const size_t I, const size_t J) 
@@ -104,8 +107,8 @@ scatter_matrix<T>::scatter_matrix()
 //------------------------------------------------------------------------
 // copy constructor 
 //------------------------------------------------------------------------
-template <typename T>
-scatter_matrix<T>::scatter_matrix(const libj::tensor_matrix<T>& TMAT)
+template <typename T> template <class LP, class RP>
+scatter_matrix<T>::scatter_matrix(const libj::tensor_matrix_base<T,LP,RP>& TMAT)
 {
   //set the buffer
   M_BUFFER = const_cast<T*>(TMAT.data());
@@ -117,8 +120,8 @@ scatter_matrix<T>::scatter_matrix(const libj::tensor_matrix<T>& TMAT)
 //------------------------------------------------------------------------
 // Copy assignment
 //------------------------------------------------------------------------
-template <typename T>
-scatter_matrix<T>& scatter_matrix<T>::operator=(const libj::tensor_matrix<T>& TMAT)
+template <typename T> template <class LP, class RP>
+scatter_matrix<T>& scatter_matrix<T>::operator=(const libj::tensor_matrix_base<T,LP,RP>& TMAT)
 {
   M_BUFFER = const_cast<T*>(TMAT.data()); 
 
@@ -133,8 +136,8 @@ scatter_matrix<T>& scatter_matrix<T>::operator=(const libj::tensor_matrix<T>& TM
 //	given some tensor matrix TMAT, sets the scatter row and col vectors
 //	for this scatter matrix
 //------------------------------------------------------------------------
-template <typename T>
-void scatter_matrix<T>::m_set_scatter(const libj::tensor_matrix<T>& TMAT)
+template <typename T> template <class LP, class RP>
+void scatter_matrix<T>::m_set_scatter(const libj::tensor_matrix_base<T,LP,RP>& TMAT)
 {
   M_NROW = TMAT.size(0);
   M_NCOL = TMAT.size(1);
@@ -1,6 +1,10 @@
 /*----------------------------------------------------------------------------
   tensor.hpp
 	JHT, April 10, 2022 : created
+	JHT, October 19, 2026 : allocations through mem.hpp
+	JHT, October 19, 2026 : binary save, load, and view (see mem_io.hpp)
+	JHT, October 19, 2026 : strided assign
+	JHT, October 19, 2026 : strided tensors are packed by save and load
 
   .hpp file for the general tensor class. This behaves similarly to 
   std::array in that it cannot be grown dynamically, though it can be 
@@ -29,6 +33,9 @@
     T.allocate(1,4,3);
     T.aligned_allocate(64,1,4,3); //where 64 is the byte alignment 
     T.assign(1,4,3,pointer);
+    T.assign(pointer,{1,4,3}); //rank only known at runtime
+    T.allocate({1,4,3});       //rank only known at runtime
+    T.assign(pointer,{2,3},{1,8}); //strided view, lengths then strides
 
   Deallocate
     T.deallocate();
@@ -63,6 +70,19 @@
     T.is_sequential();		//returns true if elements of tensor are sequential
     T.offset({vector});		//returns the offset from start for a set of indicies
     T.data();			//returns data buffer pointer 
+
+  BINARY RECORDS (see mem_io.hpp), return 0 or a MEM_IO_ERR_*
+  --------------------
+    T.save(fptr);		//write a record at the position of fptr
+    T.load(fptr);		//read the next record, allocating T if 
+				//  it is unset, else it must be that shape
+    T.view(rec,bytes);		//assign T to the data of a mapped record,
+				//  no copy
+
+    Records hold the elements packed, in column major order. A strided
+    tensor (not is_sequential) is packed through its strides by save,
+    and load unpacks into it, so the gaps between its elements are not
+    touched. Both use a copy of the tensor to do so
     
 ----------------------------------------------------------------------------*/
 #ifndef TENSOR_HPP
@@ -76,6 +96,8 @@
 //This defines alignments
 #include "libjdef.h"
 #include "alignment.hpp"
+#include "mem.hpp"
+#include "mem_io.hpp"
 
 namespace libj 
 {
@@ -103,6 +125,8 @@ class tensor
   void m_assign(T* pointer);
   void m_assign(const T* pointer);
   void m_sequential();
+  void m_pack(T* dst) const;
+  void m_unpack(const T* src);
 
   //internal varadic templates for data access
   template<class...Rest>
@@ -178,6 +202,10 @@ class tensor
                                                const Rest...rest);
   template<class...Rest> void assign(T* pointer, const size_t first,const Rest...rest);
   template<class...Rest> void assign(const T* pointer, const size_t first,const Rest...rest);
+  void assign(T* pointer, const std::vector<size_t>& lengths);
+  void assign(T* pointer, const std::vector<size_t>& lengths,
+              const std::vector<size_t>& strides);
+  void allocate(const std::vector<size_t>& lengths);
   void deallocate();
   void unassign();
 
@@ -234,6 +262,11 @@ class tensor
   T* data() {return M_BUFFER;}
   const T* data() const {return M_BUFFER;}
 
+  //binary records
+  int save(FILE* fptr) const;
+  int load(FILE* fptr);
+  int view(const void* rec, const size_t bytes);
+
 
   //Create a block
 /*
@@ -381,7 +414,7 @@ void tensor<T>::m_allocate()
 {
   if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
   {
-    M_POINTER = (T*) malloc(sizeof(T)*M_NELM);
+    M_POINTER = (T*) mem_alloc(sizeof(T)*M_NELM,MEM_KIND_TENSOR);
     M_BUFFER = M_POINTER;
     if (M_BUFFER == NULL || M_POINTER == NULL)
     {
@@ -458,7 +491,7 @@ void libj::tensor<T>::m_aligned_allocate(const size_t ALIGN)
     }
 
     //align the buffer pointer  
-    M_POINTER = (T*) malloc(ALIGN+M_NELM*sizeof(T));
+    M_POINTER = (T*) mem_alloc(ALIGN+M_NELM*sizeof(T),MEM_KIND_TENSOR);
     if (M_POINTER != NULL)
     {
       long M = (long)M_POINTER%(long)ALIGN; //number of bytes off
@@ -574,6 +607,91 @@ void tensor<T>::assign(T* pointer, const size_t first,const Rest...rest)
   }
 }
 
+//-----------------------------------------------------------------------
+// assign with a vector of lengths, for when the rank is only known at
+// runtime
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::assign(T* pointer, const std::vector<size_t>& lengths)
+{
+  if (!M_IS_ALLOCATED)
+  {
+    m_set_default();
+    M_NELM = 1;
+    for (size_t dim=0;dim<lengths.size();dim++)
+    {
+      M_STRIDE.push_back(M_NELM);
+      M_LENGTHS.push_back(lengths[dim]);
+      M_NELM *= lengths[dim];
+    }
+    m_init();
+    m_assign(pointer);
+  } else {
+    printf("ERROR libj::tensor::assign\n");
+    printf("attempted to assign an already allocated tensor\n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// assign with vectors of lengths and strides, a view of part of a larger
+// buffer
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::assign(T* pointer, const std::vector<size_t>& lengths,
+                       const std::vector<size_t>& strides)
+{
+  if (lengths.size() != strides.size())
+  {
+    printf("ERROR libj::tensor::assign\n");
+    printf("%zu lengths but %zu strides\n",lengths.size(),strides.size());
+    exit(1);
+  }
+  if (!M_IS_ALLOCATED)
+  {
+    m_set_default();
+    M_NELM = 1;
+    for (size_t dim=0;dim<lengths.size();dim++)
+    {
+      M_STRIDE.push_back(strides[dim]);
+      M_LENGTHS.push_back(lengths[dim]);
+      M_NELM *= lengths[dim];
+    }
+    m_init();
+    m_assign(pointer);
+  } else {
+    printf("ERROR libj::tensor::assign\n");
+    printf("attempted to assign an already allocated tensor\n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// allocate with a vector of lengths, for when the rank is only known at
+// runtime
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::allocate(const std::vector<size_t>& lengths)
+{
+  if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
+  {
+    m_set_default();
+    M_NELM = 1;
+    for (size_t dim=0;dim<lengths.size();dim++)
+    {
+      M_STRIDE.push_back(M_NELM);
+      M_LENGTHS.push_back(lengths[dim]);
+      M_NELM *= lengths[dim];
+    }
+    m_init();
+    m_allocate();
+  } else {
+    printf("ERROR libj::tensor::allocate\n");
+    printf("attempted to allocated an already allocated tensor\n");
+    exit(1);
+  }
+}
+
 //-----------------------------------------------------------------------
 // deallocate via free 
 //-----------------------------------------------------------------------
@@ -582,7 +700,7 @@ void tensor<T>::deallocate()
 {
   if (M_IS_ALLOCATED)
   {
-    if (M_POINTER != NULL) {free(M_POINTER);}
+    if (M_POINTER != NULL) {mem_free(M_POINTER);}
     M_BUFFER = NULL;
   } else {
     printf("ERROR libj::tensor::deallocate \n");
@@ -609,6 +727,128 @@ void tensor<T>::unassign()
   }
 } 
 
+//-----------------------------------------------------------------------
+// save -- write the tensor as a record at the position of fptr
+//-----------------------------------------------------------------------
+template<typename T>
+int tensor<T>::save(FILE* fptr) const
+{
+  if (mem_io_type<T>() == MEM_IO_NONE || M_NDIM > MEM_IO_MAXRANK) {return MEM_IO_ERR_TYPE;}
+
+  //the record holds the packed elements, with packed strides
+  std::vector<size_t> strides(M_NDIM);
+  size_t NN = 1;
+  for (size_t dim=0;dim<M_NDIM;dim++) {strides[dim] = NN; NN *= M_LENGTHS[dim];}
+  mem_io_head h = mem_io_make(MEM_KIND_TENSOR,mem_io_type<T>(),sizeof(T),M_NDIM,
+                              M_LENGTHS.data(),strides.data(),M_NELM,M_ALIGNMENT);
+  if (M_IS_SEQUENTIAL) {return mem_io_write(fptr,h,M_BUFFER);}
+
+  std::vector<T> packed(M_NELM);
+  m_pack(packed.data());
+  return mem_io_write(fptr,h,packed.data());
+}
+
+//-----------------------------------------------------------------------
+// load -- read the next record of fptr into the tensor, which is
+//   allocated if it is unset, and must otherwise be of the same shape
+//-----------------------------------------------------------------------
+template<typename T>
+int tensor<T>::load(FILE* fptr)
+{
+  mem_io_head h;
+  int err = mem_io_read_head(fptr,h);
+  if (err != 0) {return err;}
+  if ((err = mem_io_check_type<T>(h,MEM_KIND_TENSOR,h.rank)) != 0) {return err;}
+
+  const std::vector<size_t> lengths(h.lengths,h.lengths+h.rank);
+  if (!is_set())
+  {
+    allocate(lengths);
+  } else if (lengths != M_LENGTHS) {
+    return MEM_IO_ERR_SHAPE;
+  }
+  if (M_IS_SEQUENTIAL) {return mem_io_read_data(fptr,h,M_BUFFER);}
+
+  //only a checked record is unpacked
+  std::vector<T> packed(M_NELM);
+  if ((err = mem_io_read_data(fptr,h,packed.data())) != 0) {return err;}
+  m_unpack(packed.data());
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// m_pack -- copy the elements, in column major order, into dst
+//-----------------------------------------------------------------------
+template<typename T>
+void tensor<T>::m_pack(T* dst) const
+{
+  std::vector<size_t> idx(M_NDIM,0);
+  size_t off = 0;
+  for (size_t n=0;n<M_NELM;n++)
+  {
+    dst[n] = M_BUFFER[off];
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      off += M_STRIDE[dim];
+      if (++idx[dim] < M_LENGTHS[dim]) {break;}
+      off -= idx[dim]*M_STRIDE[dim];
+      idx[dim] = 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// m_unpack -- copy the elements, in column major order, from src
+//-----------------------------------------------------------------------
+template<typename T>
+void tensor<T>::m_unpack(const T* src)
+{
+  std::vector<size_t> idx(M_NDIM,0);
+  size_t off = 0;
+  for (size_t n=0;n<M_NELM;n++)
+  {
+    M_BUFFER[off] = src[n];
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      off += M_STRIDE[dim];
+      if (++idx[dim] < M_LENGTHS[dim]) {break;}
+      off -= idx[dim]*M_STRIDE[dim];
+      idx[dim] = 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// view -- assign the tensor to the data of the record at rec, which
+//   holds bytes, without a copy, with the strides of the record. The
+//   data is not checked (see mem_io_verify), and lives as long as the
+//   mapping
+//-----------------------------------------------------------------------
+template<typename T>
+int tensor<T>::view(const void* rec, const size_t bytes)
+{
+  mem_io_head h;
+  const void* data = mem_io_parse(rec,bytes,h);
+  if (data == NULL) {return MEM_IO_ERR_HEAD;}
+  int err = mem_io_check_type<T>(h,MEM_KIND_TENSOR,h.rank);
+  if (err != 0) {return err;}
+  if (bytes < MEM_IO_HEAD_BYTES + h.data_bytes) {return MEM_IO_ERR_READ;}
+  if (M_IS_ALLOCATED) {return MEM_IO_ERR_SET;}
+
+  //every element must lie in the data of the record
+  const std::vector<size_t> lengths(h.lengths,h.lengths+h.rank);
+  const std::vector<size_t> strides(h.strides,h.strides+h.rank);
+  size_t last = 0;
+  for (size_t dim=0;dim<h.rank;dim++)
+  {
+    if (lengths[dim] == 0) {return MEM_IO_ERR_SHAPE;}
+    last += (lengths[dim]-1)*strides[dim];
+  }
+  if (last >= h.nelm) {return MEM_IO_ERR_SHAPE;}
+  assign((T*) data,lengths,strides);
+  return 0;
+}
+
 //-----------------------------------------------------------------------
 // copy assignment constructor 
 //-----------------------------------------------------------------------
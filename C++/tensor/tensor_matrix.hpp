@@ -1,14 +1,15 @@
 /*----------------------------------------------------------------------------
   tensor_matrix.hpp
 	JHT, April 25, 2022 : created
+	JHT, October 19, 2026 : merged with tensor_matrix2, metadata storage is a policy
 
-  .hpp file for the tensor_matrix class, which is used to "matrixicize" 
+  .hpp file for the tensor_matrix class, which is used to "matrixicize"
   a tensor. This is purely used to represent an underlying tensor, and
   can only be copied or assigned from a tensor.
 
   The LHS and RHS bundles are represented as a string, such as "adc","b"
   which uses "a" as a reference to the first dimension, "b" as the second
-  dimension, etc etc. 
+  dimension, etc etc.
 
   Thus, a tensor with dimensions {4,1,3,2} coule be represented as a matrix
   with {4,3} and {1,2} index bundles if the LHS bundles are given as "ac" and
@@ -17,27 +18,32 @@
   NOTE: In the case of empty LHS and RHS bundles, the tensor is just taken to be
   a column vector
 
+  The bundle metadata storage is set by a policy (see meta_policy.hpp)
+    libj::tensor_matrix<T>		//std::vector bundles, any rank
+    libj::tensor_matrix2<T,NLHS,NRHS>	//std::array bundles, ranks known at
+					//  compile time, no allocations
+
   Construction
   ---------------------
   libj::tensor_matrix<double> A;
-  A.assign(tensor,"abc","d"); 			
+  A.assign(tensor,"abc","d");
   libj::tensor_matrix<int> B(tensor,"","");	//yields a col-vector rep. of tensor
- 
-  libj::tensor
+  libj::tensor_matrix2<double,3,1> C(tensor,"abc","d");
 
   Matrix-style access
   ---------------------
-  A(I,J); 
+  A(I,J);
 
   Creating a subblock
   ---------------------
-  libj::tensor_matrix<double> T2 = T1.block(ROW,COL,NUM_ROWS,NUM_COLS); 
+  libj::tensor_matrix<double> T2 = T1.block(ROW,COL,NUM_ROWS,NUM_COLS);
 
   Useful functions
   ---------------------
   A.data();		//returns pointer to data buffer
-  A.offset(I,J); 	//returns of offset from data buffer 
-				for bundled indicies
+  A.tensor_data();	//returns pointer to the data of the whole tensor
+  A.offset(I,J); 	//returns of offset from tensor data for
+			//  bundled indicies
 
 ----------------------------------------------------------------------------*/
 #ifndef TENSOR_MATRIX_HPP
@@ -45,6 +51,7 @@
 
 #include "tensor.hpp"
 #include "index_bundle.hpp"
+#include "meta_policy.hpp"
 #include "alignment.hpp"
 #include <stdlib.h>
 #include <string>
@@ -55,49 +62,52 @@ namespace libj
 {
 
 //------------------------------------------------------------------------
-// tensor_matrix class
+// tensor_matrix_base class
+//	LP and RP are the metadata policies of the LHS and RHS bundles
 //------------------------------------------------------------------------
-template <typename T>
-class tensor_matrix
+template <typename T, class LP, class RP>
+class tensor_matrix_base
 {
   private:
   //data
-  T*                   M_BUFFER;     //pointer to base data, offset in case of block
-  libj::tensor<T>      M_TENSOR;     //pointer to tensor this represents
-  libj::index_bundle   M_LHS;	     //left hand side index bundles
-  libj::index_bundle   M_RHS;        //right hand size index bundles
-  std::vector<size_t>  M_DUMMY;	     //dummy vector for access to M_TENSOR 
+  T*                       M_BUFFER;     //pointer to base data, offset in case of block
+  T*                       M_BASE;       //pointer to data of the tensor this represents
+  size_t                   M_NDIM;       //number of dimensions of the tensor
+  libj::index_bundle_t<LP> M_LHS;	 //left hand side index bundles
+  libj::index_bundle_t<RP> M_RHS;        //right hand size index bundles
 
   //Internal functions
   void m_set_default(); //set the default values
-  void m_set_dimensions(const std::string& lhs, const std::string& rhs);
+  void m_set_dimensions(const libj::tensor<T>& tens,
+                        const std::string& lhs, const std::string& rhs);
   bool m_good_bundles();
 
   public:
   //Constructors
-  tensor_matrix();
+  tensor_matrix_base();
 
   //Copy constructor from tensor
-  tensor_matrix(const libj::tensor<T>& tens, const std::string& lhs, const std::string& rhs);
+  tensor_matrix_base(const libj::tensor<T>& tens, const std::string& lhs, const std::string& rhs);
 
   //Assignment
   void assign(libj::tensor<T>& tens, const std::string& lhs, const std::string& rhs);
   void assign(const libj::tensor<T>& tens, const std::string& lhs, const std::string& rhs);
 
   //getters
-  size_t size() const {return M_LHS.NELM * M_RHS.NELM;} 
-  size_t size(const size_t dim) const 
+  size_t size() const {return M_LHS.NELM * M_RHS.NELM;}
+  size_t size(const size_t dim) const
   {
     return dim == 0? M_LHS.NELM : M_RHS.NELM;
   }
-  size_t bundle_size(const size_t side)
+  size_t bundle_size(const size_t side) const
   {
     return side == 0? M_LHS.NDIM : M_RHS.NDIM;
   }
+  size_t dim() const {return M_NDIM;}
 
   //access functions
-  T& operator() (const size_t I, const size_t J);
-  const T& operator() (const size_t I, const size_t J) const;
+  T& operator() (const size_t I, const size_t J) {return *(M_BASE + offset(I,J));}
+  const T& operator() (const size_t I, const size_t J) const {return *(M_BASE + offset(I,J));}
 
   //offset functions
   size_t offset(const size_t I, const size_t J) const;
@@ -110,48 +120,57 @@ class tensor_matrix
 
   //data function
   T* data() {return M_BUFFER;}
-  const T* data() const {return M_BUFFER;} 
+  const T* data() const {return M_BUFFER;}
+  T* tensor_data() {return M_BASE;}
+  const T* tensor_data() const {return M_BASE;}
 
   //block function
-  tensor_matrix<T> block(const size_t ROW, const size_t COL, 
-                         const size_t NROW, const size_t NCOL);
-  const tensor_matrix<T> block(const size_t ROW, const size_t COL, 
-                               const size_t NROW, const size_t NCOL) const;
+  tensor_matrix_base block(const size_t ROW, const size_t COL,
+                           const size_t NROW, const size_t NCOL);
+  const tensor_matrix_base block(const size_t ROW, const size_t COL,
+                                 const size_t NROW, const size_t NCOL) const;
 
+};//end of class
 
+//-----------------------------------------------------------------------------------------
+// the dynamic and fixed tensor matrices
+//-----------------------------------------------------------------------------------------
+template <typename T>
+using tensor_matrix = tensor_matrix_base<T,libj::dynamic_meta,libj::dynamic_meta>;
 
-};//end of class
+template <typename T, size_t NLHS, size_t NRHS>
+using tensor_matrix2 = tensor_matrix_base<T,libj::fixed_meta<NLHS>,libj::fixed_meta<NRHS>>;
 
 //-----------------------------------------------------------------------------------------
 // set default values
 //-----------------------------------------------------------------------------------------
-template<typename T>
-void tensor_matrix<T>::m_set_default()
+template<typename T, class LP, class RP>
+void tensor_matrix_base<T,LP,RP>::m_set_default()
 {
-  //don't set the tensor yet
   M_LHS.clear();
   M_RHS.clear();
-  M_DUMMY.clear();
   M_BUFFER = NULL;
+  M_BASE = NULL;
+  M_NDIM = 0;
 }
 
 //-----------------------------------------------------------------------------------------
-// empty constructor 
+// empty constructor
 //-----------------------------------------------------------------------------------------
-template <typename T>
-tensor_matrix<T>::tensor_matrix()
+template <typename T, class LP, class RP>
+tensor_matrix_base<T,LP,RP>::tensor_matrix_base()
 {
-  //m_set_default();
+  m_set_default();
 }
 
 //-----------------------------------------------------------------------------------------
-// copy constructor 
+// copy constructor
 //-----------------------------------------------------------------------------------------
-template <typename T>
-tensor_matrix<T>::tensor_matrix(const libj::tensor<T>& tens, const std::string& lhs,
-                                const std::string& rhs)
+template <typename T, class LP, class RP>
+tensor_matrix_base<T,LP,RP>::tensor_matrix_base(const libj::tensor<T>& tens,
+                                                const std::string& lhs,
+                                                const std::string& rhs)
 {
-//  m_set_default();
   assign(tens,lhs,rhs);
 }
 
@@ -159,172 +178,137 @@ tensor_matrix<T>::tensor_matrix(const libj::tensor<T>& tens, const std::string&
 // m_set_dimensions
 //	sets the bundles and dimensions of the tensor_matrix
 //-----------------------------------------------------------------------------------------
-template<typename T>
-void tensor_matrix<T>::m_set_dimensions(const std::string& lhs, 
-                                        const std::string& rhs)
+template<typename T, class LP, class RP>
+void tensor_matrix_base<T,LP,RP>::m_set_dimensions(const libj::tensor<T>& tens,
+                                                   const std::string& lhs,
+                                                   const std::string& rhs)
 {
+  M_NDIM = tens.dim();
 
   //if both lhs and rhs are empty, make lhs and rhs such that this is a col vector
   if (lhs.length() == 0 && rhs.length()==0)
   {
     std::string new_lhs;
-    new_lhs.reserve(M_TENSOR.dim());
-    for (size_t i=0;i<M_TENSOR.dim();i++)
+    new_lhs.reserve(M_NDIM);
+    for (size_t i=0;i<M_NDIM;i++)
     {
       new_lhs.push_back((char)((int) 'a' + (int)i));
     }
-    M_LHS.make_bundle<T>(M_TENSOR,new_lhs);
-    M_RHS.make_bundle<T>(M_TENSOR,"");
+    M_LHS.make_bundle(tens,new_lhs);
+    M_RHS.make_bundle(tens,"");
   } else {
-    //go through each and make the bundles 
-    M_LHS.make_bundle<T>(M_TENSOR,lhs);
-    M_RHS.make_bundle<T>(M_TENSOR,rhs);
+    //go through each and make the bundles
+    M_LHS.make_bundle(tens,lhs);
+    M_RHS.make_bundle(tens,rhs);
   }
 
   //check if the bundles were good
   if (!m_good_bundles())
-  { 
+  {
     printf("ERROR libj::tensor_matrix::m_set_dimensions \n");
     printf("The input bundles are bad \n");
     printf("LHS = %s \n",lhs.c_str());
     printf("RHS = %s \n",rhs.c_str());
     exit(1);
   }
-
-  M_DUMMY.resize(M_TENSOR.dim());
 }
 
 //-----------------------------------------------------------------------------------------
 // m_check_bundles
+//	each dimension must appear exactly once, tracked with a bit mask
+//	so that no allocation is needed
 //-----------------------------------------------------------------------------------------
-template <typename T>
-bool tensor_matrix<T>::m_good_bundles()
+template <typename T, class LP, class RP>
+bool tensor_matrix_base<T,LP,RP>::m_good_bundles()
 {
   //check that the number of dimensions in each sums to tensor dimensions
-  if (M_LHS.NDIM + M_RHS.NDIM != M_TENSOR.dim()) {return false;}
+  if (M_LHS.NDIM + M_RHS.NDIM != M_NDIM) {return false;}
+  if (M_NDIM > 64) {return false;}
 
   //check that each dimension only appears once
-  const size_t TOT = M_LHS.NDIM + M_RHS.NDIM;
-  std::vector<size_t> COUNT(TOT);
-  for (size_t dim = 0; dim < TOT ; dim++) {COUNT[dim] = 0;} 
-  for (size_t idx = 0; idx < M_LHS.NDIM; idx++) {COUNT.at(M_LHS.DIM[idx])++;}
-  for (size_t idx = 0; idx < M_RHS.NDIM; idx++) {COUNT.at(M_RHS.DIM[idx])++;}
-  for (size_t dim = 0; dim < TOT; dim++) {if (COUNT[dim] != 1) {return false;}}
+  unsigned long long seen = 0;
+  for (size_t idx = 0; idx < M_LHS.NDIM; idx++)
+  {
+    const size_t dim = M_LHS.DIM[idx];
+    if (dim >= M_NDIM || (seen >> dim) & 1ULL) {return false;}
+    seen |= 1ULL << dim;
+  }
+  for (size_t idx = 0; idx < M_RHS.NDIM; idx++)
+  {
+    const size_t dim = M_RHS.DIM[idx];
+    if (dim >= M_NDIM || (seen >> dim) & 1ULL) {return false;}
+    seen |= 1ULL << dim;
+  }
   return true;
 }
 
 
 //-----------------------------------------------------------------------------------------
-// Assigment 
+// Assigment
 //-----------------------------------------------------------------------------------------
-template<typename T>
-void tensor_matrix<T>::assign(libj::tensor<T>& tens, 
-                             const std::string& lhs, const std::string& rhs)
+template<typename T, class LP, class RP>
+void tensor_matrix_base<T,LP,RP>::assign(libj::tensor<T>& tens,
+                                         const std::string& lhs, const std::string& rhs)
 {
   //reset default values (incase the tensor_matrix is already set)
   m_set_default();
 
   //assign the pointer
-  M_TENSOR = tens;
-  M_BUFFER = M_TENSOR.data(); 
+  M_BASE = tens.data();
+  M_BUFFER = M_BASE;
 
   //set the dimensions
-  m_set_dimensions(lhs,rhs);
+  m_set_dimensions(tens,lhs,rhs);
 }
 
-template<typename T>
-void tensor_matrix<T>::assign(const libj::tensor<T>& tens, 
-                              const std::string& lhs, const std::string& rhs)
+template<typename T, class LP, class RP>
+void tensor_matrix_base<T,LP,RP>::assign(const libj::tensor<T>& tens,
+                                         const std::string& lhs, const std::string& rhs)
 {
   //reset default values (incase the tensor_matrix is already set)
   m_set_default();
 
   //assign the pointer
-  M_TENSOR = tens;
-  M_BUFFER = M_TENSOR.data();
+  M_BASE = const_cast<T*>(tens.data());
+  M_BUFFER = M_BASE;
 
   //set the dimensions
-  m_set_dimensions(lhs,rhs);
-}
-
-//-----------------------------------------------------------------------------------------
-// Access operators
-//-----------------------------------------------------------------------------------------
-template <typename T>
-T& tensor_matrix<T>::operator() (const size_t I, const size_t J)
-{
-  //LHS
-  for (size_t idx = 0; idx < M_LHS.NDIM; idx++)
-  {
-    const size_t dim = M_LHS.DIM[idx];
-    M_DUMMY[dim] = M_LHS.get_index(I,idx);
-  }
-
-  //RHS
-  for (size_t idx = 0; idx < M_RHS.NDIM; idx++)
-  {
-    const size_t dim = M_RHS.DIM[idx];
-    M_DUMMY[dim] = M_RHS.get_index(J,idx);
-  }
- 
-  return M_TENSOR(M_DUMMY);
-}
-
-template <typename T>
-const T& tensor_matrix<T>::operator() (const size_t I, const size_t J) const
-{
-  std::vector<size_t> vec(M_LHS.NDIM + M_RHS.NDIM);
-  //LHS
-  for (size_t idx = 0; idx < M_LHS.NDIM; idx++)
-  {
-    const size_t dim = M_LHS.DIM[idx];
-    vec[dim] = M_LHS.get_index(I,idx);
-  }
-
-  //RHS
-  for (size_t idx = 0; idx < M_RHS.NDIM; idx++)
-  {
-    const size_t dim = M_RHS.DIM[idx];
-    vec[dim] = M_RHS.get_index(J,idx);
-  }
-
-  return M_TENSOR(vec);
+  m_set_dimensions(tens,lhs,rhs);
 }
 
 //-----------------------------------------------------------------------------------------
 // offset
 //	returns offset for bundle indices in the original matrix
 //-----------------------------------------------------------------------------------------
-template <typename T>
-size_t tensor_matrix<T>::offset(const size_t I, const size_t J) const
+template <typename T, class LP, class RP>
+inline size_t tensor_matrix_base<T,LP,RP>::offset(const size_t I, const size_t J) const
 {
   return M_LHS.offset(I) + M_RHS.offset(J);
-
 }
 
 //-----------------------------------------------------------------------------------------
 // offset_col
 // calculates a block of offsets starting with I (LHS)and going to I+NI-1, with a fixed
 //   J(RHS)
-//   
+//
 //   I and J    : the starting rows and cols for the offset
 //   NI         : the number of rows to calculate
 //   rel        : an offset to calculate this relative to
 //   off*       : pointer to offset data
 //-----------------------------------------------------------------------------------------
-template <typename T>
-inline void tensor_matrix<T>::offset_col(const size_t I, const size_t J,
-                                         const size_t NI, const size_t rel,
-                                         size_t* off) const
+template <typename T, class LP, class RP>
+inline void tensor_matrix_base<T,LP,RP>::offset_col(const size_t I, const size_t J,
+                                                    const size_t NI, const size_t rel,
+                                                    size_t* off) const
 {
-  const size_t JOFF = M_RHS.offset(J); 
+  const size_t JOFF = M_RHS.offset(J);
   size_t tmp = M_LHS.offset(I+0);
   for (size_t i=1;i<NI;i++)
   {
     tmp += JOFF;
     off[i-1] = tmp - rel;
     tmp = M_LHS.offset(I+i);
-  } 
+  }
   tmp += JOFF;
   off[NI-1] = tmp - rel;
 }
@@ -334,84 +318,58 @@ inline void tensor_matrix<T>::offset_col(const size_t I, const size_t J,
 // calculates a block of offsets starting with J (RHS)and going to J+NJ-1, with a fixed
 //   I(RHS)
 //-----------------------------------------------------------------------------------------
-template <typename T>
-inline void tensor_matrix<T>::offset_row(const size_t I, const size_t J,
-                                         const size_t NJ, const size_t rel,
-                                         size_t* off) const
+template <typename T, class LP, class RP>
+inline void tensor_matrix_base<T,LP,RP>::offset_row(const size_t I, const size_t J,
+                                                    const size_t NJ, const size_t rel,
+                                                    size_t* off) const
 {
-  const size_t IOFF = M_LHS.offset(I); 
+  const size_t IOFF = M_LHS.offset(I);
   size_t tmp = M_RHS.offset(J+0);
   for (size_t j=1;j<NJ;j++)
   {
     tmp += IOFF;
     off[j-1] = tmp - rel;
     tmp = M_RHS.offset(J+j);
-  } 
+  }
   tmp += IOFF;
   off[NJ-1] = tmp - rel;
 }
 
 //-----------------------------------------------------------------------------------------
-// offset_block
-// calculates a block of offsets starting with I (LHS),J(RHS) and going to I+NI-1 and J+NJ-1
-//  
-// this is stored as a column major matrix, with J as the cols
-//           J    J+1  ...   J+NJ-1
-//  I        
-//  I+1
-//  ...
-//  I+NI-1	
-//  
-//  This routine is based on the following trick. The ROW contributions are the same for
-//  each COL. Therefor they only need to be computed once, and copied from one col to 
-//  another. Similarly, each set of rows only needs to be added by a single 
-//  value of J offset. 
-//  
-//-----------------------------------------------------------------------------------------
-/*
-template <typename T>
-void tensor_matrix<T>::offset_block(const size_t I, const size_t J,
-                                    const size_t NI, const size_t NJ,
-                                    size_t* off) const
-{
-  printf("ERROR tensor_matrix::offset_block \n") ;
-  printf("JHT really needs to code this \n");
-  exit(1);
-}
-*/
-
-//-----------------------------------------------------------------------------------------
-// block 
+// block
 //	Note that this block really comes down to altering the index bundles, as they track
 //	the actual block position within the original tensor
 //-----------------------------------------------------------------------------------------
-template <typename T>
-tensor_matrix<T> tensor_matrix<T>::block(const size_t ROW, const size_t COL,
-                                         const size_t NROW, const size_t NCOL)
+template <typename T, class LP, class RP>
+tensor_matrix_base<T,LP,RP> tensor_matrix_base<T,LP,RP>::block(const size_t ROW,
+                                                               const size_t COL,
+                                                               const size_t NROW,
+                                                               const size_t NCOL)
 {
-  tensor_matrix<T> TENS;
-  TENS.M_TENSOR = M_TENSOR; //same source tensor
+  tensor_matrix_base<T,LP,RP> TENS;
+  TENS.M_BASE = M_BASE; //same source tensor
+  TENS.M_NDIM = M_NDIM;
   TENS.M_LHS = M_LHS.block(ROW,NROW); //LHS bundles change
   TENS.M_RHS = M_RHS.block(COL,NCOL); //RHS bundles change
-  TENS.M_DUMMY.resize(M_LHS.NDIM + M_RHS.NDIM);
-  TENS.M_BUFFER = &(*this)(ROW,COL); 
-  return TENS; 
+  TENS.M_BUFFER = &(*this)(ROW,COL);
+  return TENS;
 }
 
-template <typename T>
-const tensor_matrix<T> tensor_matrix<T>::block(const size_t ROW, const size_t COL,
-                                               const size_t NROW, const size_t NCOL) const
+template <typename T, class LP, class RP>
+const tensor_matrix_base<T,LP,RP> tensor_matrix_base<T,LP,RP>::block(const size_t ROW,
+                                                                     const size_t COL,
+                                                                     const size_t NROW,
+                                                                     const size_t NCOL) const
 {
-  tensor_matrix<T> TENS;
-  TENS.M_TENSOR = M_TENSOR; //same source tensor
+  tensor_matrix_base<T,LP,RP> TENS;
+  TENS.M_BASE = M_BASE; //same source tensor
+  TENS.M_NDIM = M_NDIM;
   TENS.M_LHS = M_LHS.block(ROW,NROW); //LHS bundles change
   TENS.M_RHS = M_RHS.block(COL,NCOL); //RHS bundles change
-  TENS.M_DUMMY.resize(M_LHS.NDIM + M_RHS.NDIM);
-  TENS.M_BUFFER = &(*this)(ROW,COL); 
-  return TENS; 
+  TENS.M_BUFFER = const_cast<T*>(&(*this)(ROW,COL));
+  return TENS;
 }
 
-
 }//end of namespace
 
 #endif
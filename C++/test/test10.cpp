@@ -0,0 +1,74 @@
+#include "usymat.hpp"
+#include "rfpmat.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+//checks rfpmat : the packed layout, conversion to and from usymat, and
+//  symv, for odd and even n
+
+int check(const char* name, const long n, const bool ok)
+{
+  printf("%-24s n %2ld %s\n",name,n,ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+double value(const long i, const long j)
+{
+  return (i <= j) ? 10.0*i + j : 10.0*j + i;
+}
+
+int main()
+{
+  int bad = 0;
+
+  //the layout of the header, n = 5
+  {
+    const long n = 5;
+    rfpmat<double> M(n);
+    for (long j=0;j<n;j++) {for (long i=0;i<=j;i++) {M(i,j) = value(i,j);}}
+    const double want[15] = { 2,12,22, 0, 1,
+                              3,13,23,33,11,
+                              4,14,24,34,44};
+    int wrong = 0;
+    for (long k=0;k<15;k++) {if (M[k] != want[k]) {wrong++;}}
+    bad += check("layout",n,M.ld() == n && M.n1() == 2 && M.size() == 15 && wrong == 0);
+  }
+
+  for (long n=1;n<=12;n++)
+  {
+    usymat<double> U(n,n),V(n,n);
+    for (long j=0;j<n;j++) {for (long i=0;i<=j;i++) {U(i,j) = value(i,j);}}
+
+    //usymat to rfpmat and back
+    rfpmat<double> M(n);
+    M.from_usymat(U);
+    int wrong = 0;
+    for (long i=0;i<n;i++)
+    {
+      for (long j=0;j<n;j++) {if (M(i,j) != value(i,j) || M(i,j) != M(j,i)) {wrong++;}}
+    }
+    bad += check("from_usymat",n,M.size() == n*(n+1)/2 && wrong == 0);
+
+    M.to_usymat(V);
+    wrong = 0;
+    for (long j=0;j<n;j++) {for (long i=0;i<=j;i++) {if (V(i,j) != U(i,j)) {wrong++;}}}
+    bad += check("to_usymat",n,wrong == 0);
+
+    //symv against the definition
+    std::vector<double> x(n),y(n),z(n);
+    for (long i=0;i<n;i++) {x[i] = sin(1.0+i); y[i] = cos(1.0+i);}
+    for (long i=0;i<n;i++)
+    {
+      double s = 0.0;
+      for (long j=0;j<n;j++) {s += value(i,j)*x[j];}
+      z[i] = 2.0*s - 0.5*y[i];
+    }
+    M.symv(2.0,x.data(),-0.5,y.data());
+    wrong = 0;
+    for (long i=0;i<n;i++) {if (fabs(y[i]-z[i]) > 1.e-12*(1.0+fabs(z[i]))) {wrong++;}}
+    bad += check("symv",n,wrong == 0);
+  }
+
+  return bad != 0;
+}
@@ -2,7 +2,7 @@
 #include "jblis.hpp"
 #include "zero2.hpp"
 #include "tensor.hpp"
-#include "block_scatter_matrix2.hpp"
+#include "block_scatter_matrix.hpp"
 #include "tensor_matrix.hpp"
 #include <stdio.h>
 
@@ -0,0 +1,126 @@
+#include "tensor.hpp"
+#include "block_sparse_tensor.hpp"
+#include "jblis.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+//checks libj::contract on block sparse tensors against a dense loop
+
+//next dense index of a tensor, false when done
+bool next_index(std::vector<size_t>& idx, const std::vector<size_t>& len)
+{
+  for (size_t dim=0;dim<idx.size();dim++)
+  {
+    if (++idx[dim] < len[dim]) {return true;}
+    idx[dim] = 0;
+  }
+  return false;
+}
+
+std::vector<size_t> dense_lengths(const libj::block_sparse_tensor<double>& A)
+{
+  std::vector<size_t> len(A.dim());
+  for (size_t dim=0;dim<A.dim();dim++) {len[dim] = A.dense_size(dim);}
+  return len;
+}
+
+void fill(libj::block_sparse_tensor<double>& A, const int seed)
+{
+  for (size_t i=0;i<A.size();i++) {A.data()[i] = sin(0.37*i + seed);}
+}
+
+//irrep lengths of each index, by letter
+std::vector<size_t> irreps_of(const char c)
+{
+  switch (c)
+  {
+    case 'a': return {5,4};
+    case 'b': return {3,6};
+    case 'c': return {7,2};
+    case 'd': return {4,4};
+    case 'i': return {9,7};
+    default : return {6,5};
+  }
+}
+
+int check(const std::string& idxA, const size_t symA, const std::string& idxB,
+          const size_t symB, const std::string& idxC)
+{
+  std::vector<std::vector<size_t>> irA,irB,irC;
+  for (char c : idxA) {irA.push_back(irreps_of(c));}
+  for (char c : idxB) {irB.push_back(irreps_of(c));}
+  for (char c : idxC) {irC.push_back(irreps_of(c));}
+  libj::block_sparse_tensor<double> A(irA,symA),B(irB,symB),C(irC,symA^symB);
+  fill(A,1);
+  fill(B,2);
+  fill(C,3);
+
+  //beta*C, saved densely
+  const double alpha = 0.7, beta = -1.3;
+  const std::vector<size_t> lenA = dense_lengths(A), lenB = dense_lengths(B),
+                            lenC = dense_lengths(C);
+  std::vector<double> ref(C.dense_size());
+  std::vector<size_t> ic(C.dim(),0);
+  size_t n = 0;
+  do {ref[n++] = beta*C.get(ic);} while (next_index(ic,lenC));
+
+  libj::contract(alpha,A,idxA,B,idxB,beta,C,idxC);
+
+  //the dense sum, over every index of A and B that agree
+  std::vector<size_t> ia(A.dim(),0),ib(B.dim(),0);
+  std::vector<size_t> ic2(C.dim());
+  do
+  {
+    const double a = A.get(ia);
+    if (a == 0) {continue;}
+    //B indices shared with A are fixed, loop over the rest
+    std::fill(ib.begin(),ib.end(),0);
+    do
+    {
+      bool match = true;
+      for (size_t d=0;match && d<B.dim();d++)
+      {
+        const size_t pos = idxA.find(idxB[d]);
+        if (pos != std::string::npos) {match = ia[pos] == ib[d];}
+      }
+      if (!match) {continue;}
+      for (size_t d=0;d<C.dim();d++)
+      {
+        const size_t pos = idxA.find(idxC[d]);
+        ic2[d] = (pos != std::string::npos) ? ia[pos] : ib[idxB.find(idxC[d])];
+      }
+      size_t off = 0, str = 1;
+      for (size_t d=0;d<C.dim();d++) {off += ic2[d]*str; str *= lenC[d];}
+      ref[off] += alpha*a*B.get(ib);
+    } while (next_index(ib,lenB));
+  } while (next_index(ia,lenA));
+
+  int bad = 0;
+  std::fill(ic.begin(),ic.end(),0);
+  n = 0;
+  do
+  {
+    const double c = C.get(ic);
+    if (fabs(c - ref[n]) > 1.e-10*(1+fabs(ref[n]))) {bad++;}
+    n++;
+  } while (next_index(ic,lenC));
+  printf("%s,%s -> %s : %d bad elements\n",idxA.c_str(),idxB.c_str(),idxC.c_str(),bad);
+  return bad;
+}
+
+int main()
+{
+  //small caches, so the KC and MC blocks of the tile contractions are
+  //  smaller than the tiles
+  setenv("LIBJ_L1_BYTES","4096",1);
+  setenv("LIBJ_L2_BYTES","32768",1);
+
+  int bad = 0;
+  bad += check("abij",0,"ijcd",0,"abcd");
+  bad += check("iajb",1,"cjdi",0,"bdac");
+  bad += check("aib",1,"ci",1,"bca");
+  return bad != 0;
+}
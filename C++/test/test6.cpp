@@ -0,0 +1,123 @@
+#include "tensor.hpp"
+#include "jblis.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+//checks libj::eval and libj::eval_add against explicit loops, for
+//  sequential tensors (the flat path) and strided views (the blocked path)
+
+const size_t N0 = 37, N1 = 23, N2 = 5;
+
+void fill(std::vector<double>& buf, const int seed)
+{
+  for (size_t i=0;i<buf.size();i++) {buf[i] = sin(0.29*i + seed);}
+}
+
+//A(i,j,k) of every tensor against the reference
+int compare(const char* name, const libj::tensor<double>& C,
+            const std::vector<double>& ref)
+{
+  int bad = 0;
+  size_t n = 0;
+  for (size_t k=0;k<N2;k++)
+  {
+    for (size_t j=0;j<N1;j++)
+    {
+      for (size_t i=0;i<N0;i++)
+      {
+        if (fabs(C(i,j,k) - ref[n]) > 1.e-12*(1+fabs(ref[n]))) {bad++;}
+        n++;
+      }
+    }
+  }
+  printf("%s : %d bad elements\n",name,bad);
+  return bad;
+}
+
+//runs the expressions on A, B, D and C, which may be any layout
+int check(const char* name, libj::tensor<double>& A, libj::tensor<double>& B,
+          libj::tensor<double>& D, libj::tensor<double>& C)
+{
+  const size_t NN = N0*N1*N2;
+  std::vector<double> ref(NN);
+  int bad = 0;
+  char label[64];
+
+  //C = 2A + B.D
+  libj::eval(2.0*A + B*D, C);
+  size_t n = 0;
+  for (size_t k=0;k<N2;k++)
+    for (size_t j=0;j<N1;j++)
+      for (size_t i=0;i<N0;i++)
+        {ref[n++] = 2.0*A(i,j,k) + B(i,j,k)*D(i,j,k);}
+  snprintf(label,sizeof(label),"%s, C = 2A + B*D",name);
+  bad += compare(label,C,ref);
+
+  //C += 0.5A - D*3
+  libj::eval_add(0.5*A - D*3.0, C);
+  n = 0;
+  for (size_t k=0;k<N2;k++)
+    for (size_t j=0;j<N1;j++)
+      for (size_t i=0;i<N0;i++)
+        {ref[n] += 0.5*A(i,j,k) - D(i,j,k)*3.0; n++;}
+  snprintf(label,sizeof(label),"%s, C += 0.5A - 3D",name);
+  bad += compare(label,C,ref);
+
+  //C += -1.5B + A
+  libj::eval_add(libj::axpy(-1.5,B,A), C);
+  n = 0;
+  for (size_t k=0;k<N2;k++)
+    for (size_t j=0;j<N1;j++)
+      for (size_t i=0;i<N0;i++)
+        {ref[n] += -1.5*B(i,j,k) + A(i,j,k); n++;}
+  snprintf(label,sizeof(label),"%s, C += axpy(-1.5,B,A)",name);
+  bad += compare(label,C,ref);
+
+  return bad;
+}
+
+int main()
+{
+  int bad = 0;
+
+  //sequential, the flat path
+  {
+    libj::tensor<double> A(N0,N1,N2),B(N0,N1,N2),D(N0,N1,N2),C(N0,N1,N2);
+    std::vector<double> buf(A.size());
+    fill(buf,1); for (size_t i=0;i<A.size();i++) {A[i] = buf[i];}
+    fill(buf,2); for (size_t i=0;i<B.size();i++) {B[i] = buf[i];}
+    fill(buf,3); for (size_t i=0;i<D.size();i++) {D[i] = buf[i];}
+    bad += check("sequential",A,B,D,C);
+  }
+
+  //views of larger buffers, the blocked path. A is a sub-block, so
+  //  row blocks that cross a column are scattered, B is transposed, D is
+  //  every other element and C is a sub-block
+  {
+    const size_t L0 = N0+3, L1 = N1+2;
+    std::vector<double> abuf(L0*L1*N2),bbuf(N0*N1*N2),dbuf(2*N0*N1*N2),
+                        cbuf(L0*L1*N2);
+    fill(abuf,1);
+    fill(bbuf,2);
+    fill(dbuf,3);
+    libj::tensor<double> A,B,D,C;
+    A.assign(abuf.data()+1,{N0,N1,N2},{1,L0,L0*L1});
+    B.assign(bbuf.data(),{N0,N1,N2},{N1,1,N0*N1});
+    D.assign(dbuf.data(),{N0,N1,N2},{2,2*N0,2*N0*N1});
+    C.assign(cbuf.data()+L0+2,{N0,N1,N2},{1,L0,L0*L1});
+    if (A.is_sequential() || C.is_sequential())
+    {
+      printf("views should not be sequential\n");
+      return 1;
+    }
+    bad += check("strided",A,B,D,C);
+
+    //only C strided, the operands sequential
+    libj::tensor<double> E(N0,N1,N2),F(N0,N1,N2),G(N0,N1,N2);
+    for (size_t i=0;i<E.size();i++) {E[i] = sin(0.11*i); F[i] = cos(0.07*i); G[i] = sin(0.05*i+1);}
+    bad += check("strided result",E,F,G,C);
+  }
+
+  return bad != 0;
+}
@@ -0,0 +1,118 @@
+#include "tensor.hpp"
+#include "mem_io.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+//checks tensor save, load, and view round trips, for sequential tensors
+//  and strided views
+
+const char* FNAME = "test7.bin";
+
+//a sub-block view of a larger buffer, every other element of dimension 0
+void sub_view(libj::tensor<double>& V, std::vector<double>& buf)
+{
+  //buf is 10 x 7 x 3, the view is 4 x 3 x 2 at (1,2,1), stride 2 in i
+  buf.assign(10*7*3,-1.0);
+  V.assign(buf.data()+1+2*10+1*70,{4,3,2},{2,10,70});
+}
+
+int check_gaps(const char* name, const std::vector<double>& buf)
+{
+  //everything outside the view must still be -1
+  int bad = 0;
+  for (size_t k=0;k<3;k++)
+  {
+    for (size_t j=0;j<7;j++)
+    {
+      for (size_t i=0;i<10;i++)
+      {
+        const bool in = (i >= 1 && i < 9 && (i-1)%2 == 0) && (j >= 2 && j < 5) &&
+                        (k >= 1 && k < 3);
+        if (!in && buf[i+10*j+70*k] != -1.0) {bad++;}
+      }
+    }
+  }
+  printf("%s : %d elements changed outside the view\n",name,bad);
+  return bad;
+}
+
+int compare(const char* name, const libj::tensor<double>& A,
+            const libj::tensor<double>& B)
+{
+  int bad = 0;
+  for (size_t k=0;k<A.size(2);k++)
+  {
+    for (size_t j=0;j<A.size(1);j++)
+    {
+      for (size_t i=0;i<A.size(0);i++)
+      {
+        if (A(i,j,k) != B(i,j,k)) {bad++;}
+      }
+    }
+  }
+  printf("%s : %d bad elements\n",name,bad);
+  return bad;
+}
+
+int main()
+{
+  int bad = 0;
+
+  //strided source, saved and loaded into a sequential tensor
+  std::vector<double> src_buf;
+  libj::tensor<double> S;
+  sub_view(S,src_buf);
+  for (size_t k=0;k<2;k++)
+    for (size_t j=0;j<3;j++)
+      for (size_t i=0;i<4;i++) {S(i,j,k) = 100*k + 10*j + i;}
+
+  FILE* fptr = fopen(FNAME,"wb");
+  int err = S.save(fptr);
+  fclose(fptr);
+  if (err != 0) {printf("save : %s\n",libj::mem_io_error(err)); bad++;}
+
+  libj::tensor<double> L;
+  fptr = fopen(FNAME,"rb");
+  err = L.load(fptr);
+  fclose(fptr);
+  if (err != 0) {printf("load : %s\n",libj::mem_io_error(err)); bad++;}
+  if (!L.is_sequential()) {printf("loaded tensor is not sequential\n"); bad++;}
+  bad += compare("strided save, sequential load",S,L);
+
+  //the record loaded into another strided view
+  std::vector<double> dst_buf;
+  libj::tensor<double> D;
+  sub_view(D,dst_buf);
+  fptr = fopen(FNAME,"rb");
+  err = D.load(fptr);
+  fclose(fptr);
+  if (err != 0) {printf("load : %s\n",libj::mem_io_error(err)); bad++;}
+  bad += compare("strided load",S,D);
+  bad += check_gaps("strided load",dst_buf);
+
+  //a view of the record in memory
+  fptr = fopen(FNAME,"rb");
+  std::vector<char> rec(libj::mem_io_record_bytes(libj::mem_io_head()) + 4096);
+  const size_t nread = fread(rec.data(),1,rec.size(),fptr);
+  fclose(fptr);
+  libj::tensor<double> W;
+  err = W.view(rec.data(),nread);
+  if (err != 0) {printf("view : %s\n",libj::mem_io_error(err)); bad++;}
+  else {bad += compare("view",S,W);}
+
+  //sequential round trip
+  libj::tensor<double> A(5,4,3),B;
+  for (size_t n=0;n<A.size();n++) {A[n] = sin(0.3*n);}
+  fptr = fopen(FNAME,"wb");
+  err = A.save(fptr);
+  fclose(fptr);
+  fptr = fopen(FNAME,"rb");
+  err |= B.load(fptr);
+  fclose(fptr);
+  if (err != 0) {printf("sequential round trip failed\n"); bad++;}
+  bad += compare("sequential",A,B);
+
+  remove(FNAME);
+  return bad != 0;
+}
@@ -0,0 +1,111 @@
+#include "jblis.hpp"
+#include "block_sparse_tensor.hpp"
+#include "tune.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+//checks that a tuning profile is read into tune_get, and that contract and
+//  eval stay correct under the parameters it sets, including ones the
+//  kernels have to cut down
+
+const char* FNAME = "test8.tune";
+
+//a contraction of dense n x n matrices with the current parameters
+void product(const size_t n, std::vector<double>& out)
+{
+  const std::vector<std::vector<size_t>> irreps = {{n},{n}};
+  libj::block_sparse_tensor<double> A(irreps,0),B(irreps,0),C(irreps,0);
+  for (size_t i=0;i<A.size();i++) {A.data()[i] = sin(0.1*i); B.data()[i] = cos(0.2*i);}
+  libj::contract(1.0,A,"ik",B,"kj",0.0,C,"ij");
+  out.assign(C.data(),C.data()+C.size());
+}
+
+int compare(const char* name, const std::vector<double>& A, const std::vector<double>& B)
+{
+  int bad = 0;
+  for (size_t i=0;i<A.size();i++) {if (fabs(A[i]-B[i]) > 1.e-10*(1.0+fabs(A[i]))) {bad++;}}
+  printf("%s : %d bad elements\n",name,bad);
+  return bad;
+}
+
+//2A+B on every other element of n element tensors, with the current parameters
+int strided_expr(const char* name, const size_t n)
+{
+  libj::tensor<double> A(2*n),B(2*n),C(2*n);
+  for (size_t i=0;i<2*n;i++) {A[i] = (double) i; B[i] = (double) (i%3); C[i] = -1.0;}
+  libj::tensor<double> AS,BS,CS;
+  AS.assign(A.data(),{n},{2});
+  BS.assign(B.data(),{n},{2});
+  CS.assign(C.data(),{n},{2});
+  libj::eval(2.0*AS+BS,CS);
+  int bad = 0;
+  for (size_t i=0;i<2*n;i++)
+  {
+    const double want = (i%2 == 0) ? 2.0*A[i]+B[i] : -1.0;
+    if (C[i] != want) {bad++;}
+  }
+  printf("%s : %d bad elements\n",name,bad);
+  return bad;
+}
+
+int main()
+{
+  int bad = 0;
+  const size_t n = 75;
+
+  //the reference, with the default parameters
+  std::vector<double> ref,out;
+  product(n,ref);
+  bad += strided_expr("expr default",1001);
+
+  //a profile, with a bad line that must be skipped
+  FILE* fptr = fopen(FNAME,"w");
+  fprintf(fptr,"# kernel type panel pack block\n");
+  fprintf(fptr,"expr double 4096 37 5\n");
+  fprintf(fptr,"contract double 7 13 8\n");
+  fprintf(fptr,"zero float 0 0 16\n");
+  fclose(fptr);
+  const int nread = libj::tune_load(FNAME);
+  remove(FNAME);
+  if (nread != 2) {printf("tune_load read %d lines, not 2\n",nread); bad++;}
+
+  const libj::tune_params& te = libj::tune_get<double>(TUNE_EXPR);
+  const libj::tune_params& tc = libj::tune_get<double>(TUNE_CONTRACT);
+  if (te.panel != 4096 || te.pack != 37 || te.block != 5)
+  {
+    printf("expr is %zu %zu %zu, not 4096 37 5\n",te.panel,te.pack,te.block); bad++;
+  }
+  if (tc.panel != 7 || tc.pack != 13 || tc.block != TUNE_CONTRACT_BLOCK)
+  {
+    printf("contract is %zu %zu %zu, not 7 13 %d\n",tc.panel,tc.pack,tc.block,
+           TUNE_CONTRACT_BLOCK);
+    bad++;
+  }
+
+  //the profile reaches the kernels
+  size_t KC,MC;
+  libj::contract_blocks<double>(n,KC,MC);
+  if (KC != 7 || MC != 8) {printf("contract blocks %zu %zu, not 7 8\n",KC,MC); bad++;}
+  product(n,out);
+  bad += compare("contract from profile",ref,out);
+  bad += strided_expr("expr from profile",1001);
+
+  //parameters larger than the buffers, cut down by the kernels
+  libj::tune_params tp = tc;
+  tp.panel = 1 << 30;
+  tp.pack = 1 << 30;
+  libj::tune_set<double>(TUNE_CONTRACT,tp);
+  libj::contract_blocks<double>(n,KC,MC);
+  if (KC > n || MC % CONTRACT_MR != 0) {printf("oversized blocks %zu %zu\n",KC,MC); bad++;}
+  product(n,out);
+  bad += compare("contract oversized",ref,out);
+
+  tp = te;
+  tp.pack = 1 << 20;
+  tp.block = 1000;
+  libj::tune_set<double>(TUNE_EXPR,tp);
+  bad += strided_expr("expr oversized",1001);
+
+  return bad != 0;
+}
@@ -0,0 +1,100 @@
+#include "core.hpp"
+#include <stdio.h>
+#include <stdint.h>
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+//checks Core scopes, size class free lists, and thread sub-Cores
+
+int check(const char* name, const bool ok)
+{
+  printf("%-40s %s\n",name,ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+int main()
+{
+  int bad = 0;
+  const long n = 1 << 16;
+  Core<double> buf(n);
+
+  //scopes rewind, nested
+  double* start = buf.mark();
+  {
+    Core<double>::Scope outer(buf);
+    buf.checkout(100);
+    double* inner_start = buf.mark();
+    {
+      Core<double>::Scope inner(buf);
+      buf.checkout(1000);
+      bad += check("scope checkout",buf.nfree() == n-1100);
+    }
+    bad += check("inner scope rewinds",buf.mark() == inner_start && buf.nfree() == n-100);
+  }
+  bad += check("outer scope rewinds",buf.mark() == start && buf.nfree() == n);
+
+  //mark and rewind by hand
+  double* m = buf.mark();
+  buf.checkout(10);
+  buf.rewind(m);
+  bad += check("rewind",buf.nfree() == n);
+
+  //size classes round up, and released sections are reused
+  double* a = buf.sized_checkout(100);
+  bad += check("size class rounds up",buf.nfree() == n-128);
+  double* b = buf.sized_checkout(65);
+  buf.release(a,100);
+  double* c = buf.sized_checkout(120);
+  bad += check("released section reused",c == a && buf.nfree() == n-256);
+  buf.release(b,65);
+  buf.release(c,120);
+  double* d = buf.sized_checkout(128);
+  double* e = buf.sized_checkout(70);
+  bad += check("released in any order",(d == a || d == b) && (e == a || e == b) && d != e);
+
+  //rewinding drops released sections past the mark
+  buf.rewind(start);
+  double* f = buf.sized_checkout(128);
+  bad += check("rewind drops released",f == start && buf.nfree() == n-128);
+  buf.rewind(start);
+
+  //thread sub-Cores
+  int nthreads = 1;
+  #if defined (_OPENMP)
+  nthreads = omp_get_max_threads();
+  #endif
+  buf.checkout(3); //off a cache line
+  buf.split(nthreads);
+  bad += check("split",buf.nsplit() == nthreads);
+  int local_bad = 0;
+  for (int t=0;t<nthreads;t++)
+  {
+    Core<double>& sub = buf.local(t);
+    if (((uintptr_t) sub.mark()) % 64 != 0) {local_bad++;}
+    if (sub.nfree() <= 0) {local_bad++;}
+    for (long i=0;i<sub.nfree();i++) {if (sub.mark()[i] != 0.0) {local_bad++; break;}}
+    if (t > 0 && buf.local(t-1).mark() + buf.local(t-1).nfree() > sub.mark()) {local_bad++;}
+  }
+  bad += check("sub-Cores aligned, zeroed, disjoint",local_bad == 0);
+
+  #pragma omp parallel reduction(+:local_bad)
+  {
+    Core<double>& mine = buf.local();
+    const long before = mine.nfree();
+    {
+      Core<double>::Scope scope(mine);
+      double* tmp = mine.checkout(before/2);
+      for (long i=0;i<before/2;i++) {tmp[i] = 1.0;}
+    }
+    if (mine.nfree() != before) {local_bad++;}
+  }
+  bad += check("sub-Core scopes per thread",local_bad == 0);
+
+  buf.unsplit();
+  bad += check("unsplit",buf.nsplit() == 0 && buf.nfree() == n-3);
+  buf.rewind(start);
+  bad += check("rewind after unsplit",buf.nfree() == n);
+
+  return bad != 0;
+}